@@ -14,12 +14,237 @@
 #include <angelscript.h>
 #endif
 
+#define SORT_INSERTION_THRESHOLD 24
+#define DICTIONARY_LINEAR_SIZE 8
+
 namespace
 {
 	struct file_link : public vitex::core::file_entry
 	{
 		vitex::core::string path;
 	};
+
+	struct script_method_less
+	{
+		vitex::scripting::immediate_context* context;
+		asIScriptFunction* comparator;
+		bool handles;
+		bool failed = false;
+
+		bool operator()(void* a, void* b)
+		{
+			if (failed)
+				return false;
+
+			if (handles)
+			{
+				if (!a)
+					return true;
+
+				if (!b)
+					return false;
+			}
+
+			if (!context->prepare(comparator) || !context->set_object(a) || !context->set_arg_object(0, b))
+			{
+				failed = true;
+				return false;
+			}
+
+			auto status = context->execute_next();
+			if (!status || *status != vitex::scripting::execution::finished)
+			{
+				failed = true;
+				return false;
+			}
+
+			return (int)context->get_return_dword() < 0;
+		}
+	};
+
+	struct script_callback_less
+	{
+		vitex::scripting::immediate_context* context;
+		asIScriptFunction* callback;
+		bool by_address;
+		bool failed = false;
+
+		template <typename t>
+		bool operator()(const t& a, const t& b)
+		{
+			if (failed)
+				return false;
+
+			if (!context->prepare(callback) || !context->set_arg_address(0, address_of(a)) || !context->set_arg_address(1, address_of(b)))
+			{
+				failed = true;
+				return false;
+			}
+
+			auto status = context->execute_next();
+			if (!status || *status != vitex::scripting::execution::finished)
+			{
+				failed = true;
+				return false;
+			}
+
+			return context->get_return_byte() > 0;
+		}
+		template <typename t>
+		void* address_of(const t& value)
+		{
+			return (void*)&value;
+		}
+		void* address_of(void* const& value)
+		{
+			return by_address ? (void*)&value : value;
+		}
+	};
+
+	template <typename t, typename comparator>
+	void insertion_sort(t* data, size_t count, comparator& less)
+	{
+		for (size_t i = 1; i < count; i++)
+		{
+			t value = data[i];
+			size_t j = i;
+			while (j > 0 && less(value, data[j - 1]))
+			{
+				data[j] = data[j - 1];
+				--j;
+			}
+			data[j] = value;
+		}
+	}
+	template <typename t, typename comparator>
+	void heap_sift(t* data, size_t root, size_t count, comparator& less)
+	{
+		t value = data[root];
+		while (true)
+		{
+			size_t child = root * 2 + 1;
+			if (child >= count)
+				break;
+
+			if (child + 1 < count && less(data[child], data[child + 1]))
+				++child;
+
+			if (!less(value, data[child]))
+				break;
+
+			data[root] = data[child];
+			root = child;
+		}
+		data[root] = value;
+	}
+	template <typename t, typename comparator>
+	void heap_sort(t* data, size_t count, comparator& less)
+	{
+		for (size_t i = count / 2; i-- > 0;)
+			heap_sift(data, i, count, less);
+
+		for (size_t i = count; i-- > 1;)
+		{
+			std::swap(data[0], data[i]);
+			heap_sift(data, 0, i, less);
+		}
+	}
+	template <typename t, typename comparator>
+	void intro_sort(t* data, size_t count, size_t depth, comparator& less)
+	{
+		while (count > SORT_INSERTION_THRESHOLD)
+		{
+			if (!depth--)
+			{
+				heap_sort(data, count, less);
+				return;
+			}
+
+			size_t middle = count / 2, last = count - 1;
+			if (less(data[middle], data[0]))
+				std::swap(data[middle], data[0]);
+			if (less(data[last], data[middle]))
+			{
+				std::swap(data[last], data[middle]);
+				if (less(data[middle], data[0]))
+					std::swap(data[middle], data[0]);
+			}
+
+			std::swap(data[0], data[middle]);
+			t pivot = data[0];
+			size_t i = 0, j = count;
+			while (true)
+			{
+				while (++i < count && less(data[i], pivot));
+				while (--j > 0 && less(pivot, data[j]));
+				if (i >= j)
+					break;
+
+				std::swap(data[i], data[j]);
+			}
+			std::swap(data[0], data[j]);
+
+			size_t left = j, right = count - j - 1;
+			if (left < right)
+			{
+				intro_sort(data, left, depth, less);
+				data += j + 1;
+				count = right;
+			}
+			else
+			{
+				intro_sort(data + j + 1, right, depth, less);
+				count = left;
+			}
+		}
+		insertion_sort(data, count, less);
+	}
+	template <typename t, typename comparator>
+	void merge_sort(t* data, size_t count, comparator& less)
+	{
+		for (size_t i = 0; i < count; i += SORT_INSERTION_THRESHOLD)
+			insertion_sort(data + i, std::min<size_t>(SORT_INSERTION_THRESHOLD, count - i), less);
+
+		if (count <= SORT_INSERTION_THRESHOLD)
+			return;
+
+		t* buffer = vitex::core::memory::allocate<t>(sizeof(t) * count);
+		t* from = data, * to = buffer;
+		for (size_t width = SORT_INSERTION_THRESHOLD; width < count; width *= 2)
+		{
+			for (size_t left = 0; left < count; left += width * 2)
+			{
+				size_t middle = std::min<size_t>(left + width, count);
+				size_t right = std::min<size_t>(left + width * 2, count);
+				size_t i = left, j = middle, k = left;
+				while (i < middle && j < right)
+					to[k++] = less(from[j], from[i]) ? from[j++] : from[i++];
+				while (i < middle)
+					to[k++] = from[i++];
+				while (j < right)
+					to[k++] = from[j++];
+			}
+			std::swap(from, to);
+		}
+
+		if (from != data)
+			memcpy(data, from, sizeof(t) * count);
+
+		vitex::core::memory::deallocate(buffer);
+	}
+	template <typename t, typename comparator>
+	void sort_buffer(void* buffer, size_t count, bool stable, comparator&& less)
+	{
+		t* data = (t*)buffer;
+		if (stable)
+			return merge_sort(data, count, less);
+
+		size_t depth = 0;
+		for (size_t i = count; i > 1; i >>= 1)
+			depth += 2;
+
+		intro_sort(data, count, depth, less);
+	}
 }
 
 namespace vitex
@@ -1764,49 +1989,6 @@ namespace vitex
 
 				return is_equal;
 			}
-			bool array::less(const void* a, const void* b, immediate_context* context, scache* cache)
-			{
-				if (sub_type_id & ~(size_t)type_id::mask_seqnbr_t)
-				{
-					if (sub_type_id & (size_t)type_id::handle_t)
-					{
-						if (*(void**)a == 0)
-							return true;
-
-						if (*(void**)b == 0)
-							return false;
-					}
-
-					if (!cache || !cache->comparator)
-						return false;
-
-					bool is_less = false;
-					context->execute_subcall(cache->comparator, [a, b](immediate_context* context)
-					{
-						context->set_object((void*)a);
-						context->set_arg_object(0, (void*)b);
-					}, [&is_less](immediate_context* context) { is_less = (context->get_return_dword() < 0); });
-					return is_less;
-				}
-
-				switch (sub_type_id)
-				{
-#define COMPARE(t) *((t*)a) < *((t*)b)
-					case (size_t)type_id::bool_t: return COMPARE(bool);
-					case (size_t)type_id::int8_t: return COMPARE(signed char);
-					case (size_t)type_id::uint8_t: return COMPARE(unsigned char);
-					case (size_t)type_id::int16_t: return COMPARE(signed short);
-					case (size_t)type_id::uint16_t: return COMPARE(unsigned short);
-					case (size_t)type_id::int32_t: return COMPARE(signed int);
-					case (size_t)type_id::uint32_t: return COMPARE(uint32_t);
-					case (size_t)type_id::float_t: return COMPARE(float);
-					case (size_t)type_id::double_t: return COMPARE(double);
-					default: return COMPARE(signed int);
-#undef COMPARE
-				}
-
-				return false;
-			}
 			bool array::equals(const void* a, const void* b, immediate_context* context, scache* cache) const
 			{
 				if (sub_type_id & ~(size_t)type_id::mask_seqnbr_t)
@@ -1923,50 +2105,81 @@ namespace vitex
 			}
 			void array::sort(asIScriptFunction* callback)
 			{
-				scache* cache; size_t count = size();
-				if (!is_eligible_for_sort(&cache) || count < 2)
+				sort_by(callback, false);
+			}
+			void array::stable_sort(asIScriptFunction* callback)
+			{
+				sort_by(callback, true);
+			}
+			void array::sort_by(asIScriptFunction* callback, bool stable)
+			{
+				size_t count = size();
+				if (count < 2)
+					return;
+
+				bool primitive = !(sub_type_id & ~(size_t)type_id::mask_seqnbr_t);
+				if (!callback && primitive)
+				{
+					switch (sub_type_id)
+					{
+#define SORT(t) return sort_buffer<t>(buffer->data, count, stable, [](const t& a, const t& b) { return a < b; })
+						case (size_t)type_id::bool_t: SORT(bool);
+						case (size_t)type_id::int8_t: SORT(signed char);
+						case (size_t)type_id::uint8_t: SORT(unsigned char);
+						case (size_t)type_id::int16_t: SORT(signed short);
+						case (size_t)type_id::uint16_t: SORT(unsigned short);
+						case (size_t)type_id::int32_t: SORT(signed int);
+						case (size_t)type_id::uint32_t: SORT(uint32_t);
+						case (size_t)type_id::int64_t: SORT(int64_t);
+						case (size_t)type_id::uint64_t: SORT(uint64_t);
+						case (size_t)type_id::float_t: SORT(float);
+						case (size_t)type_id::double_t: SORT(double);
+						default: SORT(signed int);
+#undef SORT
+					}
+				}
+
+				bool handles = (sub_type_id & (size_t)type_id::handle_t);
+				if (!callback && !handles && obj_type.get_sub_type().get_name() == TYPENAME_STRING)
+					return sort_buffer<void*>(buffer->data, count, stable, [](void* a, void* b) { return *(core::string*)a < *(core::string*)b; });
+
+				scache* cache = nullptr;
+				if (!callback && !is_eligible_for_sort(&cache))
 					return;
 
-				unsigned char swap[16];
 				immediate_context* context = immediate_context::get();
+				if (!context || !context->can_execute_subcall())
+					return;
+
+				context->disable_suspends();
+				context->push_state();
 				if (callback != nullptr)
 				{
 					function_delegate delegatef(callback);
-					for (size_t i = 1; i < count; i++)
-					{
-						int64_t j = (int64_t)(i - 1);
-						copy(swap, get_array_item_pointer(i));
-						while (j >= 0)
-						{
-							void* a = get_data_pointer(swap), * b = at(j); bool is_less = false;
-							context->execute_subcall(delegatef.callable(), [a, b](immediate_context* context)
-							{
-								context->set_arg_address(0, a);
-								context->set_arg_address(1, b);
-							}, [&is_less](immediate_context* context) { is_less = (context->get_return_byte() > 0); });
-							if (!is_less)
-								break;
-
-							copy(get_array_item_pointer(j + 1), get_array_item_pointer(j));
-							j--;
-						}
-						copy(get_array_item_pointer(j + 1), swap);
+					script_callback_less less = { context, delegatef.callable().get_function(), handles };
+					switch (primitive ? sub_type_id : -1)
+					{
+#define SORT(t) sort_buffer<t>(buffer->data, count, stable, less); break
+						case (size_t)type_id::bool_t: SORT(bool);
+						case (size_t)type_id::int8_t: SORT(signed char);
+						case (size_t)type_id::uint8_t: SORT(unsigned char);
+						case (size_t)type_id::int16_t: SORT(signed short);
+						case (size_t)type_id::uint16_t: SORT(unsigned short);
+						case (size_t)type_id::int32_t: SORT(signed int);
+						case (size_t)type_id::uint32_t: SORT(uint32_t);
+						case (size_t)type_id::int64_t: SORT(int64_t);
+						case (size_t)type_id::uint64_t: SORT(uint64_t);
+						case (size_t)type_id::float_t: SORT(float);
+						case (size_t)type_id::double_t: SORT(double);
+						case -1: SORT(void*);
+						default: SORT(signed int);
+#undef SORT
 					}
 				}
 				else
-				{
-					for (size_t i = 1; i < count; i++)
-					{
-						int64_t j = (int64_t)(i - 1);
-						copy(swap, get_array_item_pointer(i));
-						while (j >= 0 && less(get_data_pointer(swap), at(j), context, cache))
-						{
-							copy(get_array_item_pointer(j + 1), get_array_item_pointer(j));
-							j--;
-						}
-						copy(get_array_item_pointer(j + 1), swap);
-					}
-				}
+					sort_buffer<void*>(buffer->data, count, stable, script_method_less{ context, cache->comparator, handles });
+				context->pop_state();
+				context->enable_suspends();
 			}
 			void array::copy_buffer(sbuffer* dest, sbuffer* src)
 			{
@@ -2540,16 +2753,16 @@ namespace vitex
 				return value.type_id;
 			}
 
-			dictionary::local_iterator::local_iterator(const dictionary& from, internal_map::const_iterator it) noexcept : it(it), base(from)
+			dictionary::local_iterator::local_iterator(const dictionary& from, size_t new_index) noexcept : index(new_index), base(from)
 			{
 			}
 			void dictionary::local_iterator::operator++()
 			{
-				++it;
+				do ++index; while (index < base.data.size() && !base.data[index]);
 			}
 			void dictionary::local_iterator::operator++(int)
 			{
-				++it;
+				do ++index; while (index < base.data.size() && !base.data[index]);
 			}
 			dictionary::local_iterator& dictionary::local_iterator::operator*()
 			{
@@ -2557,30 +2770,31 @@ namespace vitex
 			}
 			bool dictionary::local_iterator::operator==(const local_iterator& other) const
 			{
-				return it == other.it;
+				return index == other.index;
 			}
 			bool dictionary::local_iterator::operator!=(const local_iterator& other) const
 			{
-				return it != other.it;
+				return index != other.index;
 			}
 			const core::string& dictionary::local_iterator::get_key() const
 			{
-				return it->first;
+				auto* next = base.data[index];
+				return next->name;
 			}
 			int dictionary::local_iterator::get_type_id() const
 			{
-				return it->second.value.type_id;
+				return base.data[index]->value.value.type_id;
 			}
 			bool dictionary::local_iterator::get_value(void* pointer, int type_id) const
 			{
-				return it->second.get(base.engine, pointer, type_id);
+				return base.data[index]->value.get(base.engine, pointer, type_id);
 			}
 			const void* dictionary::local_iterator::get_address_of_value() const
 			{
-				return it->second.get_address_of_value();
+				return base.data[index]->value.get_address_of_value();
 			}
 
-			dictionary::dictionary(virtual_machine* _Engine) noexcept : engine(_Engine)
+			dictionary::dictionary(virtual_machine* _Engine) noexcept : engine(_Engine), removed(0)
 			{
 				dictionary::scache* cache = reinterpret_cast<dictionary::scache*>(engine->get_user_data(dictionary_id));
 				engine->notify_of_new_object(this, cache->dictionary_type);
@@ -2681,15 +2895,19 @@ namespace vitex
 			}
 			dictionary::dictionary(const dictionary& other) noexcept : dictionary(other.engine)
 			{
-				for (auto it = other.data.begin(); it != other.data.end(); ++it)
+				for (size_t i = 0; i < other.data.size(); i++)
 				{
-					auto& key = it->second;
+					if (!other.data[i])
+						continue;
+
+					auto& key = other.data[i]->value;
+					auto& name = local_iterator(other, i).get_key();
 					if (key.value.type_id & (size_t)type_id::handle_t)
-						set(it->first, (void*)&key.value.object, key.value.type_id);
+						set(name, (void*)&key.value.object, key.value.type_id);
 					else if (key.value.type_id & (size_t)type_id::mask_object_t)
-						set(it->first, (void*)key.value.object, key.value.type_id);
+						set(name, (void*)key.value.object, key.value.type_id);
 					else
-						set(it->first, (void*)&key.value.integer, key.value.type_id);
+						set(name, (void*)&key.value.integer, key.value.type_id);
 				}
 			}
 			dictionary::~dictionary() noexcept
@@ -2698,9 +2916,12 @@ namespace vitex
 			}
 			void dictionary::enum_references(asIScriptEngine* _Engine)
 			{
-				for (auto it = data.begin(); it != data.end(); ++it)
+				for (auto* next : data)
 				{
-					auto& key = it->second;
+					if (!next)
+						continue;
+
+					auto& key = next->value;
 					if (key.value.type_id & (size_t)type_id::mask_object_t)
 					{
 						auto sub_type = engine->get_type_info_by_id(key.value.type_id);
@@ -2718,92 +2939,73 @@ namespace vitex
 			dictionary& dictionary::operator =(const dictionary& other) noexcept
 			{
 				clear();
-				for (auto it = other.data.begin(); it != other.data.end(); ++it)
+				for (size_t i = 0; i < other.data.size(); i++)
 				{
-					auto& key = it->second;
+					if (!other.data[i])
+						continue;
+
+					auto& key = other.data[i]->value;
+					auto& name = local_iterator(other, i).get_key();
 					if (key.value.type_id & (size_t)type_id::handle_t)
-						set(it->first, (void*)&key.value.object, key.value.type_id);
+						set(name, (void*)&key.value.object, key.value.type_id);
 					else if (key.value.type_id & (size_t)type_id::mask_object_t)
-						set(it->first, (void*)key.value.object, key.value.type_id);
+						set(name, (void*)key.value.object, key.value.type_id);
 					else
-						set(it->first, (void*)&key.value.integer, key.value.type_id);
+						set(name, (void*)&key.value.integer, key.value.type_id);
 				}
 
 				return *this;
 			}
 			storable* dictionary::operator[](const std::string_view& key)
 			{
-				auto it = data.find(core::key_lookup_cast(key));
-				if (it != data.end())
-					return &it->second;
-
-				return &data[core::string(key)];
+				return &emplace(key)->value;
 			}
 			const storable* dictionary::operator[](const std::string_view& key) const
 			{
-				auto it = data.find(core::key_lookup_cast(key));
-				if (it != data.end())
-					return &it->second;
+				size_t index = find_index(key);
+				if (index < data.size())
+					return &data[index]->value;
 
 				bindings::exception::throw_ptr(bindings::exception::pointer(EXCEPTION_ACCESSINVALID));
 				return 0;
 			}
 			storable* dictionary::operator[](size_t index)
 			{
+				compact();
 				if (index < data.size())
-				{
-					auto it = data.begin();
-					while (index--)
-						it++;
-					return &it->second;
-				}
+					return &data[index]->value;
 
 				bindings::exception::throw_ptr(bindings::exception::pointer(EXCEPTION_ACCESSINVALID));
 				return 0;
 			}
 			const storable* dictionary::operator[](size_t index) const
 			{
+				compact();
 				if (index < data.size())
-				{
-					auto it = data.begin();
-					while (index--)
-						it++;
-					return &it->second;
-				}
+					return &data[index]->value;
 
 				bindings::exception::throw_ptr(bindings::exception::pointer(EXCEPTION_ACCESSINVALID));
 				return 0;
 			}
 			void dictionary::set(const std::string_view& key, void* value, int type_id)
 			{
-				auto it = data.find(core::key_lookup_cast(key));
-				if (it == data.end())
-					it = data.insert(internal_map::value_type(key, storable())).first;
-
-				it->second.set(engine, value, type_id);
+				emplace(key)->value.set(engine, value, type_id);
 			}
 			bool dictionary::get(const std::string_view& key, void* value, int type_id) const
 			{
-				auto it = data.find(core::key_lookup_cast(key));
-				if (it != data.end())
-					return it->second.get(engine, value, type_id);
+				size_t index = find_index(key);
+				if (index < data.size())
+					return data[index]->value.get(engine, value, type_id);
 
 				return false;
 			}
 			bool dictionary::get_index(size_t index, core::string* key, void** value, int* type_id) const
 			{
+				compact();
 				if (index >= data.size())
 					return false;
 
-				auto it = begin();
-				size_t offset = 0;
-
-				while (offset != index)
-				{
-					++offset;
-					++it;
-				}
-
+				local_iterator it(*this, index);
 				if (key != nullptr)
 					*key = it.get_key();
 
@@ -2817,88 +3019,187 @@ namespace vitex
 			}
 			bool dictionary::try_get_index(size_t index, core::string* key, void* value, int type_id) const
 			{
+				compact();
 				if (index >= data.size())
 					return false;
 
-				auto it = begin();
-				size_t offset = 0;
-
-				while (offset != index)
-				{
-					++offset;
-					++it;
-				}
+				local_iterator it(*this, index);
+				if (key != nullptr)
+					*key = it.get_key();
 
 				return it.get_value(value, type_id);
 			}
 			int dictionary::get_type_id(const std::string_view& key) const
 			{
-				auto it = data.find(core::key_lookup_cast(key));
-				if (it != data.end())
-					return it->second.value.type_id;
+				size_t index = find_index(key);
+				if (index < data.size())
+					return data[index]->value.value.type_id;
 
 				return -1;
 			}
 			bool dictionary::exists(const std::string_view& key) const
 			{
-				auto it = data.find(core::key_lookup_cast(key));
-				if (it != data.end())
-					return true;
-
-				return false;
+				return find_index(key) < data.size();
 			}
 			bool dictionary::empty() const
 			{
-				if (data.size() == 0)
-					return true;
-
-				return false;
+				return data.size() == removed;
 			}
 			size_t dictionary::size() const
 			{
-				return size_t(data.size());
+				return data.size() - removed;
 			}
 			bool dictionary::erase(const std::string_view& key)
 			{
-				auto it = data.find(core::key_lookup_cast(key));
-				if (it != data.end())
-				{
-					it->second.release_references(engine->get_engine());
-					data.erase(it);
-					return true;
-				}
+				size_t index = find_index(key);
+				if (index >= data.size())
+					return false;
 
-				return false;
+				erase_index(index);
+				return true;
 			}
 			void dictionary::clear()
 			{
 				asIScriptEngine* target = engine->get_engine();
-				for (auto it = data.begin(); it != data.end(); ++it)
-					it->second.release_references(target);
+				for (auto* next : data)
+				{
+					if (!next)
+						continue;
+
+					next->value.release_references(target);
+					core::memory::deinit(next);
+				}
 				data.clear();
+				slots.clear();
+				removed = 0;
 			}
 			array* dictionary::get_keys() const
 			{
 				dictionary::scache* cache = reinterpret_cast<dictionary::scache*>(engine->get_user_data(dictionary_id));
-				array* array = array::create(cache->array_type.get_type_info(), size_t(data.size()));
-				size_t current = 0;
-
-				for (auto it = data.begin(); it != data.end(); ++it)
-					*(core::string*)array->at(current++) = it->first;
+				array* array = array::create(cache->array_type.get_type_info(), size());
+				size_t offset = 0;
+				for (auto it = begin(); it != end(); it++)
+					*(core::string*)array->at(offset++) = it.get_key();
 
 				return array;
 			}
 			dictionary::local_iterator dictionary::begin() const
 			{
-				return local_iterator(*this, data.begin());
+				size_t index = 0;
+				while (index < data.size() && !data[index])
+					++index;
+				return local_iterator(*this, index);
 			}
 			dictionary::local_iterator dictionary::end() const
 			{
-				return local_iterator(*this, data.end());
+				return local_iterator(*this, data.size());
 			}
 			dictionary::local_iterator dictionary::find(const std::string_view& key) const
 			{
-				return local_iterator(*this, data.find(core::key_lookup_cast(key)));
+				return local_iterator(*this, find_index(key));
+			}
+			size_t dictionary::find_index(const std::string_view& key) const
+			{
+				if (slots.empty())
+				{
+					for (size_t i = 0; i < data.size(); i++)
+					{
+						auto* next = data[i];
+						if (next->name == key)
+							return i;
+					}
+					return data.size();
+				}
+
+				size_t hash = core::key_hasher<core::string>()(key);
+				size_t mask = slots.size() - 1;
+				for (size_t slot = hash & mask; slots[slot] != 0; slot = (slot + 1) & mask)
+				{
+					if (slots[slot] == std::numeric_limits<uint32_t>::max())
+						continue;
+
+					auto* next = data[slots[slot] - 1];
+					if (next->hash == hash && next->name == key)
+						return slots[slot] - 1;
+				}
+				return data.size();
+			}
+			dictionary::item* dictionary::emplace(const std::string_view& key)
+			{
+				size_t index = find_index(key);
+				if (index < data.size())
+					return data[index];
+
+				item* next = core::memory::init<item>();
+				next->name = key;
+				next->hash = core::key_hasher<core::string>()(key);
+				data.push_back(next);
+				if (data.size() <= DICTIONARY_LINEAR_SIZE)
+					return next;
+
+				if (data.size() * 2 > slots.size())
+					rebuild_slots(data.size() * 4);
+				else
+					insert_slot(data.size() - 1);
+				return next;
+			}
+			void dictionary::erase_index(size_t index)
+			{
+				item* next = data[index];
+				next->value.release_references(engine->get_engine());
+				if (slots.empty())
+				{
+					core::memory::deinit(next);
+					data.erase(data.begin() + index);
+					return;
+				}
+
+				size_t mask = slots.size() - 1;
+				size_t slot = next->hash & mask;
+				while (slots[slot] != (uint32_t)(index + 1))
+					slot = (slot + 1) & mask;
+
+				core::memory::deinit(next);
+				slots[slot] = std::numeric_limits<uint32_t>::max();
+				data[index] = nullptr;
+				if (++removed * 2 > data.size())
+					compact();
+			}
+			void dictionary::insert_slot(size_t index)
+			{
+				size_t mask = slots.size() - 1;
+				size_t slot = data[index]->hash & mask;
+				while (slots[slot] != 0 && slots[slot] != std::numeric_limits<uint32_t>::max())
+					slot = (slot + 1) & mask;
+				slots[slot] = (uint32_t)(index + 1);
+			}
+			void dictionary::rebuild_slots(size_t capacity) const
+			{
+				size_t size = DICTIONARY_LINEAR_SIZE * 2;
+				while (size < capacity)
+					size <<= 1;
+
+				size_t mask = size - 1;
+				slots.assign(size, 0);
+				for (size_t i = 0; i < data.size(); i++)
+				{
+					size_t slot = data[i]->hash & mask;
+					while (slots[slot] != 0)
+						slot = (slot + 1) & mask;
+					slots[slot] = (uint32_t)(i + 1);
+				}
+			}
+			void dictionary::compact() const
+			{
+				if (!removed)
+					return;
+
+				data.erase(std::remove(data.begin(), data.end(), nullptr), data.end());
+				removed = 0;
+				if (data.size() > DICTIONARY_LINEAR_SIZE)
+					rebuild_slots(data.size() * 4);
+				else
+					slots.clear();
 			}
 			dictionary* dictionary::create(virtual_machine* engine)
 			{
@@ -8848,6 +9149,7 @@ namespace vitex
 					varray->set_method("void reverse()", &array::reverse);
 					varray->set_method("void swap(usize, usize)", &array::swap);
 					varray->set_method("void sort(less_sync@ = null)", &array::sort);
+					varray->set_method("void stable_sort(less_sync@ = null)", &array::stable_sort);
 					varray->set_method<array, size_t, void*, size_t>("usize find(const t&in if_handle_then_const, usize = 0) const", &array::find);
 					varray->set_method<array, size_t, void*, size_t>("usize find_ref(const t&in if_handle_then_const, usize = 0) const", &array::find_by_ref);
 				}
@@ -11309,6 +11611,10 @@ namespace vitex
 				vweb_socket_op->set_value("ping", (int)network::http::web_socket_op::ping);
 				vweb_socket_op->set_value("pong", (int)network::http::web_socket_op::pong);
 
+				auto vbroadcast_policy = vm->set_enum("broadcast_policy");
+				vbroadcast_policy->set_value("drop", (int)network::http::broadcast_policy::drop);
+				vbroadcast_policy->set_value("close", (int)network::http::broadcast_policy::close);
+
 				auto vweb_socket_state = vm->set_enum("websocket_state");
 				vweb_socket_state->set_value("open", (int)network::http::web_socket_state::open);
 				vweb_socket_state->set_value("receive", (int)network::http::web_socket_state::receive);
@@ -11472,10 +11778,21 @@ namespace vitex
 				vroute_compression->set_method_extern("void set_files(array<regex_source>@+)", &route_compression_set_files);
 				vroute_compression->set_method_extern("array<regex_source>@ get_files() const", &route_compression_get_files);
 
+				auto vroute_web_socket_compression = vm->set_struct_trivial<network::http::router_entry::entry_web_socket_compression>("route_websocket_compression");
+				vroute_web_socket_compression->set_property<network::http::router_entry::entry_web_socket_compression>("usize max_inflated_length", &network::http::router_entry::entry_web_socket_compression::max_inflated_length);
+				vroute_web_socket_compression->set_property<network::http::router_entry::entry_web_socket_compression>("usize min_length", &network::http::router_entry::entry_web_socket_compression::min_length);
+				vroute_web_socket_compression->set_property<network::http::router_entry::entry_web_socket_compression>("int32 quality_level", &network::http::router_entry::entry_web_socket_compression::quality_level);
+				vroute_web_socket_compression->set_property<network::http::router_entry::entry_web_socket_compression>("int32 memory_level", &network::http::router_entry::entry_web_socket_compression::memory_level);
+				vroute_web_socket_compression->set_property<network::http::router_entry::entry_web_socket_compression>("bool server_no_context_takeover", &network::http::router_entry::entry_web_socket_compression::server_no_context_takeover);
+				vroute_web_socket_compression->set_property<network::http::router_entry::entry_web_socket_compression>("bool client_no_context_takeover", &network::http::router_entry::entry_web_socket_compression::client_no_context_takeover);
+				vroute_web_socket_compression->set_property<network::http::router_entry::entry_web_socket_compression>("bool enabled", &network::http::router_entry::entry_web_socket_compression::enabled);
+				vroute_web_socket_compression->set_constructor<network::http::router_entry::entry_web_socket_compression>("void f()");
+
 				auto vmap_router = vm->set_class<network::http::map_router>("map_router", true);
 				auto vrouter_entry = vm->set_class<network::http::router_entry>("route_entry", false);
 				vrouter_entry->set_property<network::http::router_entry>("route_auth auths", &network::http::router_entry::auth);
 				vrouter_entry->set_property<network::http::router_entry>("route_compression compressions", &network::http::router_entry::compression);
+				vrouter_entry->set_property<network::http::router_entry>("route_websocket_compression websocket_compression", &network::http::router_entry::web_socket_compression);
 				vrouter_entry->set_property<network::http::router_entry>("string files_directory", &network::http::router_entry::files_directory);
 				vrouter_entry->set_property<network::http::router_entry>("string char_set", &network::http::router_entry::char_set);
 				vrouter_entry->set_property<network::http::router_entry>("string proxy_ip_address", &network::http::router_entry::proxy_ip_address);
@@ -11525,6 +11842,9 @@ namespace vitex
 				vrouter_session->set_property<network::http::map_router::router_session>("router_cookie cookie", &network::http::map_router::router_session::cookie);
 				vrouter_session->set_property<network::http::map_router::router_session>("string directory", &network::http::map_router::router_session::directory);
 				vrouter_session->set_property<network::http::map_router::router_session>("uint64 expires", &network::http::map_router::router_session::expires);
+				vrouter_session->set_property<network::http::map_router::router_session>("uint64 sweep_interval", &network::http::map_router::router_session::sweep_interval);
+				vrouter_session->set_property<network::http::map_router::router_session>("uint64 flush_interval", &network::http::map_router::router_session::flush_interval);
+				vrouter_session->set_property<network::http::map_router::router_session>("usize max_entries", &network::http::map_router::router_session::max_entries);
 				vrouter_session->set_constructor<network::http::map_router::router_session>("void f()");
 
 				auto vconnection = vm->set_class<network::http::connection>("connection", false);
@@ -11540,6 +11860,7 @@ namespace vitex
 				vweb_socket_frame->set_method_extern("promise<bool>@ send_close()", &VI_SPROMISIFY(web_socket_frame_send_close, type_id::bool_t));
 				vweb_socket_frame->set_method("void next()", &network::http::web_socket_frame::next);
 				vweb_socket_frame->set_method("bool is_finished() const", &network::http::web_socket_frame::is_finished);
+				vweb_socket_frame->set_method("usize get_backlog() const", &network::http::web_socket_frame::get_backlog);
 				vweb_socket_frame->set_method("socket@+ get_stream() const", &network::http::web_socket_frame::get_stream);
 				vweb_socket_frame->set_method("connection@+ get_connection() const", &network::http::web_socket_frame::get_connection);
 
@@ -11554,6 +11875,7 @@ namespace vitex
 				vmap_router->set_property<network::http::map_router>("router_session session", &network::http::map_router::session);
 				vmap_router->set_property<network::http::map_router>("string temporary_directory", &network::http::map_router::temporary_directory);
 				vmap_router->set_property<network::http::map_router>("usize max_uploadable_resources", &network::http::map_router::max_uploadable_resources);
+				vmap_router->set_property<network::http::map_router>("usize max_in_memory_resource_size", &network::http::map_router::max_in_memory_resource_size);
 				vmap_router->set_gc_constructor<network::http::map_router, map_router>("map_router@ f()");
 				vmap_router->set_method_extern("void listen(const string_view&in, const string_view&in, bool = false)", &socket_router_listen1);
 				vmap_router->set_method_extern("void listen(const string_view&in, const string_view&in, const string_view&in, bool = false)", &socket_router_listen2);
@@ -11658,6 +11980,11 @@ namespace vitex
 
 				vserver->set_gc_constructor<network::http::server, server>("server@ f()");
 				vserver->set_method("void update()", &network::http::server::update);
+				vserver->set_method("bool subscribe(const string_view&in, websocket_frame@+)", &network::http::server::subscribe);
+				vserver->set_method<network::http::server, bool, const std::string_view&, network::http::web_socket_frame*>("bool unsubscribe(const string_view&in, websocket_frame@+)", &network::http::server::unsubscribe);
+				vserver->set_method<network::http::server, size_t, network::http::web_socket_frame*>("usize unsubscribe(websocket_frame@+)", &network::http::server::unsubscribe);
+				vserver->set_method("usize broadcast(const string_view&in, const string_view&in, websocket_op)", &network::http::server::broadcast);
+				vserver->set_method("void set_broadcast_policy(broadcast_policy, usize)", &network::http::server::set_broadcast_policy);
 				vserver->set_method_extern("void set_router(map_router@+)", &socket_server_set_router);
 				vserver->set_method_extern("bool configure(map_router@+)", &socket_server_configure);
 				vserver->set_method_extern("bool listen()", &socket_server_listen);
@@ -11808,6 +12135,7 @@ namespace vitex
 				auto vquery_op = vm->set_enum("query_op");
 				vquery_op->set_value("transaction_start", (int)network::sqlite::query_op::transaction_start);
 				vquery_op->set_value("transaction_end", (int)network::sqlite::query_op::transaction_end);
+				vquery_op->set_value("infer_types", (int)network::sqlite::query_op::infer_types);
 
 				auto vcheckpoint_mode = vm->set_enum("checkpoint_mode");
 				vcheckpoint_mode->set_value("passive", (int)network::sqlite::checkpoint_mode::passive);
@@ -11910,6 +12238,14 @@ namespace vitex
 				vcluster->set_method_extern("array<checkpoint>@ wal_checkpoint(checkpoint_mode, const string_view&in = string_view())", &ldb_cluster_wal_checkpoint);
 				vcluster->set_method("usize free_memory_used(usize)", &network::sqlite::cluster::free_memory_used);
 				vcluster->set_method("usize get_memory_used()", &network::sqlite::cluster::get_memory_used);
+				vcluster->set_method("void set_statement_cache_size(usize)", &network::sqlite::cluster::set_statement_cache_size);
+				vcluster->set_method("usize get_statement_cache_size()", &network::sqlite::cluster::get_statement_cache_size);
+				vcluster->set_method("void set_wal_routing(bool)", &network::sqlite::cluster::set_wal_routing);
+				vcluster->set_method("void set_group_commit(usize)", &network::sqlite::cluster::set_group_commit);
+				vcluster->set_method("usize get_group_commit()", &network::sqlite::cluster::get_group_commit);
+				vcluster->set_method("bool is_wal_routing()", &network::sqlite::cluster::is_wal_routing);
+				vcluster->set_method("void set_io_threads(usize)", &network::sqlite::cluster::set_io_threads);
+				vcluster->set_method("usize get_io_threads()", &network::sqlite::cluster::get_io_threads);
 				vcluster->set_method("uptr@ get_idle_connection()", &network::sqlite::cluster::get_idle_connection);
 				vcluster->set_method("uptr@ get_busy_connection()", &network::sqlite::cluster::get_busy_connection);
 				vcluster->set_method("uptr@ get_any_connection()", &network::sqlite::cluster::get_any_connection);
@@ -11973,6 +12309,8 @@ namespace vitex
 				vquery_op->set_value("cache_short", (int)network::pq::query_op::cache_short);
 				vquery_op->set_value("cache_mid", (int)network::pq::query_op::cache_mid);
 				vquery_op->set_value("cache_long", (int)network::pq::query_op::cache_long);
+				vquery_op->set_value("binary_results", (int)network::pq::query_op::binary_results);
+				vquery_op->set_value("no_pipeline", (int)network::pq::query_op::no_pipeline);
 
 				auto vaddress_op = vm->set_enum("address_op");
 				vaddress_op->set_value("host", (int)network::pq::address_op::host);
@@ -12013,6 +12351,8 @@ namespace vitex
 				vquery_exec->set_value("fatal_error", (int)network::pq::query_exec::fatal_error);
 				vquery_exec->set_value("copy_both", (int)network::pq::query_exec::copy_both);
 				vquery_exec->set_value("single_tuple", (int)network::pq::query_exec::single_tuple);
+				vquery_exec->set_value("pipeline_sync", (int)network::pq::query_exec::pipeline_sync);
+				vquery_exec->set_value("pipeline_aborted", (int)network::pq::query_exec::pipeline_aborted);
 
 				auto vfield_code = vm->set_enum("field_code");
 				vfield_code->set_value("severity", (int)network::pq::field_code::severity);
@@ -12205,6 +12545,7 @@ namespace vitex
 				vconnection->set_method("query_state get_state() const", &network::pq::connection::get_state);
 				vconnection->set_method("transaction_state get_tx_state() const", &network::pq::connection::get_tx_state);
 				vconnection->set_method("bool in_transaction() const", &network::pq::connection::in_transaction);
+				vconnection->set_method("bool in_pipeline() const", &network::pq::connection::in_pipeline);
 				vconnection->set_method("bool busy() const", &network::pq::connection::busy);
 
 				vrequest->set_method("cursor& get_result()", &network::pq::request::get_result);
@@ -12218,10 +12559,17 @@ namespace vitex
 				vcluster->set_constructor<network::pq::cluster>("cluster@ f()");
 				vcluster->set_method("void clear_cache()", &network::pq::cluster::clear_cache);
 				vcluster->set_method("void set_cache_cleanup(uint64)", &network::pq::cluster::set_cache_cleanup);
+				vcluster->set_method("void set_cache_capacity(usize)", &network::pq::cluster::set_cache_capacity);
+				vcluster->set_method("void invalidate_cache(const string_view&in)", &network::pq::cluster::invalidate_cache);
 				vcluster->set_method("void set_cache_duration(query_op, uint64)", &network::pq::cluster::set_cache_duration);
+				vcluster->set_method("void set_auto_prepare(bool)", &network::pq::cluster::set_auto_prepare);
+				vcluster->set_method("void set_pipeline_depth(usize)", &network::pq::cluster::set_pipeline_depth);
 				vcluster->set_method("bool remove_channel(const string_view&in, uint64)", &network::pq::cluster::remove_channel);
 				vcluster->set_method("connection@+ get_connection(query_state)", &network::pq::cluster::get_connection);
 				vcluster->set_method("connection@+ get_any_connection()", &network::pq::cluster::get_any_connection);
+				vcluster->set_method("uint64 get_round_trips_saved() const", &network::pq::cluster::get_round_trips_saved);
+				vcluster->set_method("usize get_pipeline_depth() const", &network::pq::cluster::get_pipeline_depth);
+				vcluster->set_method("bool is_auto_prepare() const", &network::pq::cluster::is_auto_prepare);
 				vcluster->set_method("bool is_connected() const", &network::pq::cluster::is_connected);
 				vcluster->set_method_extern("promise<connection@>@ tx_begin(isolation)", &VI_SPROMISIFY_REF(pdb_cluster_tx_begin, connection));
 				vcluster->set_method_extern("promise<connection@>@ tx_start(const string_view&in)", &VI_SPROMISIFY_REF(pdb_cluster_tx_start, connection));
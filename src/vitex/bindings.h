@@ -631,6 +631,7 @@ namespace vitex
 				void remove_if(void* value, size_t start_at);
 				void swap(size_t index1, size_t index2);
 				void sort(asIScriptFunction* callback);
+				void stable_sort(asIScriptFunction* callback);
 				void reverse();
 				void clear();
 				size_t find(void* value, size_t start_at) const;
@@ -651,7 +652,7 @@ namespace vitex
 				void copy_buffer(sbuffer* dst, sbuffer* src);
 				void create(sbuffer* buf, size_t start, size_t end);
 				void destroy(sbuffer* buf, size_t start, size_t end);
-				bool less(const void* a, const void* b, immediate_context* ctx, scache* cache);
+				void sort_by(asIScriptFunction* callback, bool stable);
 				bool equals(const void* a, const void* b, immediate_context* ctx, scache* cache) const;
 				bool is_eligible_for_find(scache** output) const;
 				bool is_eligible_for_sort(scache** output) const;
@@ -774,9 +775,6 @@ namespace vitex
 
 			class dictionary : public core::reference<dictionary>
 			{
-			public:
-				typedef core::unordered_map<core::string, storable> internal_map;
-
 			public:
 				class local_iterator
 				{
@@ -784,7 +782,7 @@ namespace vitex
 					friend class dictionary;
 
 				private:
-					internal_map::const_iterator it;
+					size_t index;
 					const dictionary& base;
 
 				public:
@@ -800,7 +798,7 @@ namespace vitex
 
 				private:
 					local_iterator() noexcept;
-					local_iterator(const dictionary& from, internal_map::const_iterator it) noexcept;
+					local_iterator(const dictionary& from, size_t index) noexcept;
 					local_iterator& operator= (const local_iterator&) noexcept
 					{
 						return *this;
@@ -814,12 +812,22 @@ namespace vitex
 					type_info key_type = type_info(nullptr);
 				};
 
+			private:
+				struct item
+				{
+					core::string name;
+					storable value;
+					size_t hash = 0;
+				};
+
 			private:
 				static int dictionary_id;
 
 			private:
 				virtual_machine* engine;
-				internal_map data;
+				mutable core::vector<item*> data;
+				mutable core::vector<uint32_t> slots;
+				mutable size_t removed;
 
 			public:
 				dictionary(virtual_machine* engine) noexcept;
@@ -848,6 +856,14 @@ namespace vitex
 				void enum_references(asIScriptEngine* engine);
 				void release_references(asIScriptEngine* engine);
 
+			private:
+				size_t find_index(const std::string_view& key) const;
+				item* emplace(const std::string_view& key);
+				void erase_index(size_t index);
+				void insert_slot(size_t index);
+				void rebuild_slots(size_t capacity) const;
+				void compact() const;
+
 			public:
 				static dictionary* create(virtual_machine* engine);
 				static dictionary* create(unsigned char* buffer);
@@ -8218,6 +8218,26 @@ namespace vitex
 			VI_TRACE("proc ifdef %.*s on 0x%: %s" PRIXPTR, (int)name.size(), name.data(), (void*)this, exists ? "yes" : "no");
 			return exists;
 		}
+		uint64_t preprocessor::get_definitions_hash() const
+		{
+			core::vector<core::string> names;
+			names.reserve(defines.size());
+			for (auto& item : defines)
+			{
+				core::string name = item.first;
+				for (auto& token : item.second.tokens)
+					name.append(1, ',').append(token);
+				name.append(1, '=').append(item.second.expansion);
+				names.push_back(std::move(name));
+			}
+
+			core::string data;
+			std::sort(names.begin(), names.end());
+			for (auto& name : names)
+				data.append(name).append(1, '\n');
+
+			return crypto::crc64(data);
+		}
 		bool preprocessor::is_defined(const std::string_view& name, const std::string_view& value) const
 		{
 			auto it = defines.find(core::key_lookup_cast(name));
@@ -1821,6 +1821,7 @@ namespace vitex
 			void clear();
 			bool is_defined(const std::string_view& name) const;
 			bool is_defined(const std::string_view& name, const std::string_view& value) const;
+			uint64_t get_definitions_hash() const;
 			expects_preprocessor<void> process(const std::string_view& path, core::string& buffer);
 			expects_preprocessor<core::string> resolve_file(const std::string_view& path, const std::string_view& include);
 			const core::string& get_current_file_path() const;
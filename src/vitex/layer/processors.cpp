@@ -233,6 +233,7 @@ namespace vitex
 					series::unpack_a(network->find("max-connections"), &router->max_connections);
 					series::unpack(network->find("enable-no-delay"), &router->enable_no_delay);
 					series::unpack_a(network->find("max-uploadable-resources"), &router->max_uploadable_resources);
+					series::unpack_a(network->find("max-in-memory-resource-size"), &router->max_in_memory_resource_size);
 					series::unpack(network->find("temporary-directory"), &router->temporary_directory);
 					series::unpack(network->fetch("session.cookie.name"), &router->session.cookie.name);
 					series::unpack(network->fetch("session.cookie.domain"), &router->session.cookie.domain);
@@ -243,6 +244,9 @@ namespace vitex
 					series::unpack(network->fetch("session.cookie.http-only"), &router->session.cookie.http_only);
 					series::unpack(network->fetch("session.directory"), &router->session.directory);
 					series::unpack(network->fetch("session.expires"), &router->session.expires);
+					series::unpack(network->fetch("session.sweep-interval"), &router->session.sweep_interval);
+					series::unpack(network->fetch("session.flush-interval"), &router->session.flush_interval);
+					series::unpack_a(network->fetch("session.max-entries"), &router->session.max_entries);
 					core::stringify::eval_envs(router->session.directory, base_directory, net_addresses);
 					core::stringify::eval_envs(router->temporary_directory, base_directory, net_addresses);
 
@@ -315,11 +319,22 @@ namespace vitex
 							if (series::unpack(base->fetch("compression.memory-level"), &route->compression.memory_level))
 								route->compression.memory_level = compute::math32::clamp(route->compression.memory_level, 1, 9);
 
+							if (series::unpack(base->fetch("web-socket-compression.quality-level"), &route->web_socket_compression.quality_level))
+								route->web_socket_compression.quality_level = compute::math32::clamp(route->web_socket_compression.quality_level, 0, 9);
+
+							if (series::unpack(base->fetch("web-socket-compression.memory-level"), &route->web_socket_compression.memory_level))
+								route->web_socket_compression.memory_level = compute::math32::clamp(route->web_socket_compression.memory_level, 1, 9);
+
 							series::unpack(base->find("alias"), &route->alias);
 							series::unpack(base->fetch("auth.type"), &route->auth.type);
 							series::unpack(base->fetch("auth.realm"), &route->auth.realm);
 							series::unpack_a(base->fetch("compression.min-length"), &route->compression.min_length);
 							series::unpack(base->fetch("compression.enabled"), &route->compression.enabled);
+							series::unpack_a(base->fetch("web-socket-compression.max-inflated-length"), &route->web_socket_compression.max_inflated_length);
+							series::unpack_a(base->fetch("web-socket-compression.min-length"), &route->web_socket_compression.min_length);
+							series::unpack(base->fetch("web-socket-compression.server-no-context-takeover"), &route->web_socket_compression.server_no_context_takeover);
+							series::unpack(base->fetch("web-socket-compression.client-no-context-takeover"), &route->web_socket_compression.client_no_context_takeover);
+							series::unpack(base->fetch("web-socket-compression.enabled"), &route->web_socket_compression.enabled);
 							series::unpack(base->find("char-set"), &route->char_set);
 							series::unpack(base->find("access-control-allow-origin"), &route->access_control_allow_origin);
 							series::unpack(base->find("redirect"), &route->redirect);
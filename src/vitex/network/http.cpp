@@ -45,6 +45,7 @@ extern "C"
 #define HTTP_MAX_REDIRECTS 128
 #define HTTP_HRM_SIZE 1024 * 1024 * 4
 #define HTTP_KIMV_LOAD_FACTOR 48
+#define HTTP_POOL_CLEANUP_INTERVAL 1000
 #define GZ_HEADER_SIZE 17
 #pragma warning(push)
 #pragma warning(disable: 4996)
@@ -79,6 +80,34 @@ namespace vitex
 			{
 				return core::string(array.data() + offset, size);
 			}
+			static bool multipart_spill(parser* target)
+			{
+				auto& state = target->multipart;
+				if (!state.temporary_directory || state.temporary_directory->empty())
+					return false;
+
+				auto random = compute::crypto::random_bytes(16);
+				if (!random)
+					return false;
+
+				auto hash = compute::crypto::hash_hex(compute::digests::md5(), *random);
+				if (!hash)
+					return false;
+
+				core::string contents = (state.data.is_in_memory ? std::move(state.data.path) : core::string());
+				state.data.path = *state.temporary_directory;
+				state.data.is_in_memory = false;
+				if (state.data.path.back() != '/' && state.data.path.back() != '\\')
+					state.data.path.append(1, VI_SPLITTER);
+
+				state.data.path.append(*hash);
+				auto file = core::os::file::open(state.data.path.c_str(), "wb");
+				if (!file)
+					return false;
+
+				state.stream = *file;
+				return contents.empty() || fwrite(contents.data(), 1, contents.size(), state.stream) == contents.size();
+			}
 			static std::string_view header_text(const kimv_unordered_map& headers, const std::string_view& key)
 			{
 				VI_ASSERT(!key.empty(), "key should not be empty");
@@ -172,55 +201,68 @@ namespace vitex
 				set_expires(0);
 			}
 
-			web_socket_frame::web_socket_frame(socket* new_stream, void* new_user_data) : stream(new_stream), codec(new web_codec()), state((uint32_t)web_socket_state::open), tunneling((uint32_t)tunnel::healthy), active(true), deadly(false), busy(false), user_data(new_user_data)
+			web_socket_packet::web_socket_packet(const std::string_view& buffer, web_socket_op new_opcode) noexcept : payload(buffer), opcode(new_opcode)
 			{
+				uint8_t header[14];
+				size_t header_length = encode_header(header, opcode, payload.size(), 0, false);
+				plain.reserve(header_length + payload.size());
+				plain.append((char*)header, header_length).append(payload);
+				memset(variants, 0, sizeof(variants));
 			}
-			web_socket_frame::~web_socket_frame() noexcept
+			const core::string& web_socket_packet::get_frame(web_codec* codec)
 			{
-				while (!messages.empty())
+				VI_ASSERT(codec != nullptr, "codec should be set");
+				if (!codec->is_deflate_stateless())
+					return plain;
+
+				size_t index = (size_t)(codec->get_deflate_window_bits() - 9);
+				VI_ASSERT(index < sizeof(variants), "window bits should be in range [9, 15]");
+				core::umutex<std::mutex> unique(section);
+				if (!variants[index])
 				{
-					auto& next = messages.front();
-					core::memory::deallocate(next.buffer);
-					messages.pop();
+					core::string compressed;
+					if (codec->deflate(opcode, payload, compressed))
+					{
+						uint8_t header[14];
+						size_t header_length = encode_header(header, opcode, compressed.size(), 0, true);
+						deflated[index].reserve(header_length + compressed.size());
+						deflated[index].append((char*)header, header_length).append(compressed);
+						variants[index] = 1;
+					}
+					else
+						variants[index] = 2;
 				}
 
-				core::memory::release(codec);
-				if (lifetime.destroy)
-					lifetime.destroy(this);
+				return variants[index] == 1 ? deflated[index] : plain;
 			}
-			core::expects_system<size_t> web_socket_frame::send(const std::string_view& buffer, web_socket_op opcode, web_socket_callback&& callback)
+			web_socket_op web_socket_packet::get_opcode() const
 			{
-				return send(0, buffer, opcode, std::move(callback));
+				return opcode;
 			}
-			core::expects_system<size_t> web_socket_frame::send(uint32_t mask, const std::string_view& buffer, web_socket_op opcode, web_socket_callback&& callback)
+			size_t web_socket_packet::size() const
 			{
-				core::umutex<std::mutex> unique(section);
-				if (enqueue(mask, buffer, opcode, std::move(callback)))
-					return (size_t)0;
-
-				busy = true;
-				unique.negate();
-
-				uint8_t header[14];
-				size_t header_length = 1;
+				return plain.size();
+			}
+			size_t web_socket_packet::encode_header(uint8_t header[14], web_socket_op opcode, size_t size, uint32_t mask, bool deflated)
+			{
+				size_t header_length = 2;
 				header[0] = 0x80 + ((size_t)opcode & 0xF);
+				if (deflated)
+					header[0] |= 0x40;
 
-				if (buffer.size() < 126)
+				if (size < 126)
+					header[1] = (uint8_t)size;
+				else if (size <= 65535)
 				{
-					header[1] = (uint8_t)buffer.size();
-					header_length = 2;
-				}
-				else if (buffer.size() <= 65535)
-				{
-					uint16_t length = htons((uint16_t)buffer.size());
+					uint16_t length = htons((uint16_t)size);
 					header[1] = 126;
 					header_length = 4;
 					memcpy(header + 2, &length, 2);
 				}
 				else
 				{
-					uint32_t length1 = htonl((uint64_t)buffer.size() >> 32);
-					uint32_t length2 = htonl((uint64_t)buffer.size() & 0xFFFFFFFF);
+					uint32_t length1 = htonl((uint64_t)size >> 32);
+					uint32_t length2 = htonl((uint64_t)size & 0xFFFFFFFF);
 					header[1] = 127;
 					header_length = 10;
 					memcpy(header + 2, &length1, 4);
@@ -234,65 +276,55 @@ namespace vitex
 					header_length += 4;
 				}
 
-				core::string copy = core::string(buffer);
-				auto status = stream->write_queued(header, header_length, [this, copy = std::move(copy), callback = std::move(callback)](socket_poll event) mutable
-				{
-					if (packet::is_done(event))
-					{
-						if (!copy.empty())
-						{
-							stream->write_queued((uint8_t*)copy.data(), copy.size(), [this, callback = std::move(callback)](socket_poll event)
-							{
-								if (packet::is_done(event) || packet::is_skip(event))
-								{
-									bool ignore = is_ignore();
-									busy = false;
+				return header_length;
+			}
 
-									if (callback)
-										callback(this);
+			web_socket_frame::web_socket_frame(socket* new_stream, void* new_user_data) : stream(new_stream), codec(new web_codec()), state((uint32_t)web_socket_state::open), tunneling((uint32_t)tunnel::healthy), active(true), deadly(false), busy(false), backlog(0), user_data(new_user_data)
+			{
+			}
+			web_socket_frame::~web_socket_frame() noexcept
+			{
+				while (!messages.empty())
+				{
+					auto& next = messages.front();
+					core::memory::deallocate(next.buffer);
+					core::memory::release(next.packet);
+					messages.pop();
+				}
 
-									if (!ignore)
-										dequeue();
-								}
-								else if (packet::is_error(event))
-								{
-									tunneling = (uint32_t)tunnel::gone;
-									busy = false;
-									if (callback)
-										callback(this);
-								}
-							});
-						}
-						else
-						{
-							bool ignore = is_ignore();
-							busy = false;
+				core::memory::release(codec);
+				if (lifetime.destroy)
+					lifetime.destroy(this);
+			}
+			core::expects_system<size_t> web_socket_frame::send(const std::string_view& buffer, web_socket_op opcode, web_socket_callback&& callback)
+			{
+				return send(0, buffer, opcode, std::move(callback));
+			}
+			core::expects_system<size_t> web_socket_frame::send(uint32_t mask, const std::string_view& buffer, web_socket_op opcode, web_socket_callback&& callback)
+			{
+				core::umutex<std::mutex> unique(section);
+				if (enqueue(mask, buffer, opcode, std::move(callback)))
+					return (size_t)0;
 
-							if (callback)
-								callback(this);
+				busy = true;
+				unique.negate();
 
-							if (!ignore)
-								dequeue();
-						}
-					}
-					else if (packet::is_error(event))
-					{
-						tunneling = (uint32_t)tunnel::gone;
-						busy = false;
-						if (callback)
-							callback(this);
-					}
-					else if (packet::is_skip(event))
-					{
-						bool ignore = is_ignore();
-						busy = false;
+				core::string copy;
+				bool deflated = codec->deflate(opcode, buffer, copy);
+				if (!deflated)
+					copy.assign(buffer.data(), buffer.size());
 
-						if (callback)
-							callback(this);
+				uint8_t header[14];
+				size_t header_length = web_socket_packet::encode_header(header, opcode, copy.size(), mask, deflated);
+				if (mask)
+					web_codec::mask_payload(copy.data(), copy.size(), (uint8_t*)&mask, 0);
 
-						if (!ignore)
-							dequeue();
-					}
+				auto status = stream->write_queued(header, header_length, [this, copy = std::move(copy), callback = std::move(callback)](socket_poll event) mutable
+				{
+					if (packet::is_done(event) && !copy.empty())
+						stream->write_queued((uint8_t*)copy.data(), copy.size(), [this, callback = std::move(callback)](socket_poll event) mutable { complete(event, std::move(callback)); });
+					else
+						complete(event, std::move(callback));
 				});
 				if (status)
 					return *status;
@@ -301,6 +333,30 @@ namespace vitex
 
 				return core::system_exception("ws send error", std::move(status.error()));
 			}
+			core::expects_system<size_t> web_socket_frame::send(web_socket_packet* packet, web_socket_callback&& callback)
+			{
+				VI_ASSERT(packet != nullptr, "packet should be set");
+				core::umutex<std::mutex> unique(section);
+				if (enqueue(packet, std::move(callback)))
+					return (size_t)0;
+
+				busy = true;
+				unique.negate();
+
+				packet->add_ref();
+				auto& frame = packet->get_frame(codec);
+				auto status = stream->write_queued((uint8_t*)frame.data(), frame.size(), [this, packet, callback = std::move(callback)](socket_poll event) mutable
+				{
+					core::memory::release(packet);
+					complete(event, std::move(callback));
+				}, false);
+				if (status)
+					return *status;
+				else if (status.error() == std::errc::operation_would_block)
+					return (size_t)0;
+
+				return core::system_exception("ws send error", std::move(status.error()));
+			}
 			core::expects_system<void> web_socket_frame::send_close(web_socket_callback&& callback)
 			{
 				if (deadly)
@@ -339,10 +395,40 @@ namespace vitex
 
 				message next = std::move(messages.front());
 				messages.pop();
+				backlog -= next.size;
 				unique.negate();
 
-				send(next.mask, std::string_view(next.buffer, next.size), next.opcode, std::move(next.callback));
-				core::memory::deallocate(next.buffer);
+				if (next.packet != nullptr)
+				{
+					send(next.packet, std::move(next.callback));
+					core::memory::release(next.packet);
+				}
+				else
+				{
+					send(next.mask, std::string_view(next.buffer, next.size), next.opcode, std::move(next.callback));
+					core::memory::deallocate(next.buffer);
+				}
+			}
+			void web_socket_frame::complete(socket_poll event, web_socket_callback&& callback)
+			{
+				if (packet::is_done(event) || packet::is_skip(event))
+				{
+					bool ignore = is_ignore();
+					busy = false;
+
+					if (callback)
+						callback(this);
+
+					if (!ignore)
+						dequeue();
+				}
+				else if (packet::is_error(event))
+				{
+					tunneling = (uint32_t)tunnel::gone;
+					busy = false;
+					if (callback)
+						callback(this);
+				}
 			}
 			void web_socket_frame::finalize()
 			{
@@ -408,13 +494,12 @@ namespace vitex
 				}
 				else if (state == (uint32_t)web_socket_state::process)
 				{
-					uint8_t buffer[core::BLOB_SIZE];
 					while (true)
 					{
-						auto size = stream->read(buffer, sizeof(buffer));
+						auto size = stream->read((uint8_t*)codec->get_receive_buffer(core::BLOB_SIZE), core::BLOB_SIZE);
 						if (size)
 						{
-							codec->parse_frame(buffer, *size);
+							codec->parse_received(*size);
 							continue;
 						}
 
@@ -430,18 +515,18 @@ namespace vitex
 						}
 					}
 
-					web_socket_op opcode;
-					if (!codec->get_frame(&opcode, &codec->data))
+					web_socket_op opcode; std::string_view data;
+					if (!codec->get_frame(&opcode, &data))
 						goto retry;
 
 					state = (uint32_t)web_socket_state::process;
 					if (opcode == web_socket_op::text || opcode == web_socket_op::binary)
 					{
-						VI_DEBUG("websocket sock %i frame data: %.*s", (int)stream->get_fd(), (int)codec->data.size(), codec->data.data());
+						VI_DEBUG("websocket sock %i frame data: %.*s", (int)stream->get_fd(), (int)data.size(), data.data());
 						if (receive)
 						{
 							unique.negate();
-							if (!receive(this, opcode, std::string_view(codec->data.data(), codec->data.size())))
+							if (!receive(this, opcode, data))
 								next();
 						}
 					}
@@ -488,6 +573,10 @@ namespace vitex
 					}
 				}
 			}
+			size_t web_socket_frame::get_backlog() const
+			{
+				return backlog;
+			}
 			bool web_socket_frame::is_finished()
 			{
 				return !active;
@@ -527,6 +616,25 @@ namespace vitex
 					memcpy(next.buffer, buffer.data(), sizeof(char) * buffer.size());
 
 				messages.emplace(std::move(next));
+				backlog += buffer.size();
+				return true;
+			}
+			bool web_socket_frame::enqueue(web_socket_packet* packet, web_socket_callback&& callback)
+			{
+				if (is_writeable())
+					return false;
+
+				message next;
+				next.mask = 0;
+				next.buffer = nullptr;
+				next.size = packet->size();
+				next.opcode = packet->get_opcode();
+				next.callback = std::move(callback);
+				next.packet = packet;
+				next.packet->add_ref();
+
+				messages.emplace(std::move(next));
+				backlog += packet->size();
 				return true;
 			}
 
@@ -561,6 +669,7 @@ namespace vitex
 					core::memory::release(item);
 
 				groups.clear();
+				core::memory::release(sessions);
 				core::memory::release(base);
 			}
 			void map_router::sort()
@@ -1553,6 +1662,9 @@ namespace vitex
 			}
 			connection::~connection() noexcept
 			{
+				if (web_socket != nullptr)
+					root->unsubscribe(web_socket);
+
 				core::memory::release(resolver);
 				core::memory::release(web_socket);
 			}
@@ -1769,6 +1881,9 @@ namespace vitex
 					return true;
 				}
 
+				if (web_socket != nullptr)
+					root->unsubscribe(web_socket);
+
 				core::memory::release(web_socket);
 				return false;
 			}
@@ -1951,6 +2066,15 @@ namespace vitex
 				});
 			}
 			bool connection::store(resource_callback&& callback, bool eat)
+			{
+				return consume(std::move(callback), nullptr, eat);
+			}
+			bool connection::pipe(resource_chunk_callback&& chunk_callback, resource_callback&& callback)
+			{
+				VI_ASSERT(chunk_callback != nullptr, "chunk callback should be set");
+				return consume(std::move(callback), std::move(chunk_callback), false);
+			}
+			bool connection::consume(resource_callback&& callback, resource_chunk_callback&& chunk_callback, bool eat)
 			{
 				VI_ASSERT(connection_valid(this), "connection should be valid");
 				if (!request.content.resources.empty())
@@ -1987,13 +2111,13 @@ namespace vitex
 				size_t content_length = request.content.length >= request.content.prefetch ? request.content.length - request.content.prefetch : request.content.length;
 				if (!content_type.empty() && boundary_name != nullptr)
 				{
-					if (route->router->temporary_directory.empty())
+					if (route->router->temporary_directory.empty() && !route->router->max_in_memory_resource_size && !chunk_callback)
 						eat = true;
 
 					core::string boundary("--");
 					boundary.append(boundary_name + 9);
 
-					resolver->prepare_for_multipart_parsing(&response.content, &route->router->temporary_directory, route->router->max_uploadable_resources, eat, std::move(callback));
+					resolver->prepare_for_multipart_parsing(&response.content, &route->router->temporary_directory, route->router->max_uploadable_resources, route->router->max_in_memory_resource_size, eat, std::move(callback), std::move(chunk_callback));
 					if (request.content.prefetch > 0)
 					{
 						request.content.prefetch = 0;
@@ -2029,7 +2153,7 @@ namespace vitex
 						return true;
 					});
 				}
-				else if (!content_length)
+				else if (!content_length && (eat || !chunk_callback || !request.content.prefetch))
 				{
 					if (callback)
 						callback(nullptr);
@@ -2055,6 +2179,64 @@ namespace vitex
 				http::resource subresource;
 				subresource.length = request.content.length;
 				subresource.type = (content_type.empty() ? "application/octet-stream" : content_type);
+				if (chunk_callback)
+				{
+					subresource.length = 0;
+					subresource.is_in_memory = true;
+					if (request.content.prefetch > 0)
+					{
+						std::string_view chunk(request.content.data.data(), request.content.data.size());
+						if (!chunk_callback(&subresource, chunk))
+						{
+							if (callback)
+								callback(nullptr);
+							return false;
+						}
+						subresource.length += chunk.size();
+					}
+
+					request.content.prefetch = 0;
+					if (!content_length)
+					{
+						request.content.finalize();
+						if (callback)
+						{
+							callback(&subresource);
+							callback(nullptr);
+						}
+						return true;
+					}
+
+					return !!stream->read_queued(content_length, [this, subresource = std::move(subresource), callback = std::move(callback), chunk_callback = std::move(chunk_callback)](socket_poll event, const uint8_t* buffer, size_t recv) mutable
+					{
+						if (packet::is_data(event))
+						{
+							request.content.offset += recv;
+							if (chunk_callback(&subresource, std::string_view((char*)buffer, recv)))
+							{
+								subresource.length += recv;
+								return true;
+							}
+
+							if (callback)
+								callback(nullptr);
+
+							return false;
+						}
+						else if (packet::is_done(event) || packet::is_error_or_skip(event))
+						{
+							request.content.finalize();
+							if (packet::is_done(event) && callback)
+								callback(&subresource);
+
+							if (callback)
+								callback(nullptr);
+							return false;
+						}
+
+						return true;
+					});
+				}
 
 				auto hash = compute::crypto::hash_hex(compute::digests::md5(), *compute::crypto::random_bytes(16));
 				subresource.path = *core::os::directory::get_working() + *hash;
@@ -2469,89 +2651,430 @@ namespace vitex
 				return base->set(key, core::var::string(""));
 			}
 
-			session::session()
+			memory_session_store::memory_session_store(session_store* new_next, size_t new_max_entries, size_t new_shards_count) : next(new_next), max_entries(new_max_entries)
 			{
-				query = core::var::set::object();
+				shards.resize(std::max<size_t>(1, new_shards_count));
+				for (auto*& target : shards)
+					target = core::memory::init<shard>();
 			}
-			session::~session() noexcept
+			memory_session_store::~memory_session_store() noexcept
 			{
-				core::memory::release(query);
+				for (auto* target : shards)
+					core::memory::deinit(target);
+				core::memory::release(next);
 			}
-			core::expects_system<void> session::write(connection* base)
+			core::expects_system<void> memory_session_store::store(const std::string_view& session_id, core::string&& data, int64_t expires)
 			{
-				VI_ASSERT(connection_valid(base), "connection should be valid");
-				auto* router = base->route->router;
-				core::string path = router->session.directory + find_session_id(base);
-				auto stream = core::os::file::open(path.c_str(), "wb");
-				if (!stream)
-					return core::system_exception("session write error", std::move(stream.error()));
-
-				session_expires = time(nullptr) + router->session.expires;
-				fwrite(&session_expires, sizeof(int64_t), 1, *stream);
-				query->convert_to_jsonb(query, [&stream](core::var_form, const std::string_view& buffer)
+				auto& target = get_shard(session_id);
+				core::umutex<std::mutex> unique(target.section);
+				if (next != nullptr)
 				{
-					if (!buffer.empty())
-						fwrite(buffer.data(), buffer.size(), 1, *stream);
-				});
-				core::os::file::close(*stream);
+					insert(target, session_id, core::string(data), expires);
+					unique.negate();
+					return next->store(session_id, std::move(data), expires);
+				}
+
+				insert(target, session_id, std::move(data), expires);
 				return core::expectation::met;
 			}
-			core::expects_system<void> session::read(connection* base)
+			core::expects_system<int64_t> memory_session_store::load(const std::string_view& session_id, core::string* data)
 			{
-				VI_ASSERT(connection_valid(base), "connection should be valid");
-				core::string path = base->route->router->session.directory + find_session_id(base);
-				auto stream = core::os::file::open(path.c_str(), "rb");
-				if (!stream)
-					return core::system_exception("session read error", std::move(stream.error()));
-
-				if (fread(&session_expires, 1, sizeof(int64_t), *stream) != sizeof(int64_t))
+				VI_ASSERT(data != nullptr, "data should be set");
+				auto& target = get_shard(session_id);
+				core::umutex<std::mutex> unique(target.section);
+				auto it = target.index.find(core::key_lookup_cast(session_id));
+				if (it != target.index.end())
 				{
-					core::os::file::close(*stream);
-					return core::system_exception("session read error: invalid format", std::make_error_condition(std::errc::bad_message));
+					auto& item = *it->second;
+					if (item.expires <= time(nullptr))
+					{
+						target.order.erase(it->second);
+						target.index.erase(it);
+						unique.negate();
+						if (next != nullptr)
+							next->remove(session_id);
+						return core::system_exception("session read error: expired", std::make_error_condition(std::errc::timed_out));
+					}
+
+					target.order.splice(target.order.begin(), target.order, it->second);
+					data->assign(item.data);
+					return item.expires;
 				}
 
-				if (session_expires <= time(nullptr))
+				unique.negate();
+				if (!next)
+					return core::system_exception("session read error: not found", std::make_error_condition(std::errc::no_such_file_or_directory));
+
+				auto expires = next->load(session_id, data);
+				if (!expires)
+					return expires;
+
+				unique.negate();
+				insert(target, session_id, core::string(*data), *expires);
+				return expires;
+			}
+			core::expects_system<void> memory_session_store::remove(const std::string_view& session_id)
+			{
+				auto& target = get_shard(session_id);
+				core::umutex<std::mutex> unique(target.section);
+				auto it = target.index.find(core::key_lookup_cast(session_id));
+				if (it != target.index.end())
 				{
-					session_id.clear();
-					core::os::file::close(*stream);
-					core::os::file::remove(path.c_str());
-					return core::system_exception("session read error: expired", std::make_error_condition(std::errc::timed_out));
+					target.order.erase(it->second);
+					target.index.erase(it);
 				}
 
-				core::memory::release(query);
-				auto result = core::schema::convert_from_jsonb([&stream](uint8_t* buffer, size_t size) { return fread(buffer, sizeof(uint8_t), size, *stream) == size; });
-				core::os::file::close(*stream);
-				if (!result)
-					return core::system_exception(result.error().message(), std::make_error_condition(std::errc::bad_message));
+				unique.negate();
+				if (next != nullptr)
+					return next->remove(session_id);
 
-				query = *result;
 				return core::expectation::met;
 			}
-			void session::clear()
+			core::expects_system<void> memory_session_store::flush()
 			{
-				if (query != nullptr)
-					query->clear();
+				if (next != nullptr)
+					return next->flush();
+
+				return core::expectation::met;
 			}
-			core::string& session::find_session_id(connection* base)
+			core::expects_system<void> memory_session_store::clear()
 			{
-				if (!session_id.empty())
-					return session_id;
+				for (auto* item : shards)
+				{
+					auto& target = *item;
+					core::umutex<std::mutex> unique(target.section);
+					target.index.clear();
+					target.order.clear();
+				}
 
-				VI_ASSERT(connection_valid(base), "connection should be valid");
-				auto value = base->request.get_cookie(base->route->router->session.cookie.name.c_str());
-				if (value.empty())
-					return generate_session_id(base);
+				if (next != nullptr)
+					return next->clear();
 
-				return session_id.assign(value);
+				return core::expectation::met;
 			}
-			core::string& session::generate_session_id(connection* base)
+			size_t memory_session_store::sweep(int64_t time)
 			{
-				VI_ASSERT(connection_valid(base), "connection should be valid");
-				int64_t time = ::time(nullptr);
-				auto hash = compute::crypto::hash_hex(compute::digests::md5(), base->request.location + core::to_string(time));
-				if (hash)
-					session_id = *hash;
-				else
+				size_t count = 0;
+				for (auto* item : shards)
+				{
+					auto& target = *item;
+					core::umutex<std::mutex> unique(target.section);
+					for (auto it = target.order.begin(); it != target.order.end();)
+					{
+						if (it->expires > time)
+						{
+							++it;
+							continue;
+						}
+
+						target.index.erase(it->session_id);
+						it = target.order.erase(it);
+						++count;
+					}
+				}
+
+				if (next != nullptr)
+					count += next->sweep(time);
+
+				return count;
+			}
+			size_t memory_session_store::size()
+			{
+				size_t count = 0;
+				for (auto* item : shards)
+				{
+					auto& target = *item;
+					core::umutex<std::mutex> unique(target.section);
+					count += target.index.size();
+				}
+				return count;
+			}
+			memory_session_store::shard& memory_session_store::get_shard(const std::string_view& session_id)
+			{
+				return *shards[std::hash<std::string_view>()(session_id) % shards.size()];
+			}
+			void memory_session_store::insert(shard& target, const std::string_view& session_id, core::string&& data, int64_t expires)
+			{
+				auto it = target.index.find(core::key_lookup_cast(session_id));
+				if (it != target.index.end())
+				{
+					auto& item = *it->second;
+					item.data = std::move(data);
+					item.expires = expires;
+					target.order.splice(target.order.begin(), target.order, it->second);
+					return;
+				}
+
+				entry item;
+				item.session_id = core::string(session_id);
+				item.data = std::move(data);
+				item.expires = expires;
+				target.order.emplace_front(std::move(item));
+				target.index[target.order.front().session_id] = target.order.begin();
+
+				size_t capacity = std::max<size_t>(1, max_entries / shards.size());
+				while (max_entries > 0 && target.index.size() > capacity)
+				{
+					target.index.erase(target.order.back().session_id);
+					target.order.pop_back();
+				}
+			}
+
+			file_session_store::file_session_store(const std::string_view& new_directory, size_t new_max_pending) : directory(new_directory), scheduled(false), max_pending(new_max_pending)
+			{
+				if (!directory.empty() && directory.back() != '/' && directory.back() != '\\')
+					directory.append(1, VI_SPLITTER);
+			}
+			file_session_store::~file_session_store() noexcept
+			{
+				flush();
+			}
+			core::expects_system<void> file_session_store::store(const std::string_view& session_id, core::string&& data, int64_t expires)
+			{
+				if (!is_session_id_valid(session_id))
+					return core::system_exception("session write error: invalid id", std::make_error_condition(std::errc::invalid_argument));
+
+				pending_write next;
+				next.data = std::move(data);
+				next.expires = expires;
+				enqueue(session_id, std::move(next));
+				return core::expectation::met;
+			}
+			core::expects_system<int64_t> file_session_store::load(const std::string_view& session_id, core::string* data)
+			{
+				VI_ASSERT(data != nullptr, "data should be set");
+				if (!is_session_id_valid(session_id))
+					return core::system_exception("session read error: invalid id", std::make_error_condition(std::errc::invalid_argument));
+
+				core::umutex<std::mutex> unique(section);
+				auto it = pending.find(core::key_lookup_cast(session_id));
+				if (it == pending.end())
+				{
+					it = writing.find(core::key_lookup_cast(session_id));
+					if (it == writing.end())
+						it = pending.end();
+				}
+
+				if (it != pending.end())
+				{
+					if (it->second.removal)
+						return core::system_exception("session read error: not found", std::make_error_condition(std::errc::no_such_file_or_directory));
+					else if (it->second.expires <= time(nullptr))
+						return core::system_exception("session read error: expired", std::make_error_condition(std::errc::timed_out));
+
+					data->assign(it->second.data);
+					return it->second.expires;
+				}
+
+				unique.negate();
+				core::string path = directory + core::string(session_id);
+				auto content = core::os::file::read_as_string(path);
+				if (!content)
+					return core::system_exception("session read error", std::move(content.error()));
+
+				int64_t expires;
+				if (content->size() < sizeof(int64_t))
+					return core::system_exception("session read error: invalid format", std::make_error_condition(std::errc::bad_message));
+
+				memcpy(&expires, content->data(), sizeof(int64_t));
+				if (expires <= time(nullptr))
+				{
+					core::os::file::remove(path.c_str());
+					return core::system_exception("session read error: expired", std::make_error_condition(std::errc::timed_out));
+				}
+
+				data->assign(content->data() + sizeof(int64_t), content->size() - sizeof(int64_t));
+				return expires;
+			}
+			core::expects_system<void> file_session_store::remove(const std::string_view& session_id)
+			{
+				if (!is_session_id_valid(session_id))
+					return core::system_exception("session remove error: invalid id", std::make_error_condition(std::errc::invalid_argument));
+
+				pending_write next;
+				next.removal = true;
+				enqueue(session_id, std::move(next));
+				return core::expectation::met;
+			}
+			core::expects_system<void> file_session_store::flush()
+			{
+				core::umutex<std::mutex> batch(flushing);
+				core::umutex<std::mutex> unique(section);
+				writing.swap(pending);
+				scheduled = false;
+				unique.negate();
+
+				core::expects_system<void> result = core::expectation::met;
+				for (auto& item : writing)
+				{
+					core::string path = directory + item.first;
+					if (item.second.removal)
+					{
+						core::os::file::remove(path.c_str());
+						continue;
+					}
+
+					auto stream = core::os::file::open(path.c_str(), "wb");
+					if (!stream)
+					{
+						result = core::system_exception("session write error", std::move(stream.error()));
+						continue;
+					}
+
+					fwrite(&item.second.expires, sizeof(int64_t), 1, *stream);
+					if (!item.second.data.empty())
+						fwrite(item.second.data.data(), item.second.data.size(), 1, *stream);
+					core::os::file::close(*stream);
+				}
+
+				unique.negate();
+				writing.clear();
+				return result;
+			}
+			core::expects_system<void> file_session_store::clear()
+			{
+				core::umutex<std::mutex> batch(flushing);
+				core::umutex<std::mutex> unique(section);
+				pending.clear();
+				unique.negate();
+				return session::invalidate_cache(directory);
+			}
+			size_t file_session_store::sweep(int64_t time)
+			{
+				flush();
+				core::vector<std::pair<core::string, core::file_entry>> entries;
+				if (!core::os::directory::scan(directory, entries))
+					return 0;
+
+				size_t count = 0;
+				for (auto& item : entries)
+				{
+					if (item.second.is_directory)
+						continue;
+
+					core::string path = directory + item.first;
+					auto stream = core::os::file::open(path.c_str(), "rb");
+					if (!stream)
+						continue;
+
+					int64_t expires = 0;
+					bool expired = fread(&expires, 1, sizeof(int64_t), *stream) != sizeof(int64_t) || expires <= time;
+					core::os::file::close(*stream);
+					if (expired && core::os::file::remove(path.c_str()))
+						++count;
+				}
+
+				return count;
+			}
+			void file_session_store::enqueue(const std::string_view& session_id, pending_write&& next)
+			{
+				core::umutex<std::mutex> unique(section);
+				pending[core::string(session_id)] = std::move(next);
+				if (pending.size() < max_pending || scheduled)
+					return;
+
+				scheduled = true;
+				unique.negate();
+				add_ref();
+				core::codefer([this]()
+				{
+					flush();
+					release();
+				});
+			}
+			bool file_session_store::is_session_id_valid(const std::string_view& session_id)
+			{
+				if (session_id.empty())
+					return false;
+
+				for (char symbol : session_id)
+				{
+					if (!core::stringify::is_alphanum(symbol) && symbol != '-' && symbol != '_')
+						return false;
+				}
+
+				return true;
+			}
+
+			session::session()
+			{
+				query = core::var::set::object();
+			}
+			session::~session() noexcept
+			{
+				core::memory::release(query);
+			}
+			core::expects_system<void> session::write(connection* base)
+			{
+				VI_ASSERT(connection_valid(base), "connection should be valid");
+				auto* router = base->route->router;
+				if (!router->sessions)
+					return core::system_exception("session write error: no session store", std::make_error_condition(std::errc::not_supported));
+
+				core::string data;
+				session_expires = time(nullptr) + router->session.expires;
+				query->convert_to_jsonb(query, [&data](core::var_form, const std::string_view& buffer) { data.append(buffer); });
+				return router->sessions->store(find_session_id(base), std::move(data), session_expires);
+			}
+			core::expects_system<void> session::read(connection* base)
+			{
+				VI_ASSERT(connection_valid(base), "connection should be valid");
+				auto* router = base->route->router;
+				if (!router->sessions)
+					return core::system_exception("session read error: no session store", std::make_error_condition(std::errc::not_supported));
+
+				core::string data;
+				auto expires = router->sessions->load(find_session_id(base), &data);
+				if (!expires)
+				{
+					if (expires.error().error() == std::errc::timed_out)
+						session_id.clear();
+					return expires.error();
+				}
+
+				size_t offset = 0;
+				session_expires = *expires;
+				core::memory::release(query);
+				auto result = core::schema::convert_from_jsonb([&data, &offset](uint8_t* buffer, size_t size)
+				{
+					if (offset + size > data.size())
+						return false;
+
+					memcpy(buffer, data.data() + offset, size);
+					offset += size;
+					return true;
+				});
+				if (!result)
+					return core::system_exception(result.error().message(), std::make_error_condition(std::errc::bad_message));
+
+				query = *result;
+				return core::expectation::met;
+			}
+			void session::clear()
+			{
+				if (query != nullptr)
+					query->clear();
+			}
+			core::string& session::find_session_id(connection* base)
+			{
+				if (!session_id.empty())
+					return session_id;
+
+				VI_ASSERT(connection_valid(base), "connection should be valid");
+				auto value = base->request.get_cookie(base->route->router->session.cookie.name.c_str());
+				if (value.empty())
+					return generate_session_id(base);
+
+				return session_id.assign(value);
+			}
+			core::string& session::generate_session_id(connection* base)
+			{
+				VI_ASSERT(connection_valid(base), "connection should be valid");
+				int64_t time = ::time(nullptr);
+				auto hash = compute::crypto::hash_hex(compute::digests::md5(), base->request.location + core::to_string(time));
+				if (hash)
+					session_id = *hash;
+				else
 					session_id = core::to_string(time);
 
 				auto* router = base->route->router;
@@ -2631,14 +3154,19 @@ namespace vitex
 			{
 				chunked = chunked_state();
 			}
-			void parser::prepare_for_multipart_parsing(content_frame* content, core::string* temporary_directory, size_t max_resources, bool skip, resource_callback&& callback)
+			void parser::prepare_for_multipart_parsing(content_frame* content, core::string* temporary_directory, size_t max_resources, size_t max_in_memory_size, bool skip, resource_callback&& callback, resource_chunk_callback&& chunk_callback)
 			{
+				if (multipart.stream != nullptr)
+					core::os::file::close(multipart.stream);
+
 				core::memory::deallocate(multipart.boundary);
 				multipart = multipart_state();
 				multipart.skip = skip;
 				multipart.max_resources = max_resources;
+				multipart.max_in_memory_size = max_in_memory_size;
 				multipart.temporary_directory = temporary_directory;
 				multipart.callback = std::move(callback);
+				multipart.chunk_callback = std::move(chunk_callback);
 				message.header.clear();
 				message.content = content;
 			}
@@ -3610,20 +4138,178 @@ namespace vitex
 				return process_headers(buffer, buffer_end, out);
 			}
 
-			web_codec::web_codec() : state(bytecode::begin), fragment(0)
+			web_codec::web_codec() : remains(0), filled(0), offset(0), length(0), inlines(0), opcode(web_socket_op::next), fragment_opcode(web_socket_op::next), state(bytecode::begin), fragment(0), final(0), control(0), masked(0), masks(0), compressed(0)
+			{
+			}
+			web_codec::~web_codec() noexcept
+			{
+#ifdef VI_ZLIB
+				z_stream* inflater = (z_stream*)compression.inflater;
+				if (inflater != nullptr)
+				{
+					inflateEnd(inflater);
+					core::memory::deinit(inflater);
+				}
+
+				z_stream* deflater = (z_stream*)compression.deflater;
+				if (deflater != nullptr)
+				{
+					deflateEnd(deflater);
+					core::memory::deinit(deflater);
+				}
+#endif
+			}
+			bool web_codec::enable_deflate(size_t min_length, size_t max_length, int window_bits, int quality_level, int memory_level, bool inflate_no_context_takeover, bool deflate_no_context_takeover)
+			{
+#ifdef VI_ZLIB
+				VI_ASSERT(!compression.inflater && !compression.deflater, "deflate should not be enabled twice");
+				VI_ASSERT(window_bits >= 9 && window_bits <= 15, "window bits should be in range [9, 15]");
+				z_stream* inflater = core::memory::init<z_stream>();
+				memset(inflater, 0, sizeof(z_stream));
+				if (inflateInit2(inflater, -15) != Z_OK)
+				{
+					core::memory::deinit(inflater);
+					return false;
+				}
+
+				z_stream* deflater = core::memory::init<z_stream>();
+				memset(deflater, 0, sizeof(z_stream));
+				if (deflateInit2(deflater, quality_level, Z_DEFLATED, -window_bits, memory_level, Z_DEFAULT_STRATEGY) != Z_OK)
+				{
+					inflateEnd(inflater);
+					core::memory::deinit(inflater);
+					core::memory::deinit(deflater);
+					return false;
+				}
+
+				compression.inflater = inflater;
+				compression.deflater = deflater;
+				compression.min_length = min_length;
+				compression.max_length = max_length;
+				compression.window_bits = window_bits;
+				compression.inflate_reset = inflate_no_context_takeover;
+				compression.deflate_reset = deflate_no_context_takeover;
+				return true;
+#else
+				return false;
+#endif
+			}
+			bool web_codec::deflate(web_socket_op op, const std::string_view& buffer, core::string& output)
+			{
+#ifdef VI_ZLIB
+				z_stream* deflater = (z_stream*)compression.deflater;
+				if (!deflater || (op != web_socket_op::text && op != web_socket_op::binary) || buffer.size() < compression.min_length)
+					return false;
+
+				output.clear();
+				deflater->next_in = (Bytef*)buffer.data();
+				deflater->avail_in = (uInt)buffer.size();
+				do
+				{
+					size_t size = output.size();
+					size_t chunk = std::max<size_t>(core::BLOB_SIZE, deflateBound(deflater, (uLong)deflater->avail_in));
+					output.resize(size + chunk);
+					deflater->next_out = (Bytef*)output.data() + size;
+					deflater->avail_out = (uInt)chunk;
+
+					int status = ::deflate(deflater, Z_SYNC_FLUSH);
+					output.resize(size + chunk - deflater->avail_out);
+					if (status != Z_OK && status != Z_BUF_ERROR)
+					{
+						deflateReset(deflater);
+						output.clear();
+						return false;
+					}
+				} while (deflater->avail_out == 0);
+
+				if (output.size() >= 4 && memcmp(output.data() + output.size() - 4, "\x00\x00\xff\xff", 4) == 0)
+					output.resize(output.size() - 4);
+
+				if (compression.deflate_reset)
+					deflateReset(deflater);
+
+				return true;
+#else
+				return false;
+#endif
+			}
+			bool web_codec::inflate(const char* buffer, size_t size, core::vector<char>& output)
 			{
+#ifdef VI_ZLIB
+				z_stream* inflater = (z_stream*)compression.inflater;
+				if (!inflater)
+					return false;
+
+				output.clear();
+				bool finished = false;
+				for (auto& next : { std::string_view(buffer, size), std::string_view("\x00\x00\xff\xff", 4) })
+				{
+					if (finished)
+						break;
+
+					inflater->next_in = (Bytef*)next.data();
+					inflater->avail_in = (uInt)next.size();
+					while (inflater->avail_in > 0)
+					{
+						size_t offset = output.size();
+						size_t chunk = std::max<size_t>(core::BLOB_SIZE, (size_t)inflater->avail_in * 4);
+						output.resize(offset + chunk);
+						inflater->next_out = (Bytef*)output.data() + offset;
+						inflater->avail_out = (uInt)chunk;
+
+						int status = ::inflate(inflater, Z_SYNC_FLUSH);
+						output.resize(offset + chunk - inflater->avail_out);
+						if ((status != Z_OK && status != Z_STREAM_END && status != Z_BUF_ERROR) || (status == Z_BUF_ERROR && inflater->avail_out > 0))
+						{
+							inflateReset(inflater);
+							return false;
+						}
+						else if (compression.max_length > 0 && output.size() > compression.max_length)
+						{
+							inflateReset(inflater);
+							return false;
+						}
+						else if (status == Z_STREAM_END)
+						{
+							finished = true;
+							break;
+						}
+					}
+				}
+
+				if (finished && !compression.inflate_reset)
+				{
+					uint8_t window[32768];
+					uInt window_size = (uInt)sizeof(window);
+					if (inflateGetDictionary(inflater, window, &window_size) != Z_OK)
+						window_size = 0;
+
+					inflateReset(inflater);
+					if (window_size > 0 && inflateSetDictionary(inflater, window, window_size) != Z_OK)
+						return false;
+				}
+				else if (compression.inflate_reset)
+					inflateReset(inflater);
+
+				return true;
+#else
+				return false;
+#endif
 			}
 			bool web_codec::parse_frame(const uint8_t* buffer, size_t size)
 			{
 				if (!buffer || !size)
 					return !queue.empty();
 
-				if (payload.capacity() <= size)
-					payload.resize(size);
+				memcpy(get_receive_buffer(size), buffer, sizeof(char) * size);
+				return parse_received(size);
+			}
+			bool web_codec::parse_received(size_t size)
+			{
+				VI_ASSERT(filled + size <= payload.size(), "received size should fit receive buffer");
+				char* data = payload.data() + filled;
+				filled += size;
 
-				memcpy(payload.data(), buffer, sizeof(char) * size);
-				char* data = payload.data();
-			parse_payload:
 				while (size)
 				{
 					uint8_t index = *data;
@@ -3632,23 +4318,25 @@ namespace vitex
 						case bytecode::begin:
 						{
 							uint8_t op = index & 0x0f;
-							if (index & 0x70)
+							uint8_t reserved = index & 0x70;
+							if (reserved & 0x30)
 								return !queue.empty();
 
 							final = (index & 0x80) ? 1 : 0;
 							if (op == 0)
 							{
-								if (!fragment)
+								if (!fragment || reserved)
 									return !queue.empty();
 
 								control = 0;
+								opcode = web_socket_op::next;
 							}
 							else if (op & 0x8)
 							{
 								if (op != (uint8_t)web_socket_op::ping && op != (uint8_t)web_socket_op::pong && op != (uint8_t)web_socket_op::close)
 									return !queue.empty();
 
-								if (!final)
+								if (!final || reserved)
 									return !queue.empty();
 
 								control = 1;
@@ -3659,9 +4347,18 @@ namespace vitex
 								if (op != (uint8_t)web_socket_op::text && op != (uint8_t)web_socket_op::binary)
 									return !queue.empty();
 
+								if (fragment || (reserved && !compression.inflater))
+									return !queue.empty();
+
 								control = 0;
+								compressed = reserved ? 1 : 0;
 								fragment = !final;
 								opcode = (web_socket_op)op;
+								if (fragment)
+								{
+									fragment_opcode = opcode;
+									fragments.clear();
+								}
 							}
 
 							state = bytecode::length;
@@ -3693,11 +4390,8 @@ namespace vitex
 								state = bytecode::length640;
 
 							data++; size--;
-							if (state == bytecode::end && remains == 0)
-							{
-								queue.emplace(std::make_pair(opcode, core::vector<char>()));
-								goto fetch_payload;
-							}
+							if (state == bytecode::end)
+								begin_payload(data);
 							break;
 						}
 						case bytecode::length160:
@@ -3715,6 +4409,8 @@ namespace vitex
 								return !queue.empty();
 
 							data++; size--;
+							if (state == bytecode::end)
+								begin_payload(data);
 							break;
 						}
 						case bytecode::length640:
@@ -3774,6 +4470,8 @@ namespace vitex
 								return !queue.empty();
 
 							data++; size--;
+							if (state == bytecode::end)
+								begin_payload(data);
 							break;
 						}
 						case bytecode::mask0:
@@ -3802,58 +4500,84 @@ namespace vitex
 							mask[3] = index;
 							state = bytecode::end;
 							data++; size--;
-							if (remains == 0)
-							{
-								queue.emplace(std::make_pair(opcode, core::vector<char>()));
-								goto fetch_payload;
-							}
+							begin_payload(data);
 							break;
 						}
 						case bytecode::end:
 						{
-							size_t length = size;
-							if (length > (size_t)remains)
-								length = (size_t)remains;
+							size_t chunk = size;
+							if (chunk > (size_t)remains)
+								chunk = (size_t)remains;
 
 							if (masked)
 							{
-								for (size_t i = 0; i < length; i++)
-									data[i] ^= mask[masks++ % 4];
+								mask_payload(data, chunk, mask, masks);
+								masks = (uint8_t)((masks + chunk) & 3);
 							}
 
-							core::vector<char> message;
-							text_assign(message, std::string_view(data, length));
-							if (opcode == web_socket_op::next && !queue.empty())
-							{
-								auto& top = queue.front();
-								top.second.insert(top.second.end(), message.begin(), message.end());
-							}
-							else
-								queue.emplace(std::make_pair(opcode == web_socket_op::next ? web_socket_op::text : opcode, std::move(message)));
+							if (!control && fragment)
+								fragments.insert(fragments.end(), data, data + chunk);
 
-							opcode = web_socket_op::next;
-							data += length;
-							size -= length;
-							remains -= length;
+							data += chunk;
+							size -= chunk;
+							remains -= chunk;
 							if (remains == 0)
-								goto fetch_payload;
+								end_payload();
 							break;
 						}
 					}
 				}
 
 				return !queue.empty();
-			fetch_payload:
-				if (!control && !final)
-					return !queue.empty();
-
+			}
+			void web_codec::begin_payload(const char* next)
+			{
+				offset = (size_t)(next - payload.data());
+				length = (size_t)remains;
+				if (remains == 0)
+					end_payload();
+			}
+			void web_codec::end_payload()
+			{
 				state = bytecode::begin;
-				if (size > 0)
-					goto parse_payload;
+				if (control || !fragment)
+				{
+					message next;
+					next.opcode = opcode;
+					next.offset = offset;
+					next.size = length;
+					next.compressed = !control && compressed;
+					next.inlined = true;
+					queue.emplace(std::move(next));
+					++inlines;
+				}
+				else if (final)
+				{
+					message next;
+					next.opcode = fragment_opcode;
+					next.data = std::move(fragments);
+					next.size = next.data.size();
+					next.compressed = compressed;
+					queue.emplace(std::move(next));
+					fragments = core::vector<char>();
+					fragment = 0;
+				}
+			}
+			bool web_codec::get_frame(web_socket_op* op, core::vector<char>* message)
+			{
+				VI_ASSERT(message != nullptr, "message should be set");
+				std::string_view frame;
+				if (!get_frame(op, &frame))
+					return false;
+
+				if (frame.data() != data.data())
+					message->assign(frame.begin(), frame.end());
+				else if (message != &data)
+					*message = std::move(data);
 
 				return true;
 			}
-			bool web_codec::get_frame(web_socket_op* op, core::vector<char>* message)
+			bool web_codec::get_frame(web_socket_op* op, std::string_view* message)
 			{
 				VI_ASSERT(op != nullptr, "op should be set");
 				VI_ASSERT(message != nullptr, "message should be set");
@@ -3861,13 +4585,88 @@ namespace vitex
 				if (queue.empty())
 					return false;
 
-				auto& base = queue.front();
-				*message = std::move(base.second);
-				*op = base.first;
+				auto base = std::move(queue.front());
 				queue.pop();
+				if (base.inlined)
+					--inlines;
+
+				*op = base.opcode;
+				const char* buffer = base.inlined ? payload.data() + base.offset : base.data.data();
+				if (base.compressed)
+				{
+					if (!inflate(buffer, base.size, data))
+					{
+						*op = web_socket_op::close;
+						data.clear();
+					}
+					*message = std::string_view(data.data(), data.size());
+				}
+				else if (!base.inlined)
+				{
+					data = std::move(base.data);
+					*message = std::string_view(data.data(), data.size());
+				}
+				else
+					*message = std::string_view(buffer, base.size);
 
 				return true;
 			}
+			char* web_codec::get_receive_buffer(size_t size)
+			{
+				if (!inlines && filled > 0)
+				{
+					size_t keep = filled;
+					bool inlined = state == bytecode::end && (control || !fragment);
+					if (inlined)
+						keep = offset;
+
+					if (keep > 0)
+					{
+						memmove(payload.data(), payload.data() + keep, filled - keep);
+						filled -= keep;
+						if (inlined)
+							offset = 0;
+					}
+				}
+
+				if (payload.size() < filled + size)
+					payload.resize(filled + size);
+
+				return payload.data() + filled;
+			}
+			bool web_codec::is_deflate_enabled() const
+			{
+				return compression.deflater != nullptr;
+			}
+			bool web_codec::is_deflate_stateless() const
+			{
+				return compression.deflater != nullptr && compression.deflate_reset;
+			}
+			int web_codec::get_deflate_window_bits() const
+			{
+				return compression.window_bits;
+			}
+			void web_codec::mask_payload(char* buffer, size_t size, const uint8_t mask[4], uint8_t offset)
+			{
+				uint8_t rotation[8];
+				for (size_t i = 0; i < sizeof(rotation); i++)
+					rotation[i] = mask[(offset + i) & 3];
+
+				uint64_t word_mask;
+				memcpy(&word_mask, rotation, sizeof(word_mask));
+
+				size_t i = 0;
+				for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+				{
+					uint64_t word;
+					memcpy(&word, buffer + i, sizeof(word));
+					word ^= word_mask;
+					memcpy(buffer + i, &word, sizeof(word));
+				}
+
+				for (; i < size; i++)
+					buffer[i] ^= rotation[i & 7];
+			}
 
 			hrm_cache::hrm_cache() noexcept : hrm_cache(HTTP_HRM_SIZE)
 			{
@@ -4528,75 +5327,102 @@ namespace vitex
 				if (!length)
 					return true;
 
-				if (parser->multipart.skip || !parser->multipart.stream)
+				auto& state = parser->multipart;
+				if (state.skip || !state.open)
 					return false;
 
-				if (fwrite(data, 1, (size_t)length, parser->multipart.stream) != (size_t)length)
+				if (state.chunk_callback)
+				{
+					if (!state.chunk_callback(&state.data, std::string_view((char*)data, length)))
+						return false;
+
+					state.data.length += length;
+					return true;
+				}
+
+				if (state.data.is_in_memory)
+				{
+					if (state.data.length + length <= state.max_in_memory_size)
+					{
+						state.data.path.append((char*)data, length);
+						state.data.length += length;
+						return true;
+					}
+					else if (!multipart_spill(parser))
+						return false;
+				}
+
+				if (!state.stream || fwrite(data, 1, (size_t)length, state.stream) != (size_t)length)
 					return false;
 
-				parser->multipart.data.length += length;
+				state.data.length += length;
 				return true;
 			}
 			bool parsing::parse_multipart_resource_begin(parser* parser)
 			{
 				VI_ASSERT(parser != nullptr, "parser should be set");
-				if (parser->multipart.skip || !parser->message.content)
+				auto& state = parser->multipart;
+				if (state.skip || !parser->message.content)
 					return true;
 
-				if (parser->multipart.stream != nullptr)
+				if (state.open)
 				{
-					core::os::file::close(parser->multipart.stream);
-					parser->multipart.stream = nullptr;
+					if (state.stream != nullptr)
+					{
+						core::os::file::close(state.stream);
+						state.stream = nullptr;
+					}
+
+					state.open = false;
 					return false;
 				}
 
-				if (parser->message.content->resources.size() >= parser->multipart.max_resources)
+				if (state.resources >= state.max_resources)
 				{
-					parser->multipart.finish = true;
+					state.finish = true;
 					return false;
 				}
 
 				parser->message.header.clear();
-				parser->multipart.data.headers.clear();
-				parser->multipart.data.name.clear();
-				parser->multipart.data.type = "application/octet-stream";
-				parser->multipart.data.is_in_memory = false;
-				parser->multipart.data.length = 0;
-
-				if (parser->multipart.temporary_directory != nullptr)
-				{
-					parser->multipart.data.path = *parser->multipart.temporary_directory;
-					if (parser->multipart.data.path.back() != '/' && parser->multipart.data.path.back() != '\\')
-						parser->multipart.data.path.append(1, VI_SPLITTER);
-
-					auto random = compute::crypto::random_bytes(16);
-					if (random)
-					{
-						auto hash = compute::crypto::hash_hex(compute::digests::md5(), *random);
-						if (hash)
-							parser->multipart.data.path.append(*hash);
-					}
-				}
-
-				auto file = core::os::file::open(parser->multipart.data.path.c_str(), "wb");
-				if (!file)
-					return false;
+				state.data.headers.clear();
+				state.data.path.clear();
+				state.data.name.clear();
+				state.data.key.clear();
+				state.data.type = "application/octet-stream";
+				state.data.is_in_memory = true;
+				state.data.length = 0;
+				state.open = true;
+				++state.resources;
+
+				if (state.chunk_callback || state.max_in_memory_size > 0)
+					return true;
 
-				parser->multipart.stream = *file;
-				return true;
+				return multipart_spill(parser);
 			}
 			bool parsing::parse_multipart_resource_end(parser* parser)
 			{
 				VI_ASSERT(parser != nullptr, "parser should be set");
-				if (parser->multipart.skip || !parser->multipart.stream || !parser->message.content)
+				auto& state = parser->multipart;
+				if (state.skip || !state.open || !parser->message.content)
 					return true;
 
-				core::os::file::close(parser->multipart.stream);
-				parser->multipart.stream = nullptr;
-				parser->message.content->resources.push_back(parser->multipart.data);
+				state.open = false;
+				if (state.stream != nullptr)
+				{
+					core::os::file::close(state.stream);
+					state.stream = nullptr;
+				}
+
+				if (state.chunk_callback)
+				{
+					if (state.callback)
+						state.callback(&state.data);
+					return true;
+				}
 
-				if (parser->multipart.callback)
-					parser->multipart.callback(&parser->message.content->resources.back());
+				parser->message.content->resources.push_back(state.data);
+				if (state.callback)
+					state.callback(&parser->message.content->resources.back());
 
 				return true;
 			}
@@ -5816,6 +6642,52 @@ namespace vitex
 				if (base->response.status_code <= 0)
 					base->response.status_code = 101;
 
+				int deflate_window_bits = 15;
+				bool deflate_server_no_context_takeover = false;
+				bool deflate_client_no_context_takeover = false;
+				bool deflate = false;
+#ifdef VI_ZLIB
+				auto extensions = base->request.get_header("Sec-WebSocket-Extensions");
+				if (base->route->web_socket_compression.enabled && !extensions.empty())
+				{
+					for (auto& offer : core::stringify::split(extensions, ','))
+					{
+						auto params = core::stringify::split(offer, ';');
+						for (auto& param : params)
+							core::stringify::to_lower(core::stringify::trim(param));
+
+						if (params.empty() || params.front() != "permessage-deflate")
+							continue;
+
+						deflate = true;
+						deflate_window_bits = 15;
+						deflate_server_no_context_takeover = base->route->web_socket_compression.server_no_context_takeover;
+						deflate_client_no_context_takeover = base->route->web_socket_compression.client_no_context_takeover;
+						for (size_t i = 1; i < params.size() && deflate; i++)
+						{
+							auto& param = params[i];
+							if (param == "server_no_context_takeover")
+								deflate_server_no_context_takeover = true;
+							else if (param == "client_no_context_takeover")
+								deflate_client_no_context_takeover = true;
+							else if (core::stringify::starts_with(param, "server_max_window_bits="))
+							{
+								auto bits = core::from_string<int>(std::string_view(param).substr(23));
+								if (bits && *bits >= 9 && *bits <= 15)
+									deflate_window_bits = *bits;
+								else
+									deflate = false;
+							}
+							else if (param != "client_max_window_bits" && !core::stringify::starts_with(param, "client_max_window_bits="))
+								deflate = false;
+						}
+
+						if (deflate)
+							break;
+					}
+				}
+#endif
+
 				auto* content = hrm_cache::get()->pop();
 				content->append(
 					"HTTP/1.1 101 Switching Protocols\r\n"
@@ -5835,16 +6707,34 @@ namespace vitex
 						content->append("Sec-WebSocket-protocol: ").append(protocol).append("\r\n");
 				}
 
+				if (deflate)
+				{
+					content->append("Sec-WebSocket-Extensions: permessage-deflate");
+					if (deflate_server_no_context_takeover)
+						content->append("; server_no_context_takeover");
+					if (deflate_client_no_context_takeover)
+						content->append("; client_no_context_takeover");
+					if (deflate_window_bits != 15)
+						content->append("; server_max_window_bits=").append(core::to_string(deflate_window_bits));
+					content->append("\r\n");
+				}
+
 				if (base->route->callbacks.headers)
 					base->route->callbacks.headers(base, *content);
 
 				content->append("\r\n", 2);
-				return !!base->stream->write_queued((uint8_t*)content->c_str(), content->size(), [content, base](socket_poll event)
+				return !!base->stream->write_queued((uint8_t*)content->c_str(), content->size(), [content, base, deflate, deflate_window_bits, deflate_server_no_context_takeover, deflate_client_no_context_takeover](socket_poll event)
 				{
 					hrm_cache::get()->push(content);
 					if (packet::is_done(event))
 					{
 						base->web_socket = new web_socket_frame(base->stream, base);
+						if (deflate)
+						{
+							auto& compression = base->route->web_socket_compression;
+							base->web_socket->codec->enable_deflate(compression.min_length, compression.max_inflated_length, deflate_window_bits, compression.quality_level, compression.memory_level, deflate_client_no_context_takeover, deflate_server_no_context_takeover);
+						}
+
 						base->web_socket->connect = base->route->callbacks.web_socket.connect;
 						base->web_socket->receive = base->route->callbacks.web_socket.receive;
 						base->web_socket->disconnect = base->route->callbacks.web_socket.disconnect;
@@ -5876,6 +6766,11 @@ namespace vitex
 			server::~server()
 			{
 				unlisten(false);
+				for (auto& member : broadcasting.members)
+				{
+					for (size_t i = 0; i < member.second.size(); i++)
+						member.first->release();
+				}
 			}
 			core::expects_system<void> server::update()
 			{
@@ -5902,6 +6797,27 @@ namespace vitex
 						return core::system_exception("temporary directory: invalid path", std::move(status.error()));
 				}
 
+				if (!target->sessions)
+				{
+					session_store* next = nullptr;
+					if (!target->session.directory.empty())
+						next = new file_session_store(target->session.directory);
+					target->sessions = new memory_session_store(next, target->session.max_entries);
+				}
+
+				if (session_sweeper == core::INVALID_TASK_ID && target->session.sweep_interval > 0 && core::schedule::is_available())
+				{
+					session_sweeper = core::schedule::get()->set_interval(target->session.sweep_interval, [target]()
+					{
+						size_t count = target->sessions->sweep(time(nullptr));
+						if (count > 0)
+							VI_DEBUG("http sessions swept: %" PRIu64 " expired", (uint64_t)count);
+					});
+				}
+
+				if (session_flusher == core::INVALID_TASK_ID && target->session.flush_interval > 0 && core::schedule::is_available())
+					session_flusher = core::schedule::get()->set_interval(target->session.flush_interval, [target]() { target->sessions->flush(); });
+
 				auto status = update_route(target->base);
 				if (!status)
 					return status;
@@ -5919,6 +6835,142 @@ namespace vitex
 				target->sort();
 				return core::expectation::met;
 			}
+			bool server::subscribe(const std::string_view& group, web_socket_frame* frame)
+			{
+				VI_ASSERT(frame != nullptr, "frame should be set");
+				core::umutex<std::mutex> unique(broadcasting.section);
+				auto& members = broadcasting.groups[core::string(group)];
+				if (!members.insert(frame).second)
+					return false;
+
+				broadcasting.members[frame].insert(core::string(group));
+				frame->add_ref();
+				return true;
+			}
+			bool server::unsubscribe(const std::string_view& group, web_socket_frame* frame)
+			{
+				VI_ASSERT(frame != nullptr, "frame should be set");
+				core::umutex<std::mutex> unique(broadcasting.section);
+				auto it = broadcasting.groups.find(core::key_lookup_cast(group));
+				if (it == broadcasting.groups.end() || !it->second.erase(frame))
+					return false;
+
+				if (it->second.empty())
+					broadcasting.groups.erase(it);
+
+				auto member = broadcasting.members.find(frame);
+				if (member != broadcasting.members.end())
+				{
+					auto name = member->second.find(core::key_lookup_cast(group));
+					if (name != member->second.end())
+						member->second.erase(name);
+					if (member->second.empty())
+						broadcasting.members.erase(member);
+				}
+
+				unique.negate();
+				core::memory::release(frame);
+				return true;
+			}
+			size_t server::unsubscribe(web_socket_frame* frame)
+			{
+				VI_ASSERT(frame != nullptr, "frame should be set");
+				core::umutex<std::mutex> unique(broadcasting.section);
+				auto member = broadcasting.members.find(frame);
+				if (member == broadcasting.members.end())
+					return 0;
+
+				size_t count = 0;
+				for (auto& group : member->second)
+				{
+					auto it = broadcasting.groups.find(group);
+					if (it == broadcasting.groups.end() || !it->second.erase(frame))
+						continue;
+
+					if (it->second.empty())
+						broadcasting.groups.erase(it);
+					++count;
+				}
+
+				broadcasting.members.erase(member);
+				unique.negate();
+				for (size_t i = 0; i < count; i++)
+					frame->release();
+
+				return count;
+			}
+			size_t server::broadcast(const std::string_view& group, const std::string_view& buffer, web_socket_op opcode)
+			{
+				core::vector<web_socket_frame*> targets;
+				core::umutex<std::mutex> unique(broadcasting.section);
+				auto it = broadcasting.groups.find(core::key_lookup_cast(group));
+				if (it == broadcasting.groups.end())
+					return 0;
+
+				targets.reserve(it->second.size());
+				for (auto* frame : it->second)
+				{
+					frame->add_ref();
+					targets.push_back(frame);
+				}
+
+				broadcast_policy policy = broadcasting.policy;
+				size_t max_backlog = broadcasting.max_backlog;
+				unique.negate();
+
+				size_t delivered = 0, dropped = 0;
+				core::vector<web_socket_frame*> slow;
+				web_socket_packet* packet = new web_socket_packet(buffer, opcode);
+				for (auto* frame : targets)
+				{
+					if (frame->is_finished() || frame->is_ignore())
+						++dropped;
+					else if (max_backlog > 0 && frame->get_backlog() + packet->size() > max_backlog)
+					{
+						++dropped;
+						if (policy == broadcast_policy::close)
+							slow.push_back(frame);
+					}
+					else if (frame->send(packet, nullptr))
+						++delivered;
+					else
+						++dropped;
+				}
+				core::memory::release(packet);
+
+				for (auto* frame : slow)
+				{
+					VI_DEBUG("websocket sock %i closed by broadcast: %" PRIu64 " bytes of backlog", (int)frame->get_stream()->get_fd(), (uint64_t)frame->get_backlog());
+					unsubscribe(frame);
+					frame->send_close(nullptr);
+				}
+
+				for (auto* frame : targets)
+					frame->release();
+
+				unique.negate();
+				broadcasting.stats.broadcasts++;
+				broadcasting.stats.delivered += delivered;
+				broadcasting.stats.dropped += dropped;
+				broadcasting.stats.closed += slow.size();
+				return delivered;
+			}
+			void server::set_broadcast_policy(broadcast_policy policy, size_t max_backlog)
+			{
+				core::umutex<std::mutex> unique(broadcasting.section);
+				broadcasting.policy = policy;
+				broadcasting.max_backlog = max_backlog;
+			}
+			server::broadcast_stats server::get_broadcast_stats()
+			{
+				core::umutex<std::mutex> unique(broadcasting.section);
+				broadcast_stats stats = broadcasting.stats;
+				stats.groups = broadcasting.groups.size();
+				stats.subscriptions = 0;
+				for (auto& group : broadcasting.groups)
+					stats.subscriptions += group.second.size();
+				return stats;
+			}
 			core::expects_system<void> server::update_route(router_entry* route)
 			{
 				route->router = (map_router*)router;
@@ -5947,6 +6999,13 @@ namespace vitex
 			{
 				VI_ASSERT(router != nullptr, "router should be set");
 				map_router* target = (map_router*)router;
+				for (auto* timer : { &session_sweeper, &session_flusher })
+				{
+					if (*timer != core::INVALID_TASK_ID && core::schedule::is_available())
+						core::schedule::get()->clear_timeout(*timer);
+					*timer = core::INVALID_TASK_ID;
+				}
+
 				if (!target->temporary_directory.empty())
 				{
 					auto status = core::os::directory::remove(target->temporary_directory.c_str());
@@ -5954,9 +7013,9 @@ namespace vitex
 						return core::system_exception("temporary directory remove error: " + target->temporary_directory, std::move(status.error()));
 				}
 
-				if (!target->session.directory.empty())
+				if (target->sessions != nullptr)
 				{
-					auto status = session::invalidate_cache(target->session.directory);
+					auto status = target->sessions->clear();
 					if (!status)
 						return status;
 				}
@@ -6828,6 +7887,348 @@ namespace vitex
 					report(core::system_exception(core::stringify::text("http chunk parse error: %.*s ...", (int)std::min<size_t>(64, response.content.data.size()), response.content.data.data()), std::make_error_condition(std::errc::bad_message)));
 			}
 
+			client_pool::client_pool() noexcept : client_pool(8, 30000)
+			{
+			}
+			client_pool::client_pool(size_t max_connections_per_origin, uint64_t max_idle_time_ms) noexcept : next_cleanup(0), cleanup_timer(core::INVALID_TASK_ID), max_connections(std::max<size_t>(1, max_connections_per_origin)), max_idle_time(max_idle_time_ms)
+			{
+				hrm_cache::link_instance();
+			}
+			client_pool::~client_pool() noexcept
+			{
+				core::single_queue<waiting_request> queue;
+				core::vector<client*> clients;
+				core::umutex<std::mutex> unique(exclusive);
+				if (cleanup_timer != core::INVALID_TASK_ID && core::schedule::is_available())
+					core::schedule::get()->clear_timeout(cleanup_timer);
+				cleanup_timer = core::INVALID_TASK_ID;
+
+				for (auto& item : origins)
+				{
+					while (!item.second.requests.empty())
+					{
+						queue.push(std::move(item.second.requests.front()));
+						item.second.requests.pop();
+					}
+
+					for (auto& next : item.second.clients)
+						clients.push_back(next.base);
+				}
+
+				origins.clear();
+				unique.negate();
+
+				for (auto* next : clients)
+					core::memory::release(next);
+
+				while (!queue.empty())
+				{
+					queue.front().callback(core::system_exception("client pool is shutting down", std::make_error_condition(std::errc::operation_canceled)), false);
+					queue.pop();
+				}
+			}
+			void client_pool::set_max_connections(size_t max_connections_per_origin)
+			{
+				max_connections = std::max<size_t>(1, max_connections_per_origin);
+			}
+			void client_pool::set_max_idle_time(uint64_t max_idle_time_ms)
+			{
+				max_idle_time = max_idle_time_ms;
+			}
+			void client_pool::cleanup()
+			{
+				core::single_queue<waiting_request> expired;
+				core::vector<client*> outdated;
+				core::umutex<std::mutex> unique(exclusive);
+				expire(expired, outdated, core::schedule::get_clock());
+				unique.negate();
+
+				for (auto* next : outdated)
+					core::memory::release(next);
+
+				while (!expired.empty())
+				{
+					expired.front().callback(core::system_exception("client pool queue timeout", std::make_error_condition(std::errc::timed_out)), false);
+					expired.pop();
+				}
+			}
+			core::expects_promise_system<response_frame> client_pool::fetch(const std::string_view& hostname, const std::string_view& service, int32_t verify_peers, request_frame&& request, size_t max_size, uint64_t timeout)
+			{
+				core::expects_promise_system<response_frame> result;
+				send(core::string(hostname), core::string(service), verify_peers, std::move(request), max_size, timeout, result, true);
+				return result;
+			}
+			client_pool::pool_stats client_pool::get_stats()
+			{
+				core::umutex<std::mutex> unique(exclusive);
+				pool_stats result = stats;
+				result.in_flight = result.queued = result.idle = 0;
+				for (auto& item : origins)
+				{
+					result.in_flight += item.second.active;
+					result.queued += item.second.requests.size();
+					result.idle += item.second.clients.size();
+				}
+				return result;
+			}
+			size_t client_pool::get_max_connections() const
+			{
+				return max_connections;
+			}
+			uint64_t client_pool::get_max_idle_time() const
+			{
+				return max_idle_time;
+			}
+			void client_pool::send(core::string&& hostname, core::string&& service, int32_t verify_peers, request_frame&& request, size_t max_size, uint64_t timeout, core::expects_promise_system<response_frame> result, bool retriable)
+			{
+				core::string name = hostname;
+				name.append(1, ':').append(service).append(1, '/').append(core::to_string(verify_peers));
+				acquire(name, hostname, service, verify_peers, timeout, [this, name, hostname = std::move(hostname), service = std::move(service), verify_peers, request = std::move(request), max_size, timeout, result, retriable](core::expects_system<client*>&& base, bool reused) mutable
+				{
+					if (!base)
+						return result.set(base.error());
+
+					client* target = *base;
+					if (target->get_stream() != nullptr)
+						target->get_stream()->set_io_timeout(timeout);
+
+					bool retry = retriable && reused && is_idempotent(request);
+					request_frame copy = (retry ? request : request_frame());
+					target->send_fetch(std::move(request), max_size).when([this, name = std::move(name), hostname = std::move(hostname), service = std::move(service), verify_peers, copy = std::move(copy), max_size, timeout, result, target, retry](core::expects_system<void>&& status) mutable
+					{
+						if (!status)
+						{
+							recycle(name, target, false);
+							if (!retry)
+								return result.set(status.error());
+
+							VI_DEBUG("http pool retry %s %s on a new connection", copy.method, copy.location.c_str());
+							core::umutex<std::mutex> unique(exclusive);
+							++stats.retried;
+							unique.negate();
+							return send(std::move(hostname), std::move(service), verify_peers, std::move(copy), max_size, timeout, std::move(result), false);
+						}
+
+						bool reusable = is_reusable(target, status);
+						auto response = std::move(*target->get_response());
+						recycle(name, target, reusable);
+						result.set(std::move(response));
+					});
+				});
+			}
+			void client_pool::acquire(const core::string& name, const std::string_view& hostname, const std::string_view& service, int32_t verify_peers, uint64_t timeout, acquire_callback&& callback)
+			{
+				core::single_queue<waiting_request> expired;
+				core::vector<client*> outdated;
+				auto time = core::schedule::get_clock();
+				core::umutex<std::mutex> unique(exclusive);
+				expire(expired, outdated, time);
+
+				auto& origin = origins[name];
+				if (origin.hostname.empty())
+				{
+					origin.hostname = hostname;
+					origin.service = service;
+					origin.verify_peers = verify_peers;
+				}
+
+				client* target = nullptr;
+				bool create_new = false;
+				while (!origin.clients.empty())
+				{
+					auto next = origin.clients.back();
+					origin.clients.pop_back();
+					if (next.base->has_stream())
+					{
+						target = next.base;
+						break;
+					}
+
+					outdated.push_back(next.base);
+					++stats.expired;
+				}
+
+				if (target != nullptr)
+				{
+					++origin.active;
+					++stats.reused;
+				}
+				else if (origin.active < max_connections)
+				{
+					++origin.active;
+					++stats.created;
+					create_new = true;
+				}
+				else
+				{
+					waiting_request next;
+					next.callback = std::move(callback);
+					next.deadline = (timeout > 0 ? time + std::chrono::milliseconds(timeout) : std::chrono::microseconds::max());
+					next.timeout = timeout;
+					origin.requests.emplace(std::move(next));
+				}
+				schedule_cleanup();
+				unique.negate();
+
+				for (auto* next : outdated)
+					core::memory::release(next);
+
+				while (!expired.empty())
+				{
+					expired.front().callback(core::system_exception("client pool queue timeout", std::make_error_condition(std::errc::timed_out)), false);
+					expired.pop();
+				}
+
+				if (target != nullptr)
+					callback(target, true);
+				else if (create_new)
+					create(name, timeout, std::move(callback));
+			}
+			void client_pool::recycle(const core::string& name, client* base, bool reusable)
+			{
+				core::umutex<std::mutex> unique(exclusive);
+				auto it = origins.find(name);
+				if (it == origins.end())
+				{
+					unique.negate();
+					core::memory::release(base);
+					return;
+				}
+
+				auto& origin = it->second;
+				if (!origin.requests.empty())
+				{
+					auto next = std::move(origin.requests.front());
+					origin.requests.pop();
+					if (reusable)
+					{
+						++stats.reused;
+						unique.negate();
+						core::codefer([callback = std::move(next.callback), base]() mutable { callback(base, true); });
+						return;
+					}
+
+					++stats.created;
+					unique.negate();
+					core::memory::release(base);
+					return create(name, next.timeout, std::move(next.callback));
+				}
+
+				--origin.active;
+				if (!reusable || !max_idle_time)
+				{
+					if (!origin.active && origin.clients.empty())
+						origins.erase(it);
+					unique.negate();
+					core::memory::release(base);
+					return;
+				}
+
+				idle_client next;
+				next.base = base;
+				next.expires = core::schedule::get_clock() + std::chrono::milliseconds(max_idle_time);
+				origin.clients.push_back(next);
+			}
+			void client_pool::create(const core::string& name, uint64_t timeout, acquire_callback&& callback)
+			{
+				core::umutex<std::mutex> unique(exclusive);
+				auto& origin = origins[name];
+				core::string hostname = origin.hostname, service = origin.service;
+				int32_t verify_peers = origin.verify_peers;
+				unique.negate();
+
+				dns::get()->lookup_deferred(hostname, service, dns_type::connect, socket_protocol::TCP, socket_type::stream).when([this, name, verify_peers, timeout, callback = std::move(callback)](core::expects_system<socket_address>&& address) mutable
+				{
+					if (!address)
+					{
+						recycle(name, nullptr, false);
+						return callback(address.error(), false);
+					}
+
+					http::client* target = new http::client((int64_t)timeout);
+					target->connect_async(*address, verify_peers).when([this, name, target, callback = std::move(callback)](core::expects_system<void>&& status) mutable
+					{
+						if (status)
+							return callback(target, false);
+
+						recycle(name, target, false);
+						callback(status.error(), false);
+					});
+				});
+			}
+			void client_pool::expire(core::single_queue<waiting_request>& expired, core::vector<client*>& outdated, const std::chrono::microseconds& time)
+			{
+				if (next_cleanup > time)
+					return;
+
+				next_cleanup = time + std::chrono::milliseconds(HTTP_POOL_CLEANUP_INTERVAL);
+				for (auto it = origins.begin(); it != origins.end();)
+				{
+					auto& origin = it->second;
+					for (auto next = origin.clients.begin(); next != origin.clients.end();)
+					{
+						if (next->expires > time && next->base->has_stream())
+						{
+							++next;
+							continue;
+						}
+
+						outdated.push_back(next->base);
+						next = origin.clients.erase(next);
+						++stats.expired;
+					}
+
+					size_t count = origin.requests.size();
+					for (size_t i = 0; i < count; i++)
+					{
+						auto next = std::move(origin.requests.front());
+						origin.requests.pop();
+						if (next.deadline > time)
+						{
+							origin.requests.emplace(std::move(next));
+							continue;
+						}
+
+						expired.emplace(std::move(next));
+						++stats.timeouts;
+					}
+
+					if (!origin.active && origin.clients.empty() && origin.requests.empty())
+						it = origins.erase(it);
+					else
+						++it;
+				}
+			}
+			void client_pool::schedule_cleanup()
+			{
+				if (cleanup_timer != core::INVALID_TASK_ID || !core::schedule::is_available())
+					return;
+
+				cleanup_timer = core::schedule::get()->set_interval(HTTP_POOL_CLEANUP_INTERVAL, [this]() { cleanup(); });
+			}
+			bool client_pool::is_reusable(client* base, const core::expects_system<void>& status)
+			{
+				if (!status || !base->has_stream())
+					return false;
+
+				auto* response = base->get_response();
+				if (!response->content.is_finalized() || response->content.exceeds)
+					return false;
+
+				auto connection = response->get_header("Connection");
+				return !core::stringify::case_equals(connection, "close");
+			}
+			bool client_pool::is_idempotent(const request_frame& request)
+			{
+				static const char* methods[] = { "GET", "HEAD", "OPTIONS", "PUT", "DELETE", "TRACE" };
+				for (auto* method : methods)
+				{
+					if (!strcmp(request.method, method))
+						return true;
+				}
+				return false;
+			}
+
 			core::expects_promise_system<response_frame> fetch(const std::string_view& location, const std::string_view& method, const fetch_frame& options)
 			{
 				network::location origin(location);
@@ -6848,40 +8249,10 @@ namespace vitex
 				if (!request.query.empty())
 					request.query.pop_back();
 
-				size_t max_size = options.max_size;
-				uint64_t timeout = options.timeout;
 				bool secure = origin.protocol == "https";
-				core::string hostname = origin.hostname;
 				core::string port = origin.port > 0 ? core::to_string(origin.port) : core::string(secure ? "443" : "80");
 				int32_t verify_peers = (secure ? (options.verify_peers >= 0 ? options.verify_peers : PEER_NOT_VERIFIED) : PEER_NOT_SECURE);
-				return dns::get()->lookup_deferred(hostname, port, dns_type::connect, socket_protocol::TCP, socket_type::stream).then<core::expects_promise_system<response_frame>>([max_size, timeout, verify_peers, request = std::move(request), origin = std::move(origin)](core::expects_system<socket_address>&& address) mutable -> core::expects_promise_system<response_frame>
-				{
-					if (!address)
-						return core::expects_promise_system<response_frame>(address.error());
-
-					http::client* client = new http::client(timeout);
-					return client->connect_async(*address, verify_peers).then<core::expects_promise_system<void>>([client, max_size, request = std::move(request)](core::expects_system<void>&& status) mutable -> core::expects_promise_system<void>
-					{
-						if (!status)
-							return core::expects_promise_system<void>(status);
-
-						return client->send_fetch(std::move(request), max_size);
-					}).then<core::expects_promise_system<response_frame>>([client](core::expects_system<void>&& status) -> core::expects_promise_system<response_frame>
-					{
-						if (!status)
-						{
-							client->release();
-							return core::expects_promise_system<response_frame>(status.error());
-						}
-
-						auto response = std::move(*client->get_response());
-						return client->disconnect().then<core::expects_system<response_frame>>([client, response = std::move(response)](core::expects_system<void>&&) mutable -> core::expects_system<response_frame>
-						{
-							client->release();
-							return std::move(response);
-						});
-					});
-				});
+				return client_pool::get()->fetch(origin.hostname, port, verify_peers, std::move(request), options.max_size, options.timeout);
 			}
 		}
 	}
@@ -40,6 +40,12 @@ namespace vitex
 				close
 			};
 
+			enum class broadcast_policy
+			{
+				drop,
+				close
+			};
+
 			enum class compression_tune
 			{
 				filtered = 1,
@@ -142,6 +148,7 @@ namespace vitex
 			typedef std::function<bool(class connection*, struct credentials*)> authorize_callback;
 			typedef std::function<bool(class connection*, core::string&)> header_callback;
 			typedef std::function<bool(struct resource*)> resource_callback;
+			typedef std::function<bool(struct resource*, const std::string_view&)> resource_chunk_callback;
 			typedef std::function<void(class web_socket_frame*)> web_socket_callback;
 			typedef std::function<bool(class web_socket_frame*, web_socket_op, const std::string_view&)> web_socket_read_callback;
 			typedef std::function<void(class web_socket_frame*, bool)> web_socket_status_callback;
@@ -163,6 +170,8 @@ namespace vitex
 
 			class web_codec;
 
+			class session_store;
+
 			struct error_file
 			{
 				core::string pattern;
@@ -339,9 +348,31 @@ namespace vitex
 				std::pair<size_t, size_t> get_range(core::vector<std::pair<size_t, size_t>>::iterator range, size_t content_length) const;
 			};
 
+			class web_socket_packet final : public core::reference<web_socket_packet>
+			{
+			private:
+				std::mutex section;
+				core::string deflated[7];
+				uint8_t variants[7];
+				core::string plain;
+				core::string payload;
+				web_socket_op opcode;
+
+			public:
+				web_socket_packet(const std::string_view& buffer, web_socket_op new_opcode) noexcept;
+				const core::string& get_frame(web_codec* codec);
+				web_socket_op get_opcode() const;
+				size_t size() const;
+
+			public:
+				static size_t encode_header(uint8_t header[14], web_socket_op opcode, size_t size, uint32_t mask, bool deflated);
+			};
+
 			class web_socket_frame final : public core::reference<web_socket_frame>
 			{
 				friend class connection;
+				friend class logical;
+				friend class server;
 
 			private:
 				enum class tunnel
@@ -359,6 +390,7 @@ namespace vitex
 					size_t size;
 					web_socket_op opcode;
 					web_socket_callback callback;
+					web_socket_packet* packet = nullptr;
 				};
 
 			public:
@@ -379,6 +411,7 @@ namespace vitex
 				std::atomic<bool> active;
 				std::atomic<bool> deadly;
 				std::atomic<bool> busy;
+				std::atomic<size_t> backlog;
 
 			public:
 				web_socket_callback connect;
@@ -392,8 +425,10 @@ namespace vitex
 				~web_socket_frame() noexcept;
 				core::expects_system<size_t> send(const std::string_view& buffer, web_socket_op op_code, web_socket_callback&& callback);
 				core::expects_system<size_t> send(uint32_t mask, const std::string_view& buffer, web_socket_op op_code, web_socket_callback&& callback);
+				core::expects_system<size_t> send(web_socket_packet* packet, web_socket_callback&& callback);
 				core::expects_system<void> send_close(web_socket_callback&& callback);
 				void next();
+				size_t get_backlog() const;
 				bool is_finished();
 				socket* get_stream();
 				connection* get_connection();
@@ -404,6 +439,8 @@ namespace vitex
 				void finalize();
 				void dequeue();
 				bool enqueue(uint32_t mask, const std::string_view& buffer, web_socket_op op_code, web_socket_callback&& callback);
+				bool enqueue(web_socket_packet* packet, web_socket_callback&& callback);
+				void complete(socket_poll event, web_socket_callback&& callback);
 				bool is_writeable();
 				bool is_ignore();
 			};
@@ -463,6 +500,17 @@ namespace vitex
 					bool enabled = false;
 				} compression;
 
+				struct entry_web_socket_compression
+				{
+					size_t max_inflated_length = 16777216;
+					size_t min_length = 256;
+					int quality_level = 6;
+					int memory_level = 8;
+					bool server_no_context_takeover = false;
+					bool client_no_context_takeover = false;
+					bool enabled = false;
+				} web_socket_compression;
+
 			public:
 				compute::regex_source location;
 				core::string files_directory;
@@ -507,6 +555,9 @@ namespace vitex
 
 					core::string directory;
 					uint64_t expires = 604800;
+					uint64_t sweep_interval = 60000;
+					uint64_t flush_interval = 1000;
+					size_t max_entries = 65536;
 				} session;
 
 				struct router_callbacks
@@ -519,6 +570,8 @@ namespace vitex
 				core::string temporary_directory = "./temp";
 				core::vector<router_group*> groups;
 				size_t max_uploadable_resources = 10;
+				size_t max_in_memory_resource_size = 0;
+				session_store* sessions = nullptr;
 				router_entry* base = nullptr;
 
 			public:
@@ -578,11 +631,13 @@ namespace vitex
 				bool send_chunk(const std::string_view& chunk, headers_callback&& callback);
 				bool fetch(content_callback&& callback = nullptr, bool eat = false);
 				bool store(resource_callback&& callback = nullptr, bool eat = false);
+				bool pipe(resource_chunk_callback&& chunk_callback, resource_callback&& callback = nullptr);
 				bool skip(success_callback&& callback);
 				core::expects_io<core::string> get_peer_ip_address() const;
 				bool is_skip_required() const;
 
 			private:
+				bool consume(resource_callback&& callback, resource_chunk_callback&& chunk_callback, bool eat);
 				bool compose_response(bool apply_error_response, bool apply_body_inline, headers_callback&& callback);
 				bool error_response_requested();
 				bool body_inlining_requested();
@@ -626,6 +681,93 @@ namespace vitex
 				static core::schema* find_parameter(core::schema* base, query_token* name);
 			};
 
+			class session_store : public core::reference<session_store>
+			{
+			public:
+				session_store() = default;
+				virtual ~session_store() = default;
+				virtual core::expects_system<void> store(const std::string_view& session_id, core::string&& data, int64_t expires) = 0;
+				virtual core::expects_system<int64_t> load(const std::string_view& session_id, core::string* data) = 0;
+				virtual core::expects_system<void> remove(const std::string_view& session_id) = 0;
+				virtual core::expects_system<void> flush() = 0;
+				virtual core::expects_system<void> clear() = 0;
+				virtual size_t sweep(int64_t time) = 0;
+			};
+
+			class memory_session_store final : public session_store
+			{
+			private:
+				struct entry
+				{
+					core::string session_id;
+					core::string data;
+					int64_t expires = 0;
+				};
+
+				struct shard
+				{
+					core::linked_list<entry> order;
+					core::unordered_map<core::string, core::linked_list<entry>::iterator> index;
+					std::mutex section;
+				};
+
+			private:
+				core::vector<shard*> shards;
+				session_store* next;
+				size_t max_entries;
+
+			public:
+				memory_session_store(session_store* new_next = nullptr, size_t new_max_entries = 65536, size_t new_shards_count = 16);
+				~memory_session_store() noexcept override;
+				core::expects_system<void> store(const std::string_view& session_id, core::string&& data, int64_t expires) override;
+				core::expects_system<int64_t> load(const std::string_view& session_id, core::string* data) override;
+				core::expects_system<void> remove(const std::string_view& session_id) override;
+				core::expects_system<void> flush() override;
+				core::expects_system<void> clear() override;
+				size_t sweep(int64_t time) override;
+				size_t size();
+
+			private:
+				shard& get_shard(const std::string_view& session_id);
+				void insert(shard& target, const std::string_view& session_id, core::string&& data, int64_t expires);
+			};
+
+			class file_session_store final : public session_store
+			{
+			private:
+				struct pending_write
+				{
+					core::string data;
+					int64_t expires = 0;
+					bool removal = false;
+				};
+
+			private:
+				core::unordered_map<core::string, pending_write> pending;
+				core::unordered_map<core::string, pending_write> writing;
+				core::string directory;
+				std::mutex flushing;
+				std::mutex section;
+				std::atomic<bool> scheduled;
+				size_t max_pending;
+
+			public:
+				file_session_store(const std::string_view& new_directory, size_t new_max_pending = 256);
+				~file_session_store() noexcept override;
+				core::expects_system<void> store(const std::string_view& session_id, core::string&& data, int64_t expires) override;
+				core::expects_system<int64_t> load(const std::string_view& session_id, core::string* data) override;
+				core::expects_system<void> remove(const std::string_view& session_id) override;
+				core::expects_system<void> flush() override;
+				core::expects_system<void> clear() override;
+				size_t sweep(int64_t time) override;
+
+			private:
+				void enqueue(const std::string_view& session_id, pending_write&& next);
+
+			public:
+				static bool is_session_id_valid(const std::string_view& session_id);
+			};
+
 			class session final : public core::reference<session>
 			{
 			public:
@@ -708,6 +850,7 @@ namespace vitex
 				{
 					resource data;
 					resource_callback callback;
+					resource_chunk_callback chunk_callback;
 					core::string* temporary_directory = nullptr;
 					FILE* stream = nullptr;
 					uint8_t* look_behind = nullptr;
@@ -715,8 +858,11 @@ namespace vitex
 					int64_t index = 0;
 					int64_t length = 0;
 					size_t max_resources = 0;
+					size_t max_in_memory_size = 0;
+					size_t resources = 0;
 					bool skip = false;
 					bool finish = false;
+					bool open = false;
 					multipart_status state = multipart_status::start;
 				} multipart;
 
@@ -726,7 +872,7 @@ namespace vitex
 				void prepare_for_request_parsing(request_frame* request);
 				void prepare_for_response_parsing(response_frame* response);
 				void prepare_for_chunked_parsing();
-				void prepare_for_multipart_parsing(content_frame* content, core::string* temporary_directory, size_t max_resources, bool skip, resource_callback&& callback);
+				void prepare_for_multipart_parsing(content_frame* content, core::string* temporary_directory, size_t max_resources, size_t max_in_memory_size, bool skip, resource_callback&& callback, resource_chunk_callback&& chunk_callback = nullptr);
 				int64_t multipart_parse(const std::string_view& boundary, const uint8_t* buffer, size_t length);
 				int64_t parse_request(const uint8_t* buffer_start, size_t length, size_t length_last_time);
 				int64_t parse_response(const uint8_t* buffer_start, size_t length, size_t length_last_time);
@@ -744,7 +890,17 @@ namespace vitex
 			class web_codec final : public core::reference<web_codec>
 			{
 			public:
-				typedef core::single_queue<std::pair<web_socket_op, core::vector<char>>> message_queue;
+				struct message
+				{
+					core::vector<char> data;
+					size_t offset = 0;
+					size_t size = 0;
+					web_socket_op opcode = web_socket_op::next;
+					bool compressed = false;
+					bool inlined = false;
+				};
+
+				typedef core::single_queue<message> message_queue;
 
 			private:
 				enum class bytecode
@@ -768,11 +924,29 @@ namespace vitex
 					end
 				};
 
+			private:
+				struct
+				{
+					void* inflater = nullptr;
+					void* deflater = nullptr;
+					size_t min_length = 0;
+					size_t max_length = 0;
+					int window_bits = 15;
+					bool inflate_reset = false;
+					bool deflate_reset = false;
+				} compression;
+
 			private:
 				message_queue queue;
 				core::vector<char> payload;
+				core::vector<char> fragments;
 				uint64_t remains;
+				size_t filled;
+				size_t offset;
+				size_t length;
+				size_t inlines;
 				web_socket_op opcode;
+				web_socket_op fragment_opcode;
 				bytecode state;
 				uint8_t mask[4];
 				uint8_t fragment;
@@ -780,14 +954,32 @@ namespace vitex
 				uint8_t control;
 				uint8_t masked;
 				uint8_t masks;
+				uint8_t compressed;
 
 			public:
 				core::vector<char> data;
 
 			public:
 				web_codec();
+				~web_codec() noexcept;
+				bool enable_deflate(size_t min_length, size_t max_length, int window_bits, int quality_level, int memory_level, bool inflate_no_context_takeover, bool deflate_no_context_takeover);
+				bool deflate(web_socket_op op, const std::string_view& buffer, core::string& output);
 				bool parse_frame(const uint8_t* buffer, size_t size);
+				bool parse_received(size_t size);
 				bool get_frame(web_socket_op* op, core::vector<char>* message);
+				bool get_frame(web_socket_op* op, std::string_view* message);
+				char* get_receive_buffer(size_t size);
+				bool is_deflate_enabled() const;
+				bool is_deflate_stateless() const;
+				int get_deflate_window_bits() const;
+
+			private:
+				bool inflate(const char* buffer, size_t size, core::vector<char>& output);
+				void begin_payload(const char* next);
+				void end_payload();
+
+			public:
+				static void mask_payload(char* buffer, size_t size, const uint8_t mask[4], uint8_t offset);
 			};
 
 			class hrm_cache final : public core::singleton<hrm_cache>
@@ -904,10 +1096,42 @@ namespace vitex
 				friend logical;
 				friend utils;
 
+			private:
+				core::task_id session_sweeper = core::INVALID_TASK_ID;
+				core::task_id session_flusher = core::INVALID_TASK_ID;
+
+			public:
+				struct broadcast_stats
+				{
+					size_t groups = 0;
+					size_t subscriptions = 0;
+					size_t broadcasts = 0;
+					size_t delivered = 0;
+					size_t dropped = 0;
+					size_t closed = 0;
+				};
+
+			private:
+				struct
+				{
+					core::unordered_map<core::string, core::unordered_set<web_socket_frame*>> groups;
+					core::unordered_map<web_socket_frame*, core::unordered_set<core::string>> members;
+					broadcast_stats stats;
+					broadcast_policy policy = broadcast_policy::drop;
+					size_t max_backlog = 4194304;
+					std::mutex section;
+				} broadcasting;
+
 			public:
 				server();
 				~server() override;
 				core::expects_system<void> update();
+				bool subscribe(const std::string_view& group, web_socket_frame* frame);
+				bool unsubscribe(const std::string_view& group, web_socket_frame* frame);
+				size_t unsubscribe(web_socket_frame* frame);
+				size_t broadcast(const std::string_view& group, const std::string_view& buffer, web_socket_op opcode);
+				void set_broadcast_policy(broadcast_policy policy, size_t max_backlog);
+				broadcast_stats get_broadcast_stats();
 
 			private:
 				core::expects_system<void> update_route(router_entry* route);
@@ -966,6 +1190,81 @@ namespace vitex
 				void receive(socket_poll event, const uint8_t* leftover_buffer, size_t leftover_size);
 			};
 
+			class client_pool final : public core::singleton<client_pool>
+			{
+			public:
+				struct pool_stats
+				{
+					size_t in_flight = 0;
+					size_t queued = 0;
+					size_t idle = 0;
+					size_t created = 0;
+					size_t reused = 0;
+					size_t retried = 0;
+					size_t expired = 0;
+					size_t timeouts = 0;
+				};
+
+			private:
+				typedef std::function<void(core::expects_system<client*>&&, bool)> acquire_callback;
+
+				struct waiting_request
+				{
+					acquire_callback callback;
+					std::chrono::microseconds deadline;
+					uint64_t timeout;
+				};
+
+				struct idle_client
+				{
+					client* base;
+					std::chrono::microseconds expires;
+				};
+
+				struct origin_queue
+				{
+					core::single_queue<waiting_request> requests;
+					core::vector<idle_client> clients;
+					core::string hostname;
+					core::string service;
+					int32_t verify_peers = 0;
+					size_t active = 0;
+				};
+
+			private:
+				std::mutex exclusive;
+				core::unordered_map<core::string, origin_queue> origins;
+				std::chrono::microseconds next_cleanup;
+				core::task_id cleanup_timer;
+				pool_stats stats;
+				size_t max_connections;
+				uint64_t max_idle_time;
+
+			public:
+				client_pool() noexcept;
+				client_pool(size_t max_connections_per_origin, uint64_t max_idle_time_ms) noexcept;
+				virtual ~client_pool() noexcept override;
+				void set_max_connections(size_t max_connections_per_origin);
+				void set_max_idle_time(uint64_t max_idle_time_ms);
+				void cleanup();
+				core::expects_promise_system<response_frame> fetch(const std::string_view& hostname, const std::string_view& service, int32_t verify_peers, request_frame&& request, size_t max_size, uint64_t timeout);
+				pool_stats get_stats();
+				size_t get_max_connections() const;
+				uint64_t get_max_idle_time() const;
+
+			private:
+				void acquire(const core::string& name, const std::string_view& hostname, const std::string_view& service, int32_t verify_peers, uint64_t timeout, acquire_callback&& callback);
+				void recycle(const core::string& name, client* base, bool reusable);
+				void create(const core::string& name, uint64_t timeout, acquire_callback&& callback);
+				void schedule_cleanup();
+				void expire(core::single_queue<waiting_request>& expired, core::vector<client*>& outdated, const std::chrono::microseconds& time);
+				void send(core::string&& hostname, core::string&& service, int32_t verify_peers, request_frame&& request, size_t max_size, uint64_t timeout, core::expects_promise_system<response_frame> result, bool retriable);
+
+			private:
+				static bool is_reusable(client* base, const core::expects_system<void>& status);
+				static bool is_idempotent(const request_frame& request);
+			};
+
 			core::expects_promise_system<response_frame> fetch(const std::string_view& location, const std::string_view& method = "GET", const fetch_frame& options = fetch_frame());
 		}
 	}
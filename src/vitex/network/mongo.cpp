@@ -4,6 +4,7 @@
 #endif
 #define mongo_execute_query(function, context, ...) execute_query(#function, function, context, ##__VA_ARGS__)
 #define mongo_execute_cursor(function, context, ...) execute_cursor(#function, function, context, ##__VA_ARGS__)
+#define CURSOR_BATCH_SIZE 128
 
 namespace vitex
 {
@@ -742,6 +743,194 @@ namespace vitex
 				return true;
 #else
 				return false;
+#endif
+			}
+			bool document::encode(void* target, core::schema* source)
+			{
+#ifdef VI_MONGOC
+				VI_ASSERT(target != nullptr, "target should be set");
+				VI_ASSERT(source != nullptr, "source should be set");
+
+				bson_t* base = (bson_t*)target;
+				bool array = (source->value.get_type() == core::var_type::array);
+				size_t array_id = 0;
+				char index[16];
+
+				for (auto&& node : source->get_childs())
+				{
+					const char* key = node->key.c_str();
+					int key_size = (int)node->key.size();
+					if (array || !key_size)
+					{
+						key = index;
+						key_size = (int)bson_uint32_to_string((uint32_t)array_id, &key, index, sizeof(index));
+					}
+
+					++array_id;
+					switch (node->value.get_type())
+					{
+						case core::var_type::object:
+						{
+							bson_t child;
+							if (!bson_append_document_begin(base, key, key_size, &child))
+								return false;
+
+							bool success = encode(&child, node);
+							if (!bson_append_document_end(base, &child) || !success)
+								return false;
+							break;
+						}
+						case core::var_type::array:
+						{
+							bson_t child;
+							if (!bson_append_array_begin(base, key, key_size, &child))
+								return false;
+
+							bool success = encode(&child, node);
+							if (!bson_append_array_end(base, &child) || !success)
+								return false;
+							break;
+						}
+						case core::var_type::string:
+						{
+							auto value = node->value.get_string();
+							if (!bson_append_utf8(base, key, key_size, value.data(), (int)value.size()))
+								return false;
+							break;
+						}
+						case core::var_type::boolean:
+							if (!bson_append_bool(base, key, key_size, node->value.get_boolean()))
+								return false;
+							break;
+						case core::var_type::decimal:
+						{
+							bson_decimal128_t decimal;
+							core::string value = node->value.get_decimal().to_string();
+							bson_decimal128_from_string(value.c_str(), &decimal);
+							if (!bson_append_decimal128(base, key, key_size, &decimal))
+								return false;
+							break;
+						}
+						case core::var_type::number:
+							if (!bson_append_double(base, key, key_size, node->value.get_number()))
+								return false;
+							break;
+						case core::var_type::integer:
+							if (!bson_append_int64(base, key, key_size, node->value.get_integer()))
+								return false;
+							break;
+						case core::var_type::null:
+							if (!bson_append_null(base, key, key_size))
+								return false;
+							break;
+						case core::var_type::binary:
+						{
+							if (node->value.size() != 12)
+							{
+								core::string value = compute::codec::bep45_encode(node->value.get_blob());
+								if (!bson_append_utf8(base, key, key_size, value.c_str(), (int)value.size()))
+									return false;
+								break;
+							}
+
+							bson_oid_t object_id;
+							memcpy(object_id.bytes, node->value.get_binary(), sizeof(uint8_t) * 12);
+							if (!bson_append_oid(base, key, key_size, &object_id))
+								return false;
+							break;
+						}
+						default:
+							break;
+					}
+				}
+
+				return true;
+#else
+				return false;
+#endif
+			}
+			void document::decode(void* it, core::schema* target)
+			{
+#ifdef VI_MONGOC
+				VI_ASSERT(it != nullptr, "iterator should be set");
+				VI_ASSERT(target != nullptr, "target should be set");
+
+				bson_iter_t* base = (bson_iter_t*)it;
+				bool array = (target->value.get_type() == core::var_type::array);
+				while (bson_iter_next(base))
+				{
+					const bson_value_t* value = bson_iter_value(base);
+					if (!value)
+						continue;
+
+					std::string_view name = (array ? std::string_view() : std::string_view(bson_iter_key(base)));
+					switch (value->value_type)
+					{
+						case BSON_TYPE_DOCUMENT:
+						case BSON_TYPE_ARRAY:
+						{
+							bson_iter_t child;
+							core::schema* node = (value->value_type == BSON_TYPE_ARRAY ? core::var::set::array() : core::var::set::object());
+							if (bson_iter_recurse(base, &child))
+								decode(&child, node);
+							target->set(name, node);
+							break;
+						}
+						case BSON_TYPE_BOOL:
+							target->set(name, core::var::boolean(value->value.v_bool));
+							break;
+						case BSON_TYPE_INT32:
+							target->set(name, core::var::integer(value->value.v_int32));
+							break;
+						case BSON_TYPE_INT64:
+							target->set(name, core::var::integer(value->value.v_int64));
+							break;
+						case BSON_TYPE_DOUBLE:
+							target->set(name, core::var::number(value->value.v_double));
+							break;
+						case BSON_TYPE_DECIMAL128:
+						{
+							char buffer[BSON_DECIMAL128_STRING];
+							bson_decimal128_to_string(&value->value.v_decimal128, buffer);
+							target->set(name, core::var::decimal_string(buffer));
+							break;
+						}
+						case BSON_TYPE_UTF8:
+							target->set(name, core::var::string(std::string_view(value->value.v_utf8.str, (size_t)value->value.v_utf8.len)));
+							break;
+						case BSON_TYPE_TIMESTAMP:
+							target->set(name, core::var::integer((int64_t)value->value.v_timestamp.timestamp));
+							break;
+						case BSON_TYPE_DATE_TIME:
+							target->set(name, core::var::integer(value->value.v_datetime));
+							break;
+						case BSON_TYPE_REGEX:
+						{
+							core::string regex = value->value.v_regex.regex;
+							regex.append(1, '\n').append(value->value.v_regex.options);
+							target->set(name, core::var::string(regex));
+							break;
+						}
+						case BSON_TYPE_CODE:
+							target->set(name, core::var::string(std::string_view(value->value.v_code.code, (size_t)value->value.v_code.code_len)));
+							break;
+						case BSON_TYPE_SYMBOL:
+							target->set(name, core::var::string(std::string_view(value->value.v_symbol.symbol, (size_t)value->value.v_symbol.len)));
+							break;
+						case BSON_TYPE_CODEWSCOPE:
+							target->set(name, core::var::string(std::string_view(value->value.v_codewscope.code, (size_t)value->value.v_codewscope.code_len)));
+							break;
+						case BSON_TYPE_UNDEFINED:
+						case BSON_TYPE_NULL:
+							target->set(name, core::var::null());
+							break;
+						case BSON_TYPE_OID:
+							target->set(name, core::var::binary(value->value.v_oid.bytes, 12));
+							break;
+						default:
+							break;
+					}
+				}
 #endif
 			}
 			size_t document::count() const
@@ -826,48 +1015,9 @@ namespace vitex
 					return nullptr;
 
 				core::schema* node = (is_array ? core::var::set::array() : core::var::set::object());
-				loop([node](property* key) -> bool
-				{
-					core::string name = (node->value.get_type() == core::var_type::array ? "" : key->name);
-					switch (key->mod)
-					{
-						case type::document:
-						{
-							node->set(name, key->as_document().to_schema(false));
-							break;
-						}
-						case type::array:
-						{
-							node->set(name, key->as_document().to_schema(true));
-							break;
-						}
-						case type::string:
-							node->set(name, core::var::string(key->string));
-							break;
-						case type::boolean:
-							node->set(name, core::var::boolean(key->boolean));
-							break;
-						case type::number:
-							node->set(name, core::var::number(key->number));
-							break;
-						case type::decimal:
-							node->set(name, core::var::decimal_string(key->to_string()));
-							break;
-						case type::integer:
-							node->set(name, core::var::integer(key->integer));
-							break;
-						case type::object_id:
-							node->set(name, core::var::binary(key->object_id, 12));
-							break;
-						case type::null:
-							node->set(name, core::var::null());
-							break;
-						default:
-							break;
-					}
-
-					return true;
-				});
+				bson_iter_t it;
+				if (bson_iter_init(&it, base))
+					decode(&it, node);
 
 				return node;
 #else
@@ -908,56 +1058,12 @@ namespace vitex
 			{
 #ifdef VI_MONGOC
 				VI_ASSERT(src != nullptr && src->value.is_object(), "schema should be set");
-				bool array = (src->value.get_type() == core::var_type::array);
-				document result = bson_new();
-				size_t index = 0;
-
-				for (auto&& node : src->get_childs())
-				{
-					switch (node->value.get_type())
-					{
-						case core::var_type::object:
-							result.set_schema(array ? std::string_view() : node->key.c_str(), document::from_schema(node), index);
-							break;
-						case core::var_type::array:
-							result.set_array(array ? std::string_view() : node->key.c_str(), document::from_schema(node), index);
-							break;
-						case core::var_type::string:
-							result.set_string(array ? std::string_view() : node->key.c_str(), node->value.get_string(), index);
-							break;
-						case core::var_type::boolean:
-							result.set_boolean(array ? std::string_view() : node->key.c_str(), node->value.get_boolean(), index);
-							break;
-						case core::var_type::decimal:
-							result.set_decimal_string(array ? std::string_view() : node->key.c_str(), node->value.get_decimal().to_string(), index);
-							break;
-						case core::var_type::number:
-							result.set_number(array ? std::string_view() : node->key.c_str(), node->value.get_number(), index);
-							break;
-						case core::var_type::integer:
-							result.set_integer(array ? std::string_view() : node->key.c_str(), node->value.get_integer(), index);
-							break;
-						case core::var_type::null:
-							result.set_null(array ? std::string_view() : node->key.c_str(), index);
-							break;
-						case core::var_type::binary:
-						{
-							if (node->value.size() != 12)
-							{
-								core::string base = compute::codec::bep45_encode(node->value.get_blob());
-								result.set_string(array ? std::string_view() : node->key.c_str(), base, index);
-							}
-							else
-								result.set_object_id(array ? std::string_view() : node->key.c_str(), node->value.get_binary(), index);
-							break;
-						}
-						default:
-							break;
-					}
-					index++;
-				}
+				bson_t* result = bson_new();
+				if (encode(result, src))
+					return document(result);
 
-				return result;
+				bson_destroy(result);
+				return nullptr;
 #else
 				return nullptr;
 #endif
@@ -1559,6 +1665,47 @@ namespace vitex
 				});
 #else
 				return expects_promise_db<void>(database_exception(0, "not supported"));
+#endif
+			}
+			expects_promise_db<size_t> cursor::next_batch(core::schema* target, size_t max_count)
+			{
+#ifdef VI_MONGOC
+				VI_ASSERT(target != nullptr && target->value.get_type() == core::var_type::array, "target should be an array");
+				if (!base)
+					return expects_promise_db<size_t>(database_exception(0, "invalid operation"));
+
+				auto* context = base;
+				if (!max_count)
+					max_count = (size_t)mongoc_cursor_get_batch_size(context);
+				if (!max_count)
+					max_count = CURSOR_BATCH_SIZE;
+
+				return core::cotask<expects_db<size_t>>([context, target, max_count]() -> expects_db<size_t>
+				{
+					VI_MEASURE(core::timings::intensive);
+					const tdocument* query = nullptr;
+					size_t count = 0;
+					while (count < max_count && mongoc_cursor_next(context, &query))
+					{
+						bson_iter_t it;
+						core::schema* node = target->push(core::var::set::object());
+						if (bson_iter_init(&it, query))
+							document::decode(&it, node);
+						++count;
+					}
+
+					if (count > 0)
+						return count;
+
+					bson_error_t error;
+					memset(&error, 0, sizeof(bson_error_t));
+					if (!mongoc_cursor_error(context, &error))
+						return database_exception(0, "end of stream");
+
+					return database_exception(error.code, error.message);
+				});
+#else
+				return expects_promise_db<size_t>(database_exception(0, "not supported"));
 #endif
 			}
 			int64_t cursor::get_id() const
@@ -1700,12 +1847,9 @@ namespace vitex
 					core::uptr<core::schema> result = core::var::set::array();
 					while (true)
 					{
-						auto status = VI_AWAIT(net_cursor.next());
+						auto status = VI_AWAIT(net_cursor.next_batch(*result));
 						if (status)
-						{
-							result->push(net_cursor.current().to_schema());
 							continue;
-						}
 						else if (status.error().code() != 0 && result->empty())
 							coreturn expects_db<core::schema*>(std::move(status.error()));
 						break;
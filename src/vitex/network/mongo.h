@@ -195,6 +195,9 @@ namespace vitex
 
 			private:
 				static bool clone(void* it, property* output);
+				static bool encode(void* target, core::schema* source);
+				static void decode(void* it, core::schema* target);
+				friend class cursor;
 			};
 
 			class address
@@ -286,6 +289,7 @@ namespace vitex
 				bool empty() const;
 				core::option<database_exception> error() const;
 				expects_promise_db<void> next();
+				expects_promise_db<size_t> next_batch(core::schema* target, size_t max_count = 0);
 				int64_t get_id() const;
 				int64_t get_limit() const;
 				size_t get_max_await_time() const;
@@ -8,6 +8,10 @@ extern "C"
 #include <openssl/opensslv.h>
 }
 #endif
+#define COPY_CHUNK_SIZE 65536
+#define ROW_STREAM_BACKLOG 2
+#define COPY_STREAM_BACKLOG 1024
+#define QUERY_CACHE_SHARDS 16
 
 namespace vitex
 {
@@ -135,7 +139,7 @@ namespace vitex
 				}
 #endif
 			}
-			static core::schema* to_schema(const char* data, int size, uint32_t id);
+			static core::schema* to_schema(const char* data, int size, uint32_t id, bool binary = false);
 			static void to_array_field(void* context, array_filter* subdata, char* data, size_t size)
 			{
 				VI_ASSERT(context != nullptr, "context should be set");
@@ -259,6 +263,84 @@ namespace vitex
 						return core::var::string(std::string_view(data, (size_t)size));
 				}
 			}
+			static core::variant to_binary_variant(const char* data, int size, uint32_t id)
+			{
+				if (!data)
+					return core::var::null();
+
+				auto to_host = [data](size_t bytes) -> uint64_t
+				{
+					uint64_t value = 0;
+					for (size_t i = 0; i < bytes; i++)
+						value = (value << 8) | (uint8_t)data[i];
+					return value;
+				};
+
+				oid_type type = (oid_type)id;
+				switch (type)
+				{
+					case oid_type::int2:
+						if (size == 2)
+							return core::var::integer((int16_t)to_host(2));
+						break;
+					case oid_type::int4:
+						if (size == 4)
+							return core::var::integer((int32_t)to_host(4));
+						break;
+					case oid_type::int8:
+						if (size == 8)
+							return core::var::integer((int64_t)to_host(8));
+						break;
+					case oid_type::boolf:
+						if (size == 1)
+							return core::var::boolean(data[0] != 0);
+						break;
+					case oid_type::float4:
+					{
+						if (size != 4)
+							break;
+
+						float value; uint32_t bits = (uint32_t)to_host(4);
+						memcpy(&value, &bits, sizeof(value));
+						return core::var::number(value);
+					}
+					case oid_type::float8:
+					{
+						if (size != 8)
+							break;
+
+						double value; uint64_t bits = to_host(8);
+						memcpy(&value, &bits, sizeof(value));
+						return core::var::number(value);
+					}
+					case oid_type::JSONB:
+						if (size > 0 && data[0] == 1)
+							return core::var::string(std::string_view(data + 1, (size_t)size - 1));
+						break;
+					case oid_type::UUID:
+					{
+						if (size != 16)
+							break;
+
+						core::string value = compute::codec::hex_encode(std::string_view(data, (size_t)size));
+						for (size_t offset : { 20, 16, 12, 8 })
+							value.insert(offset, 1, '-');
+						return core::var::string(value);
+					}
+					case oid_type::JSON:
+					case oid_type::symbol:
+					case oid_type::name:
+					case oid_type::text:
+					case oid_type::cstring:
+					case oid_type::bp_char:
+					case oid_type::var_char:
+						return core::var::string(std::string_view(data, (size_t)size));
+					default:
+						break;
+				}
+
+				return core::var::binary((uint8_t*)data, (size_t)size);
+			}
 			static core::schema* to_array(const char* data, int size, uint32_t id)
 			{
 				std::pair<core::schema*, Oid> context;
@@ -274,11 +356,23 @@ namespace vitex
 
 				return context.first;
 			}
-			core::schema* to_schema(const char* data, int size, uint32_t id)
+			core::schema* to_schema(const char* data, int size, uint32_t id, bool binary)
 			{
 				if (!data)
 					return nullptr;
 
+				if (binary)
+				{
+					core::variant value = to_binary_variant(data, size, id);
+					if ((id == (uint32_t)oid_type::JSON || id == (uint32_t)oid_type::JSONB) && value.get_type() == core::var_type::string)
+					{
+						auto text = value.get_blob();
+						return to_schema(text.data(), (int)text.size(), (uint32_t)oid_type::JSON);
+					}
+
+					return new core::schema(std::move(value));
+				}
+
 				oid_type type = (oid_type)id;
 				switch (type)
 				{
@@ -357,7 +451,468 @@ namespace vitex
 						return new core::schema(to_variant(data, size, id));
 				}
 			}
+			static void cancel_query(tconnection* base)
+			{
+				PGcancel* cancel = PQgetCancel(base);
+				if (!cancel)
+					return;
+
+				core::codefer([cancel]()
+				{
+					char error[256];
+					PQcancel(cancel, error, sizeof(error));
+					PQfreeCancel(cancel);
+				});
+			}
+#endif
+			static void get_cache_hash(const std::string_view& payload, uint64_t seed, uint64_t hash[2])
+			{
+				const uint8_t* data = (const uint8_t*)payload.data();
+				const uint64_t c1 = 0x87c37b91114253d5ull, c2 = 0x4cf5ad432745937full;
+				auto rotate = [](uint64_t x, int r) { return (x << r) | (x >> (64 - r)); };
+				auto mix = [](uint64_t k)
+				{
+					k ^= k >> 33; k *= 0xff51afd7ed558ccdull;
+					k ^= k >> 33; k *= 0xc4ceb9fe1a85ec53ull;
+					k ^= k >> 33;
+					return k;
+				};
+
+				size_t size = payload.size(), blocks = size / 16;
+				uint64_t h1 = seed, h2 = seed;
+				for (size_t i = 0; i < blocks; i++)
+				{
+					uint64_t k1, k2;
+					memcpy(&k1, data + i * 16, sizeof(k1));
+					memcpy(&k2, data + i * 16 + 8, sizeof(k2));
+					k1 *= c1; k1 = rotate(k1, 31); k1 *= c2; h1 ^= k1;
+					h1 = rotate(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52dce729;
+					k2 *= c2; k2 = rotate(k2, 33); k2 *= c1; h2 ^= k2;
+					h2 = rotate(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495ab5;
+				}
+
+				const uint8_t* tail = data + blocks * 16;
+				size_t left = size & 15;
+				uint64_t k1 = 0, k2 = 0;
+				for (size_t i = left; i > 8; i--)
+					k2 ^= (uint64_t)tail[i - 1] << ((i - 9) * 8);
+				for (size_t i = std::min<size_t>(left, 8); i > 0; i--)
+					k1 ^= (uint64_t)tail[i - 1] << ((i - 1) * 8);
+				if (left > 8)
+				{
+					k2 *= c2; k2 = rotate(k2, 33); k2 *= c1; h2 ^= k2;
+				}
+				if (left > 0)
+				{
+					k1 *= c1; k1 = rotate(k1, 31); k1 *= c2; h1 ^= k1;
+				}
+
+				h1 ^= (uint64_t)size; h2 ^= (uint64_t)size;
+				h1 += h2; h2 += h1;
+				h1 = mix(h1); h2 = mix(h2);
+				h1 += h2; h2 += h1;
+				hash[0] = h1;
+				hash[1] = h2;
+			}
+			static void get_cache_tables(const std::string_view& command, core::vector<core::string>& tables)
+			{
+				auto is_word = [](char v) { return core::stringify::is_alphanum(v) || v == '_' || v == '.' || v == '\"' || v == '$'; };
+				bool capture = false;
+				size_t offset = 0;
+				while (offset < command.size())
+				{
+					if (!is_word(command[offset]))
+					{
+						++offset;
+						continue;
+					}
+
+					size_t start = offset;
+					while (offset < command.size() && is_word(command[offset]))
+						++offset;
+
+					core::string word = core::string(command.substr(start, offset - start));
+					core::stringify::to_lower(word);
+					if (capture)
+					{
+						word.erase(std::remove(word.begin(), word.end(), '\"'), word.end());
+						size_t schema = word.rfind('.');
+						if (schema != core::string::npos)
+							word.erase(0, schema + 1);
+						if (!word.empty() && std::find(tables.begin(), tables.end(), word) == tables.end())
+							tables.push_back(std::move(word));
+						capture = false;
+					}
+					else
+						capture = (word == "from" || word == "join" || word == "update" || word == "into");
+				}
+			}
+			static bool is_multi_statement(const std::string_view& command)
+			{
+				bool terminated = false;
+				size_t offset = 0;
+				while (offset < command.size())
+				{
+					char v = command[offset];
+					if (v == '\'' || v == '\"')
+					{
+						size_t end = command.find(v, offset + 1);
+						offset = (end == std::string_view::npos ? command.size() : end + 1);
+					}
+					else if (v == '-' && offset + 1 < command.size() && command[offset + 1] == '-')
+					{
+						size_t end = command.find('\n', offset + 2);
+						offset = (end == std::string_view::npos ? command.size() : end + 1);
+					}
+					else if (v == '/' && offset + 1 < command.size() && command[offset + 1] == '*')
+					{
+						size_t end = command.find("*/", offset + 2);
+						offset = (end == std::string_view::npos ? command.size() : end + 2);
+					}
+					else if (v == '$' && (!offset || !(core::stringify::is_alphanum(command[offset - 1]) || command[offset - 1] == '_')))
+					{
+						size_t end = offset + 1;
+						while (end < command.size() && (core::stringify::is_alphanum(command[end]) || command[end] == '_'))
+							++end;
+
+						if (end < command.size() && command[end] == '$')
+						{
+							auto tag = command.substr(offset, end - offset + 1);
+							size_t close = command.find(tag, end + 1);
+							offset = (close == std::string_view::npos ? command.size() : close + tag.size());
+						}
+						else
+							offset = end;
+					}
+					else if (v == ';')
+					{
+						terminated = true;
+						++offset;
+					}
+					else if (terminated && !core::stringify::is_whitespace(v))
+						return true;
+					else
+						++offset;
+				}
+
+				return false;
+			}
+			static size_t get_cursor_size(const cursor& data)
+			{
+				size_t size = sizeof(cursor);
+#ifdef VI_POSTGRESQL
+				for (auto& item : data.base)
+				{
+					if (item.get() != nullptr)
+						size += PQresultMemorySize(item.get());
+				}
 #endif
+				return size;
+			}
+			static const char* get_copy_format(copy_format format)
+			{
+				switch (format)
+				{
+					case copy_format::csv:
+						return "csv";
+					case copy_format::binary:
+						return "binary";
+					case copy_format::text:
+					default:
+						return "text";
+				}
+			}
+			static void copy_network(core::string& buffer, uint64_t value, size_t bytes)
+			{
+				for (size_t i = bytes; i-- > 0;)
+					buffer.push_back((char)(uint8_t)(value >> (i * 8)));
+			}
+			static void copy_text(core::string& buffer, copy_format format, const std::string_view& value)
+			{
+				if (format == copy_format::binary)
+				{
+					copy_network(buffer, (uint64_t)value.size(), 4);
+					buffer.append(value);
+				}
+				else if (format == copy_format::csv)
+				{
+					if (value.empty() || value == "\\." || value.find_first_of(",\"\r\n") != std::string_view::npos)
+					{
+						buffer.push_back('\"');
+						for (char v : value)
+						{
+							if (v == '\"')
+								buffer.push_back('\"');
+							buffer.push_back(v);
+						}
+						buffer.push_back('\"');
+					}
+					else
+						buffer.append(value);
+				}
+				else
+				{
+					for (char v : value)
+					{
+						switch (v)
+						{
+							case '\\':
+								buffer.append("\\\\");
+								break;
+							case '\t':
+								buffer.append("\\t");
+								break;
+							case '\n':
+								buffer.append("\\n");
+								break;
+							case '\r':
+								buffer.append("\\r");
+								break;
+							default:
+								buffer.push_back(v);
+								break;
+						}
+					}
+				}
+			}
+			static void copy_null(core::string& buffer, copy_format format)
+			{
+				if (format == copy_format::binary)
+					copy_network(buffer, 0xFFFFFFFF, 4);
+				else if (format == copy_format::text)
+					buffer.append("\\N");
+			}
+			static void copy_identifier(core::string& buffer, const std::string_view& name)
+			{
+				buffer.push_back('\"');
+				for (char v : name)
+				{
+					if (v == '\"')
+						buffer.push_back('\"');
+					buffer.push_back(v);
+				}
+				buffer.push_back('\"');
+			}
+			static void copy_relation(core::string& buffer, const std::string_view& name)
+			{
+				size_t offset = 0;
+				while (offset <= name.size())
+				{
+					size_t end = offset;
+					bool quoted = end < name.size() && name[end] == '\"';
+					if (quoted)
+					{
+						for (++end; end < name.size(); end++)
+						{
+							if (name[end] != '\"')
+								continue;
+							else if (end + 1 < name.size() && name[end + 1] == '\"')
+								++end;
+							else
+								break;
+						}
+						end = std::min(end + 1, name.size());
+					}
+					else
+						end = std::min(name.find('.', offset), name.size());
+
+					auto part = name.substr(offset, end - offset);
+					if (quoted && part.size() > 1 && part.back() == '\"')
+						buffer.append(part);
+					else
+						copy_identifier(buffer, part);
+
+					if (end >= name.size() || name[end] != '.')
+						break;
+
+					buffer.push_back('.');
+					offset = end + 1;
+				}
+			}
+			static bool copy_numeric(core::string& buffer, const std::string_view& value)
+			{
+				size_t offset = 0;
+				bool negative = false;
+				if (offset < value.size() && (value[offset] == '-' || value[offset] == '+'))
+					negative = value[offset++] == '-';
+
+				size_t point = value.find('.', offset);
+				std::string_view whole = value.substr(offset, point == std::string_view::npos ? std::string_view::npos : point - offset);
+				std::string_view fraction = (point == std::string_view::npos ? std::string_view() : value.substr(point + 1));
+				if (whole.empty() && fraction.empty())
+					return false;
+
+				for (auto& part : { whole, fraction })
+				{
+					for (char v : part)
+					{
+						if (!core::stringify::is_numeric(v))
+							return false;
+					}
+				}
+
+				while (!whole.empty() && whole.front() == '0')
+					whole.remove_prefix(1);
+
+				core::string digits((4 - whole.size() % 4) % 4, '0');
+				digits.append(whole);
+				int64_t weight = (int64_t)(digits.size() / 4) - 1;
+				digits.append(fraction);
+				digits.append((4 - fraction.size() % 4) % 4, '0');
+
+				core::vector<uint16_t> groups;
+				groups.reserve(digits.size() / 4);
+				for (size_t i = 0; i < digits.size(); i += 4)
+					groups.push_back((uint16_t)((digits[i] - '0') * 1000 + (digits[i + 1] - '0') * 100 + (digits[i + 2] - '0') * 10 + (digits[i + 3] - '0')));
+
+				size_t start = 0, end = groups.size();
+				while (start < end && !groups[start])
+				{
+					++start;
+					--weight;
+				}
+				while (end > start && !groups[end - 1])
+					--end;
+
+				size_t count = end - start;
+				if (!count)
+				{
+					weight = 0;
+					negative = false;
+				}
+
+				copy_network(buffer, (uint64_t)(8 + count * 2), 4);
+				copy_network(buffer, (uint64_t)count, 2);
+				copy_network(buffer, (uint64_t)(uint16_t)(int16_t)weight, 2);
+				copy_network(buffer, negative ? 0x4000 : 0x0000, 2);
+				copy_network(buffer, (uint64_t)fraction.size(), 2);
+				for (size_t i = start; i < end; i++)
+					copy_network(buffer, groups[i], 2);
+				return true;
+			}
+			static bool copy_uuid(core::string& buffer, const std::string_view& value)
+			{
+				uint8_t data[16];
+				size_t size = 0;
+				for (size_t i = 0; i < value.size(); i++)
+				{
+					char v = value[i];
+					if (v == '-' || v == '{' || v == '}')
+						continue;
+					else if (!core::stringify::is_hex(v) || i + 1 >= value.size() || !core::stringify::is_hex(value[i + 1]) || size >= sizeof(data))
+						return false;
+
+					data[size++] = (uint8_t)strtol(core::string(value.substr(i, 2)).c_str(), nullptr, 16);
+					++i;
+				}
+
+				if (size != sizeof(data))
+					return false;
+
+				copy_network(buffer, sizeof(data), 4);
+				buffer.append((char*)data, sizeof(data));
+				return true;
+			}
+			static core::string copy_string(const core::variant& value, core::schema* source)
+			{
+				switch (value.get_type())
+				{
+					case core::var_type::object:
+					case core::var_type::array:
+					{
+						core::string result;
+						if (source != nullptr)
+							core::schema::convert_to_json(source, [&result](core::var_form, const std::string_view& buffer) { result.append(buffer); });
+						return result;
+					}
+					case core::var_type::boolean:
+						return value.get_boolean() ? "t" : "f";
+					case core::var_type::decimal:
+						return value.get_decimal().to_string();
+					default:
+						return value.get_blob();
+				}
+			}
+			static bool copy_binary(core::string& buffer, const core::variant& value, core::schema* source, oid_type type)
+			{
+				switch (type)
+				{
+					case oid_type::int2:
+						copy_network(buffer, 2, 4);
+						copy_network(buffer, (uint64_t)value.get_integer(), 2);
+						return true;
+					case oid_type::int4:
+						copy_network(buffer, 4, 4);
+						copy_network(buffer, (uint64_t)value.get_integer(), 4);
+						return true;
+					case oid_type::int8:
+						copy_network(buffer, 8, 4);
+						copy_network(buffer, (uint64_t)value.get_integer(), 8);
+						return true;
+					case oid_type::float4:
+					{
+						float number = (float)value.get_number(); uint32_t bits;
+						memcpy(&bits, &number, sizeof(bits));
+						copy_network(buffer, 4, 4);
+						copy_network(buffer, bits, 4);
+						return true;
+					}
+					case oid_type::float8:
+					{
+						double number = value.get_number(); uint64_t bits;
+						memcpy(&bits, &number, sizeof(bits));
+						copy_network(buffer, 8, 4);
+						copy_network(buffer, bits, 8);
+						return true;
+					}
+					case oid_type::boolf:
+						copy_network(buffer, 1, 4);
+						copy_network(buffer, value.get_boolean() ? 1 : 0, 1);
+						return true;
+					case oid_type::numeric:
+						if (value.get_type() == core::var_type::number)
+							return copy_numeric(buffer, core::to_string(value.get_number()));
+						return copy_numeric(buffer, copy_string(value, source));
+					case oid_type::JSONB:
+					{
+						core::string data = copy_string(value, source);
+						copy_network(buffer, (uint64_t)data.size() + 1, 4);
+						buffer.push_back('\x01');
+						buffer.append(data);
+						return true;
+					}
+					case oid_type::UUID:
+						return copy_uuid(buffer, value.get_blob());
+					case oid_type::bytea:
+						copy_text(buffer, copy_format::binary, value.get_blob());
+						return true;
+					case oid_type::text:
+					case oid_type::var_char:
+					case oid_type::bp_char:
+					case oid_type::name:
+					case oid_type::JSON:
+						copy_text(buffer, copy_format::binary, copy_string(value, source));
+						return true;
+					default:
+						return false;
+				}
+			}
+			static bool copy_field(core::string& buffer, copy_format format, const core::variant& value, core::schema* source, const core::vector<oid_type>& types, size_t column)
+			{
+				if (value.is(core::var_type::null) || value.is(core::var_type::undefined) || (value.is(core::var_type::decimal) && value.get_decimal().is_nan()))
+				{
+					copy_null(buffer, format);
+					return true;
+				}
+				else if (format == copy_format::binary)
+					return column < types.size() && copy_binary(buffer, value, source, types[column]);
+
+				if (value.is(core::var_type::binary))
+					copy_text(buffer, format, "\\x" + compute::codec::hex_encode(value.get_string()));
+				else
+					copy_text(buffer, format, copy_string(value, source));
+				return true;
+			}
 			database_exception::database_exception(tconnection* connection)
 			{
 #ifdef VI_POSTGRESQL
@@ -611,6 +1166,8 @@ namespace vitex
 				char* data = PQgetvalue(base, (int)row_index, (int)column_index);
 				int size = PQgetlength(base, (int)row_index, (int)column_index);
 				Oid type = PQftype(base, (int)column_index);
+				if (PQfformat(base, (int)column_index) == 1)
+					return to_binary_variant(data, size, type);
 
 				return to_variant(data, size, type);
 #else
@@ -630,7 +1187,7 @@ namespace vitex
 				int size = PQgetlength(base, (int)row_index, (int)column_index);
 				Oid type = PQftype(base, (int)column_index);
 
-				return to_schema(data, size, type);
+				return to_schema(data, size, type, PQfformat(base, (int)column_index) == 1);
 #else
 				return nullptr;
 #endif
@@ -790,7 +1347,7 @@ namespace vitex
 					Oid type = PQftype(base, j);
 
 					if (!null)
-						result->set(name ? name : core::to_string(j), to_schema(data, count, type));
+						result->set(name ? name : core::to_string(j), to_schema(data, count, type, PQfformat(base, j) == 1));
 					else
 						result->set(name ? name : core::to_string(j), core::var::null());
 				}
@@ -819,7 +1376,7 @@ namespace vitex
 					int count = PQgetlength(base, (int)row_index, j);
 					bool null = PQgetisnull(base, (int)row_index, j) == 1;
 					Oid type = PQftype(base, j);
-					result->push(null ? core::var::set::null() : to_schema(data, count, type));
+					result->push(null ? core::var::set::null() : to_schema(data, count, type, PQfformat(base, j) == 1));
 				}
 
 				return result;
@@ -963,7 +1520,7 @@ namespace vitex
 						auto& field = meta[j];
 
 						if (!null)
-							subresult->set(field.first, to_schema(data, size, field.second));
+							subresult->set(field.first, to_schema(data, size, field.second, PQfformat(base, j) == 1));
 						else
 							subresult->set(field.first, core::var::null());
 					}
@@ -1008,7 +1565,7 @@ namespace vitex
 						char* data = PQgetvalue(base, i, j);
 						int size = PQgetlength(base, i, j);
 						bool null = PQgetisnull(base, i, j) == 1;
-						subresult->push(null ? core::var::set::null() : to_schema(data, size, meta[j]));
+						subresult->push(null ? core::var::set::null() : to_schema(data, size, meta[j], PQfformat(base, j) == 1));
 					}
 
 					result->push(subresult);
@@ -1425,7 +1982,7 @@ namespace vitex
 				return base[response_index].get_array(index);
 			}
 
-			connection::connection(tconnection* new_base, socket_t fd) : base(new_base), stream(new socket(fd)), current(nullptr), status(query_state::idle)
+			connection::connection(tconnection* new_base, socket_t fd) : base(new_base), stream(new socket(fd)), current(nullptr), status(query_state::idle), pipelined(false)
 			{
 			}
 			connection::~connection() noexcept
@@ -1477,6 +2034,10 @@ namespace vitex
 				return false;
 #endif
 			}
+			bool connection::in_pipeline() const
+			{
+				return pipelined;
+			}
 			bool connection::busy() const
 			{
 				return current != nullptr || status == query_state::busy || status == query_state::busy_in_transaction;
@@ -1486,25 +2047,42 @@ namespace vitex
 				status = in_transaction() ? query_state::busy_in_transaction : query_state::busy;
 				current = data;
 			}
-			request* connection::make_idle()
+			request* connection::make_next()
 			{
 				request* copy = current;
-				status = in_transaction() ? query_state::idle_in_transaction : query_state::idle;
+				if (!pipeline.empty())
+				{
+					current = pipeline.front();
+					pipeline.pop();
+				}
+				else
+					current = nullptr;
+				return copy;
+			}
+			request* connection::make_idle()
+			{
+				request* copy = current;
+				status = in_transaction() ? query_state::idle_in_transaction : query_state::idle;
 				current = nullptr;
 				return copy;
 			}
 			request* connection::make_lost()
 			{
-				request* copy = current;
+				request* copy = make_next();
 				status = query_state::lost;
-				current = nullptr;
 				return copy;
 			}
 
-			request::request(const std::string_view& commands, session_id new_session, caching status, uint64_t rid, size_t new_options) : command(commands.begin(), commands.end()), time(core::schedule::get_clock()), session(new_session), result(nullptr, status), id(rid), options(new_options)
+			request::request(const std::string_view& commands, session_id new_session, caching status, uint64_t rid, size_t new_options) : command(commands.begin(), commands.end()), time(core::schedule::get_clock()), params(nullptr), copy(nullptr), rows(nullptr), session(new_session), result(nullptr, status), id(rid), options(new_options), preparing(false)
 			{
 				command.emplace_back('\0');
 			}
+			request::~request() noexcept
+			{
+				core::memory::deinit(params);
+				core::memory::deinit(copy);
+				core::memory::deinit(rows);
+			}
 			void request::report_cursor()
 			{
 				if (callback)
@@ -1514,8 +2092,11 @@ namespace vitex
 			}
 			void request::report_failure()
 			{
+				cursor empty;
+				if (callback)
+					callback(empty);
 				if (future.is_pending())
-					future.set(cursor());
+					future.set(std::move(empty));
 			}
 			cursor&& request::get_result()
 			{
@@ -1542,8 +2123,11 @@ namespace vitex
 				return future.is_pending();
 			}
 
-			cluster::cluster()
+			cluster::cluster() : round_trips_saved(0), pipeline_depth(1), auto_prepare(true)
 			{
+				cache.shards.reserve(QUERY_CACHE_SHARDS);
+				for (size_t i = 0; i < QUERY_CACHE_SHARDS; i++)
+					cache.shards.push_back(core::memory::init<cache_shard>());
 				multiplexer::get()->activate();
 			}
 			cluster::~cluster() noexcept
@@ -1562,18 +2146,51 @@ namespace vitex
 					item->report_failure();
 					core::memory::release(item);
 				}
+				for (auto* shard : cache.shards)
+					core::memory::deinit(shard);
 				if (network::multiplexer::has_instance())
 					multiplexer::get()->deactivate();
 			}
 			void cluster::clear_cache()
 			{
-				core::umutex<std::mutex> unique(cache.context);
-				cache.objects.clear();
+				for (auto* shard : cache.shards)
+				{
+					core::umutex<std::mutex> unique(shard->context);
+					cache.invalidations += shard->order.size();
+					shard->order.clear();
+					shard->index.clear();
+					shard->bytes = 0;
+				}
+			}
+			void cluster::invalidate_cache(const std::string_view& table)
+			{
+				core::string name = core::string(table);
+				core::stringify::to_lower(name);
+				for (auto* shard : cache.shards)
+				{
+					core::umutex<std::mutex> unique(shard->context);
+					for (auto it = shard->order.begin(); it != shard->order.end();)
+					{
+						if (std::find(it->tables.begin(), it->tables.end(), name) != it->tables.end())
+						{
+							shard->bytes -= it->bytes;
+							shard->index.erase(it->key);
+							it = shard->order.erase(it);
+							++cache.invalidations;
+						}
+						else
+							++it;
+					}
+				}
 			}
 			void cluster::set_cache_cleanup(uint64_t interval)
 			{
 				cache.cleanup_duration = interval;
 			}
+			void cluster::set_cache_capacity(size_t max_bytes)
+			{
+				cache.capacity = max_bytes;
+			}
 			void cluster::set_cache_duration(query_op cache_id, uint64_t duration)
 			{
 				switch (cache_id)
@@ -1597,6 +2214,40 @@ namespace vitex
 				core::umutex<std::recursive_mutex> unique(update);
 				reconnected = new_callback;
 			}
+			void cluster::set_auto_prepare(bool enabled)
+			{
+				auto_prepare = enabled;
+			}
+			void cluster::set_pipeline_depth(size_t max_depth)
+			{
+				pipeline_depth = std::max<size_t>(1, max_depth);
+			}
+			expects_promise_db<void> cluster::set_cache_invalidation(const std::string_view& channel)
+			{
+				core::umutex<std::mutex> unique(cache.context);
+				if (!cache.listener.empty())
+					remove_channel(cache.listener, cache.listener_id);
+
+				cache.listener = channel;
+				cache.listener_id = 0;
+				cache.invalidates = !channel.empty();
+				if (channel.empty())
+					return expects_promise_db<void>(core::expectation::met);
+
+				cache.listener_id = add_channel(channel, [this](const notify& event)
+				{
+					auto table = event.get_data();
+					if (table.empty() || table == "*")
+						clear_cache();
+					else
+						invalidate_cache(table);
+				});
+				unique.negate();
+				if (is_listens(channel))
+					return expects_promise_db<void>(core::expectation::met);
+
+				return listen({ core::string(channel) });
+			}
 			uint64_t cluster::add_channel(const std::string_view& name, const on_notification& new_callback)
 			{
 				VI_ASSERT(new_callback != nullptr, "callback should be set");
@@ -1634,7 +2285,7 @@ namespace vitex
 			}
 			expects_promise_db<session_id> cluster::tx_start(const std::string_view& command)
 			{
-				return query(command).then<expects_db<session_id>>([](expects_db<cursor>&& result) -> expects_db<session_id>
+				return query(command, (size_t)query_op::no_pipeline).then<expects_db<session_id>>([](expects_db<cursor>&& result) -> expects_db<session_id>
 				{
 					if (!result)
 						return result.error();
@@ -1898,6 +2549,16 @@ namespace vitex
 			expects_promise_db<cursor> cluster::template_query(const std::string_view& name, core::schema_args* map, size_t opts, session_id session)
 			{
 				VI_DEBUG("pq template query %s", name.empty() ? "empty-query-name" : core::string(name).c_str());
+				if (auto_prepare)
+				{
+					auto params = driver::get()->get_prepared_query(name, map);
+					if (params)
+					{
+						auto* next = core::memory::init<prepared_query>(std::move(*params));
+						return submit(next->command, next, opts, session);
+					}
+				}
+
 				auto pattern = driver::get()->get_query(this, name, map);
 				if (!pattern)
 					return expects_promise_db<cursor>(pattern.error());
@@ -1905,30 +2566,64 @@ namespace vitex
 				return query(*pattern, opts, session);
 			}
 			expects_promise_db<cursor> cluster::query(const std::string_view& command, size_t opts, session_id session)
+			{
+				return submit(command, nullptr, opts, session);
+			}
+			expects_promise_db<cursor> cluster::submit(const std::string_view& command, prepared_query* params, size_t opts, session_id session)
 			{
 				VI_ASSERT(!command.empty(), "command should not be empty");
-				core::string reference;
+				cache_oid reference;
 				bool may_cache = opts & (size_t)query_op::cache_short || opts & (size_t)query_op::cache_mid || opts & (size_t)query_op::cache_long;
 				if (may_cache)
 				{
 					cursor result(nullptr, caching::cached);
-					reference = get_cache_oid(command, opts);
+					if (params != nullptr)
+					{
+						core::string payload = params->command;
+						for (size_t i = 0; i < params->values.size(); i++)
+							payload.append(1, '\0').append(params->nulls[i] ? "\1" : params->values[i]);
+						reference = get_cache_oid(payload, opts);
+					}
+					else
+						reference = get_cache_oid(command, opts);
+
 					if (get_cache(reference, &result))
 					{
 						driver::get()->log_query(command);
 						VI_DEBUG("pq OK execute on NULL (memory-cache)");
+						core::memory::deinit(params);
 						return expects_promise_db<cursor>(std::move(result));
 					}
+
+					core::umutex<std::mutex> unique(cache.context);
+					auto flight = cache.flights.find(reference);
+					if (flight != cache.flights.end())
+					{
+						expects_promise_db<cursor> future;
+						flight->second.push_back(future);
+						++cache.coalesced;
+						core::memory::deinit(params);
+						return future;
+					}
+					cache.flights[reference];
 				}
 				else if (!is_managing(session))
+				{
+					core::memory::deinit(params);
 					return expects_promise_db<cursor>(database_exception("supplied transaction id does not exist"));
+				}
 				else
 					driver::get()->log_query(command);
 
 				request* next = new request(command, session, may_cache ? caching::miss : caching::never, ++counter, opts);
-				if (!reference.empty())
-					next->callback = [this, reference, opts](cursor& data) { set_cache(reference, &data, opts); };
+				next->params = params;
+				if (may_cache)
+					next->callback = [this, reference, statement = core::string(command), opts](cursor& data) { set_cache(reference, statement, &data, opts); };
 
+				return enqueue(next);
+			}
+			expects_promise_db<cursor> cluster::enqueue(request* next)
+			{
 				auto future = next->future;
 				core::umutex<std::recursive_mutex> unique(update);
 				requests.push_back(next);
@@ -1938,6 +2633,12 @@ namespace vitex
 						return future;
 				}
 
+				for (auto& item : pool)
+				{
+					if (pipeline(item.second))
+						return future;
+				}
+
 				auto time = core::schedule::get_clock();
 				auto timeout = std::chrono::milliseconds((uint64_t)core::timings::hangup);
 				for (auto& item : pool)
@@ -1948,6 +2649,66 @@ namespace vitex
 
 				return future;
 			}
+			expects_promise_db<cursor> cluster::stream_query(const std::string_view& command, on_rows&& callback, size_t batch_size, size_t opts, session_id session)
+			{
+				VI_ASSERT(!command.empty(), "command should not be empty");
+				VI_ASSERT(callback != nullptr, "callback should be set");
+				if (!is_managing(session))
+					return expects_promise_db<cursor>(database_exception("supplied transaction id does not exist"));
+
+				driver::get()->log_query(command);
+				request* next = new request(command, session, caching::never, ++counter, opts & (size_t)query_op::binary_results);
+				next->rows = core::memory::init<row_stream>();
+				next->rows->callback = std::move(callback);
+				next->rows->batch_size = std::max<size_t>(1, batch_size);
+				return enqueue(next);
+			}
+			expects_promise_db<cursor> cluster::copy_in(const std::string_view& table, const core::vector<core::string>& columns, copy_format format, on_copy_in&& producer, session_id session)
+			{
+				VI_ASSERT(!table.empty(), "table should not be empty");
+				VI_ASSERT(producer != nullptr, "producer should be set");
+				if (!is_managing(session))
+					return expects_promise_db<cursor>(database_exception("supplied transaction id does not exist"));
+
+				core::string command = "COPY ";
+				copy_relation(command, table);
+				if (!columns.empty())
+				{
+					command.append(" (");
+					for (auto& column : columns)
+					{
+						copy_identifier(command, column);
+						command.push_back(',');
+					}
+					command.back() = ')';
+				}
+
+				command.append(" FROM STDIN WITH (FORMAT ").append(get_copy_format(format)).append(1, ')');
+				driver::get()->log_query(command);
+
+				request* next = new request(command, session, caching::never, ++counter, 0);
+				next->copy = core::memory::init<copy_stream>();
+				next->copy->producer = std::move(producer);
+				next->copy->format = format;
+				return enqueue(next);
+			}
+			expects_promise_db<cursor> cluster::copy_out(const std::string_view& command, copy_format format, on_copy_out&& consumer, session_id session)
+			{
+				VI_ASSERT(!command.empty(), "command should not be empty");
+				VI_ASSERT(consumer != nullptr, "consumer should be set");
+				if (!is_managing(session))
+					return expects_promise_db<cursor>(database_exception("supplied transaction id does not exist"));
+
+				core::string statement = "COPY (";
+				statement.append(command).append(") TO STDOUT WITH (FORMAT ").append(get_copy_format(format)).append(1, ')');
+				driver::get()->log_query(statement);
+
+				request* next = new request(statement, session, caching::never, ++counter, 0);
+				next->copy = core::memory::init<copy_stream>();
+				next->copy->consumer = std::move(consumer);
+				next->copy->format = format;
+				return enqueue(next);
+			}
 			connection* cluster::get_connection(query_state state)
 			{
 				core::umutex<std::recursive_mutex> unique(update);
@@ -1980,6 +2741,13 @@ namespace vitex
 
 				return false;
 			}
+			bool cluster::is_pipelinable(connection* base, request* context)
+			{
+				if (context->copy != nullptr || context->rows != nullptr || context->options & (size_t)query_op::no_pipeline)
+					return false;
+
+				return !context->params || base->statements.find(context->params->signature) != base->statements.end();
+			}
 			connection* cluster::is_listens(const std::string_view& name)
 			{
 				core::umutex<std::recursive_mutex> unique(update);
@@ -1992,49 +2760,95 @@ namespace vitex
 
 				return nullptr;
 			}
-			core::string cluster::get_cache_oid(const std::string_view& payload, size_t opts)
+			cluster::cache_oid cluster::get_cache_oid(const std::string_view& payload, size_t opts)
 			{
-				auto hash = compute::crypto::hash_hex(compute::digests::sha256(), payload);
-				core::string reference = hash ? compute::codec::hex_encode(*hash) : compute::codec::hex_encode(payload.substr(0, 32));
+				uint64_t seed = 0;
 				if (opts & (size_t)query_op::cache_short)
-					reference.append(".s");
+					seed = 1;
 				else if (opts & (size_t)query_op::cache_mid)
-					reference.append(".m");
+					seed = 2;
 				else if (opts & (size_t)query_op::cache_long)
-					reference.append(".l");
+					seed = 3;
 
-				return reference;
+				if (opts & (size_t)query_op::binary_results)
+					seed |= 4;
+
+				uint64_t hash[2];
+				get_cache_hash(payload, seed, hash);
+
+				cache_oid result;
+				result.low = hash[0];
+				result.high = hash[1];
+				return result;
+			}
+			cluster::cache_shard* cluster::get_cache_shard(const cache_oid& key)
+			{
+				return cache.shards[(size_t)(key.high % (uint64_t)cache.shards.size())];
+			}
+			cluster::cache_stats cluster::get_cache_stats()
+			{
+				cache_stats result;
+				result.hits = cache.hits;
+				result.misses = cache.misses;
+				result.evictions = cache.evictions;
+				result.coalesced = cache.coalesced;
+				result.invalidations = cache.invalidations;
+				for (auto* shard : cache.shards)
+				{
+					core::umutex<std::mutex> unique(shard->context);
+					result.entries += shard->order.size();
+					result.bytes += shard->bytes;
+				}
+
+				return result;
+			}
+			uint64_t cluster::get_round_trips_saved() const
+			{
+				return round_trips_saved;
+			}
+			size_t cluster::get_pipeline_depth() const
+			{
+				return pipeline_depth;
+			}
+			bool cluster::is_auto_prepare() const
+			{
+				return auto_prepare;
 			}
 			bool cluster::is_connected() const
 			{
 				return !pool.empty();
 			}
-			bool cluster::get_cache(const std::string_view& cache_oid, cursor* data)
+			bool cluster::get_cache(const cache_oid& key, cursor* data)
 			{
-				VI_ASSERT(!cache_oid.empty(), "cache Oid should not be empty");
 				VI_ASSERT(data != nullptr, "cursor should be set");
-
-				core::umutex<std::mutex> unique(cache.context);
-				auto it = cache.objects.find(core::key_lookup_cast(cache_oid));
-				if (it == cache.objects.end())
+				auto* shard = get_cache_shard(key);
+				core::umutex<std::mutex> unique(shard->context);
+				auto it = shard->index.find(key);
+				if (it == shard->index.end())
+				{
+					++cache.misses;
 					return false;
+				}
 
-				int64_t time = ::time(nullptr);
-				if (it->second.first < time)
+				auto entry = it->second;
+				if (entry->expires < ::time(nullptr))
 				{
-					*data = std::move(it->second.second);
-					cache.objects.erase(it);
+					shard->bytes -= entry->bytes;
+					shard->order.erase(entry);
+					shard->index.erase(it);
+					++cache.evictions;
+					++cache.misses;
+					return false;
 				}
-				else
-					*data = it->second.second.copy();
 
+				shard->order.splice(shard->order.begin(), shard->order, entry);
+				*data = entry->data.copy();
+				++cache.hits;
 				return true;
 			}
-			void cluster::set_cache(const std::string_view& cache_oid, cursor* data, size_t opts)
+			void cluster::set_cache(const cache_oid& key, const std::string_view& command, cursor* data, size_t opts)
 			{
-				VI_ASSERT(!cache_oid.empty(), "cache Oid should not be empty");
 				VI_ASSERT(data != nullptr, "cursor should be set");
-
 				int64_t time = ::time(nullptr);
 				int64_t timeout = time;
 				if (opts & (size_t)query_op::cache_short)
@@ -2044,27 +2858,100 @@ namespace vitex
 				else if (opts & (size_t)query_op::cache_long)
 					timeout += cache.long_duration;
 
-				core::umutex<std::mutex> unique(cache.context);
-				if (cache.next_cleanup < time)
+				int64_t cleanup = cache.next_cleanup;
+				if (cleanup < time && cache.next_cleanup.compare_exchange_strong(cleanup, time + (int64_t)cache.cleanup_duration.load()))
 				{
-					cache.next_cleanup = time + cache.cleanup_duration;
-					for (auto it = cache.objects.begin(); it != cache.objects.end();)
+					for (auto* shard : cache.shards)
 					{
-						if (it->second.first < time)
-							it = cache.objects.erase(it);
-						else
-							++it;
+						core::umutex<std::mutex> unique(shard->context);
+						for (auto it = shard->order.begin(); it != shard->order.end();)
+						{
+							if (it->expires < time)
+							{
+								shard->bytes -= it->bytes;
+								shard->index.erase(it->key);
+								it = shard->order.erase(it);
+								++cache.evictions;
+							}
+							else
+								++it;
+						}
 					}
 				}
 
-				auto it = cache.objects.find(core::key_lookup_cast(cache_oid));
-				if (it != cache.objects.end())
+				size_t bytes = get_cursor_size(*data);
+				size_t limit = cache.capacity / cache.shards.size();
+				if (data->success() && bytes <= limit)
 				{
-					it->second.second = data->copy();
-					it->second.first = timeout;
+					cache_entry entry;
+					if (cache.invalidates)
+						get_cache_tables(command, entry.tables);
+					entry.key = key;
+					entry.data = data->copy();
+					entry.expires = timeout;
+					entry.bytes = bytes;
+
+					auto* shard = get_cache_shard(key);
+					core::umutex<std::mutex> unique(shard->context);
+					auto it = shard->index.find(key);
+					if (it != shard->index.end())
+					{
+						shard->bytes -= it->second->bytes;
+						shard->order.erase(it->second);
+						shard->index.erase(it);
+					}
+
+					shard->order.push_front(std::move(entry));
+					shard->index[key] = shard->order.begin();
+					shard->bytes += bytes;
+					while (shard->bytes > limit && !shard->order.empty())
+					{
+						auto& last = shard->order.back();
+						shard->bytes -= last.bytes;
+						shard->index.erase(last.key);
+						shard->order.pop_back();
+						++cache.evictions;
+					}
+				}
+
+				core::vector<expects_promise_db<cursor>> waiters;
+				core::umutex<std::mutex> unique(cache.context);
+				auto it = cache.flights.find(key);
+				if (it != cache.flights.end())
+				{
+					waiters = std::move(it->second);
+					cache.flights.erase(it);
+				}
+
+				unique.negate();
+				for (auto& waiter : waiters)
+				{
+					cursor result = data->copy();
+					result.cache = caching::cached;
+					waiter.set(std::move(result));
 				}
-				else
-					cache.objects[core::string(cache_oid)] = std::make_pair(timeout, data->copy());
+			}
+			request* cluster::dequeue(connection* base, bool transactional, bool pipelinable)
+			{
+				for (auto it = requests.begin(); it != requests.end(); ++it)
+				{
+					request* context = *it;
+					if (context->session != nullptr)
+					{
+						if (context->session != base)
+							continue;
+					}
+					else if (transactional)
+						continue;
+
+					if (pipelinable && !is_pipelinable(base, context))
+						return nullptr;
+
+					requests.erase(it);
+					return context;
+				}
+
+				return nullptr;
 			}
 			bool cluster::reestablish(connection* target)
 			{
@@ -2072,8 +2959,8 @@ namespace vitex
 				const char** keys = source.create_keys();
 				const char** values = source.create_values();
 				core::umutex<std::recursive_mutex> unique(update);
-				auto* broken_request = target->make_lost();
-				if (broken_request != nullptr)
+				request* broken_request = nullptr;
+				while ((broken_request = target->make_lost()) != nullptr)
 				{
 					VI_DEBUG("pqerr query reset on 0x%" PRIXPTR ": connection lost", (uintptr_t)target->base);
 					core::codefer([broken_request]()
@@ -2086,6 +2973,7 @@ namespace vitex
 				target->stream->clear_events(false);
 				PQlogNoticeOf(target->base);
 				PQfinish(target->base);
+				target->pipelined = false;
 
 				VI_DEBUG("pq try reconnect on 0x%" PRIXPTR, (uintptr_t)target->base);
 				target->base = PQconnectdbParams(keys, values, 0);
@@ -2106,6 +2994,7 @@ namespace vitex
 				for (auto& item : target->listens)
 					channels.push_back(item);
 				target->listens.clear();
+				target->statements.clear();
 
 				VI_DEBUG("pq OK reconnect on 0x%" PRIXPTR, (uintptr_t)target->base);
 				target->make_idle();
@@ -2144,53 +3033,392 @@ namespace vitex
 				if (base->busy())
 					return false;
 
-				for (auto it = requests.begin(); it != requests.end(); ++it)
+				request* context = dequeue(base, base->in_transaction(), false);
+				if (!context)
+					return false;
+
+				context->result.executor = base;
+				base->make_busy(context);
+#ifdef LIBPQ_HAS_PIPELINING
+				if (pipeline_depth > 1 && is_pipelinable(base, context) && PQenterPipelineMode(base->base) == 1)
+					base->pipelined = true;
+#endif
+				VI_MEASURE(core::timings::intensive);
+				VI_DEBUG("pq execute query on 0x%" PRIXPTR "%s (rid: %" PRIu64 "): %.64s%s", (uintptr_t)base, base->in_transaction() ? " (transaction)" : "", context->id, context->command.data(), context->command.size() > 64 ? " ..." : "");
+				if (execute(base, context))
+					pipeline(base);
+
+				return true;
+#else
+				return false;
+#endif
+			}
+			bool cluster::pipeline(connection* base)
+			{
+#ifdef LIBPQ_HAS_PIPELINING
+				core::umutex<std::recursive_mutex> unique(update);
+				if (!base->pipelined || !base->current)
+					return false;
+
+				bool transactional = base->status == query_state::busy_in_transaction;
+				uint64_t sent = 0;
+				while (base->pipeline.size() + 1 < pipeline_depth)
 				{
-					request* context = *it;
-					if (context->session != nullptr)
-					{
-						if (context->session != base)
-							continue;
-					}
-					else if (base->in_transaction())
-						continue;
+					request* context = dequeue(base, transactional, true);
+					if (!context)
+						break;
 
+					VI_DEBUG("pq pipeline query on 0x%" PRIXPTR "%s (rid: %" PRIu64 ", depth: %i): %.64s%s", (uintptr_t)base, transactional ? " (transaction)" : "", context->id, (int)base->pipeline.size() + 2, context->command.data(), context->command.size() > 64 ? " ..." : "");
 					context->result.executor = base;
-					base->make_busy(context);
-					requests.erase(it);
-					break;
+					if (!execute(base, context))
+						break;
+
+					base->pipeline.push(context);
+					++sent;
 				}
 
-				if (!base->busy())
-					return false;
+				round_trips_saved += sent;
+				return sent > 0;
+#else
+				return false;
+#endif
+			}
+			bool cluster::reprocess(connection* source)
+			{
+				return multiplexer::get()->when_readable(source->stream, [this, source](socket_poll event)
+				{
+					if (packet::is_error(event))
+						reestablish(source);
+					else if (!packet::is_skip(event))
+						dispatch(source);
+				});
+			}
+			bool cluster::execute(connection* base, request* context)
+			{
+#ifdef VI_POSTGRESQL
+				static_assert(sizeof(Oid) == sizeof(uint32_t), "parameter types should be stored as oids");
+				int format = context->options & (size_t)query_op::binary_results ? 1 : 0;
+				int status = 0;
+				if (context->params != nullptr)
+				{
+					auto it = base->statements.find(context->params->signature);
+					if (it != base->statements.end() && it->second.empty())
+						unprepare(base, context);
+				}
 
-				VI_MEASURE(core::timings::intensive);
-				VI_DEBUG("pq execute query on 0x%" PRIXPTR "%s (rid: %" PRIu64 "): %.64s%s", (uintptr_t)base, base->in_transaction() ? " (transaction)" : "", base->current->id, base->current->command.data(), base->current->command.size() > 64 ? " ..." : "");
-				if (PQsendQuery(base->base, base->current->command.data()) == 1)
+				if (context->params != nullptr)
+				{
+					auto* params = context->params;
+					auto it = base->statements.find(params->signature);
+					if (it == base->statements.end())
+					{
+						VI_DEBUG("pq prepare statement on 0x%" PRIXPTR " (rid: %" PRIu64 "): %s", (uintptr_t)base, context->id, params->signature.c_str());
+						context->statement = "vi_" + core::to_string(context->id);
+						context->preparing = true;
+						status = PQsendPrepare(base->base, context->statement.c_str(), params->command.c_str(), (int)params->types.size(), (const Oid*)params->types.data());
+					}
+					else
+					{
+						core::vector<const char*> values;
+						core::vector<int> lengths;
+						values.reserve(params->values.size());
+						lengths.reserve(params->values.size());
+						for (size_t i = 0; i < params->values.size(); i++)
+						{
+							values.push_back(params->nulls[i] ? nullptr : params->values[i].c_str());
+							lengths.push_back((int)params->values[i].size());
+						}
+						status = PQsendQueryPrepared(base->base, it->second.c_str(), (int)values.size(), values.data(), lengths.data(), params->formats.data(), format);
+					}
+				}
+				else if (format != 0 || base->pipelined)
+					status = PQsendQueryParams(base->base, context->command.data(), 0, nullptr, nullptr, nullptr, nullptr, format);
+				else
+					status = PQsendQuery(base->base, context->command.data());
+#ifdef LIBPQ_HAS_PIPELINING
+				if (status == 1 && base->pipelined)
+					status = PQpipelineSync(base->base);
+#endif
+				if (status == 1 && context->rows != nullptr && PQsetSingleRowMode(base->base) != 1)
+					VI_WARN("pq cannot stream rows on 0x%" PRIXPTR " (rid: %" PRIu64 "): single row mode unavailable", (uintptr_t)base, context->id);
+
+				if (status == 1)
 				{
 					flush(base, false);
 					return true;
 				}
 
-				auto* broken_request = base->make_idle();
+				if (context == base->current)
+				{
+					base->make_idle();
+#ifdef LIBPQ_HAS_PIPELINING
+					if (base->pipelined && base->pipeline.empty() && PQexitPipelineMode(base->base) == 1)
+						base->pipelined = false;
+#endif
+				}
+
 				PQlogNoticeOf(base->base);
-				core::codefer([broken_request]()
+				core::codefer([context]()
 				{
-					core::uptr<request> item = broken_request;
+					core::uptr<request> item = context;
 					item->report_failure();
 				});
-				return true;
+				return false;
 #else
 				return false;
 #endif
 			}
-			bool cluster::reprocess(connection* source)
+			void cluster::unprepare(connection* base, request* context)
 			{
-				return multiplexer::get()->when_readable(source->stream, [this, source](socket_poll event)
+				auto* params = context->params;
+				core::string command = params->request;
+				size_t offset = 0;
+				for (auto& position : params->positions)
 				{
-					if (packet::is_error(event))
-						reestablish(source);
-					else if (!packet::is_skip(event))
+					size_t index = position.second;
+					core::string value;
+					if (params->nulls[index])
+						value = "NULL";
+					else if (params->formats[index] != 0)
+						value = utils::get_byte_array(base, params->values[index]);
+					else if (params->literals[index])
+						value = params->values[index];
+					else
+						value = utils::get_char_array(base, params->values[index]);
+
+					command.insert(position.first + offset, value);
+					offset += value.size();
+				}
+
+				context->command.assign(command.begin(), command.end());
+				context->command.emplace_back('\0');
+				context->params = nullptr;
+				core::memory::deinit(params);
+			}
+			bool cluster::transfer(connection* source, query_exec status)
+			{
+#ifdef VI_POSTGRESQL
+				core::umutex<std::recursive_mutex> unique(update);
+				copy_stream* stream = source->current ? source->current->copy : nullptr;
+				if (status == query_exec::copy_out)
+				{
+					char* data = nullptr;
+					int size = 0;
+					while ((size = PQgetCopyData(source->base, &data, 1)) > 0)
+					{
+						if (stream != nullptr && stream->consumer && !stream->cancelled)
+							stream->ready.push(core::string(data, (size_t)size));
+
+						PQfreemem(data);
+						if (stream != nullptr && stream->ready.size() >= COPY_STREAM_BACKLOG)
+						{
+							deliver(source, source->current);
+							stream->paused = true;
+							return false;
+						}
+					}
+
+					if (stream != nullptr && !stream->ready.empty())
+						deliver(source, source->current);
+
+					if (size != 0)
+						return true;
+
+					reprocess(source);
+					return false;
+				}
+
+				auto wait = [this, source]()
+				{
+					source->stream->clear_events(false);
+					multiplexer::get()->when_writeable(source->stream, [this, source](socket_poll event)
+					{
+						if (packet::is_error(event))
+							reestablish(source);
+						else if (!packet::is_skip(event) && transfer(source, query_exec::copy_in))
+							dispatch(source);
+					});
+					return false;
+				};
+				if (stream != nullptr && stream->producing)
+					return false;
+
+				while (stream != nullptr && stream->producer && stream->error.empty())
+				{
+					if (stream->offset < stream->buffer.size())
+					{
+						size_t size = std::min<size_t>(stream->buffer.size() - stream->offset, COPY_CHUNK_SIZE);
+						int queued = PQputCopyData(source->base, stream->buffer.data() + stream->offset, (int)size);
+						if (queued > 0)
+							stream->offset += size;
+
+						int flushed = queued >= 0 ? PQflush(source->base) : -1;
+						if (flushed < 0)
+							stream->error = "copy data write error";
+						else if (queued == 0 || flushed > 0)
+							return wait();
+						continue;
+					}
+					else if (stream->finished)
+						break;
+
+					stream->buffer.clear();
+					stream->offset = 0;
+					if (!stream->started)
+					{
+						stream->started = true;
+						if (stream->format == copy_format::binary)
+						{
+							stream->buffer.append("PGCOPY\n\377\r\n\0", 11);
+							copy_network(stream->buffer, 0, 8);
+						}
+					}
+
+					produce(source, source->current);
+					return false;
+				}
+
+				const char* error = "copy data producer is not set";
+				if (stream != nullptr && stream->producer)
+					error = stream->error.empty() ? nullptr : stream->error.c_str();
+
+				if (PQputCopyEnd(source->base, error) == 0)
+					return wait();
+
+				flush(source, true);
+				return false;
+#else
+				return false;
+#endif
+			}
+			void cluster::deliver(connection* source, request* context)
+			{
+				if (context->copy != nullptr)
+				{
+					copy_stream* stream = context->copy;
+					if (stream->delivering || stream->ready.empty())
+						return;
+
+					stream->delivering = true;
+					context->add_ref();
+					core::codefer([this, source, context]()
+					{
+						core::uptr<request> item = context;
+						core::umutex<std::recursive_mutex> unique(update);
+						copy_stream* stream = context->copy;
+						core::vector<core::string> chunks;
+						chunks.reserve(stream->ready.size());
+						while (!stream->ready.empty())
+						{
+							chunks.emplace_back(std::move(stream->ready.front()));
+							stream->ready.pop();
+						}
+						unique.negate();
+
+						bool proceed = !stream->cancelled;
+						for (size_t i = 0; proceed && i < chunks.size(); i++)
+							proceed = stream->consumer(chunks[i]);
+						chunks.clear();
+						unique.negate();
+						if (!proceed && !stream->cancelled)
+						{
+							stream->cancelled = true;
+							while (!stream->ready.empty())
+								stream->ready.pop();
+#ifdef VI_POSTGRESQL
+							if (source->current == context)
+								cancel_query(source->base);
+#endif
+						}
+
+						stream->delivering = false;
+						bool resume = stream->paused && source->current == context && stream->ready.size() < COPY_STREAM_BACKLOG;
+						if (resume)
+							stream->paused = false;
+
+						deliver(source, context);
+						unique.negate();
+						if (resume)
+							dispatch(source);
+					});
+					return;
+				}
+
+				row_stream* stream = context->rows;
+				if (stream->delivering || stream->ready.empty())
+					return;
+
+				stream->delivering = true;
+				context->add_ref();
+				core::codefer([this, source, context]()
+				{
+					core::uptr<request> item = context;
+					core::umutex<std::recursive_mutex> unique(update);
+					row_stream* stream = context->rows;
+					core::vector<response> rows = std::move(stream->ready.front());
+					stream->ready.pop();
+					unique.negate();
+
+					bool proceed = !stream->cancelled && stream->callback(rows);
+					rows.clear();
+					unique.negate();
+					if (!proceed && !stream->cancelled)
+					{
+						stream->cancelled = true;
+						while (!stream->ready.empty())
+							stream->ready.pop();
+#ifdef VI_POSTGRESQL
+						if (source->current == context)
+							cancel_query(source->base);
+#endif
+					}
+
+					stream->delivering = false;
+					bool resume = stream->paused && source->current == context && stream->ready.size() < ROW_STREAM_BACKLOG;
+					if (resume)
+						stream->paused = false;
+
+					deliver(source, context);
+					unique.negate();
+					if (resume)
+						dispatch(source);
+				});
+			}
+			void cluster::produce(connection* source, request* context)
+			{
+				copy_stream* stream = context->copy;
+				if (stream->producing)
+					return;
+
+				stream->producing = true;
+				context->add_ref();
+				core::codefer([this, source, context]()
+				{
+					core::uptr<request> item = context;
+					core::umutex<std::recursive_mutex> unique(update);
+					copy_stream* stream = context->copy;
+					core::string buffer = std::move(stream->buffer);
+					unique.negate();
+
+					auto more = stream->producer(buffer);
+					unique.negate();
+					stream->buffer = std::move(buffer);
+					stream->producing = false;
+					if (!more)
+					{
+						stream->error = std::move(more.error().message());
+						stream->buffer.clear();
+					}
+					else if (!*more)
+					{
+						stream->finished = true;
+						if (stream->format == copy_format::binary)
+							copy_network(stream->buffer, 0xFFFF, 2);
+					}
+
+					bool resume = source->current == context;
+					unique.negate();
+					if (resume && transfer(source, query_exec::copy_in))
 						dispatch(source);
 				});
 			}
@@ -2247,23 +3475,126 @@ namespace vitex
 				response chunk(PQgetResult(source->base));
 				if (chunk.exists())
 				{
-					if (source->current != nullptr)
+					auto status = chunk.get_status();
+					if (status == query_exec::copy_in || status == query_exec::copy_out)
+					{
+						if (!transfer(source, status))
+							return true;
+					}
+					else if (status == query_exec::pipeline_sync)
+					{
+						auto* ready_request = source->make_next();
+						if (ready_request != nullptr)
+						{
+							if (!ready_request->result.error())
+								VI_DEBUG("pq OK execute on 0x%" PRIXPTR " (%" PRIu64 " ms, rid: %" PRIu64 ", pipeline)", (uintptr_t)source, ready_request->get_timing(), ready_request->id);
+							core::codefer([ready_request]()
+							{
+								core::uptr<request> item = ready_request;
+								item->report_cursor();
+							});
+						}
+					}
+					else if (status == query_exec::single_tuple && source->current != nullptr && source->current->rows != nullptr)
+					{
+						auto* stream = source->current->rows;
+						if (!stream->cancelled)
+						{
+							stream->batch.emplace_back(std::move(chunk));
+							if (stream->batch.size() >= stream->batch_size)
+							{
+								stream->ready.push(std::move(stream->batch));
+								stream->batch.clear();
+								deliver(source, source->current);
+								if (stream->ready.size() >= ROW_STREAM_BACKLOG)
+								{
+									stream->paused = true;
+									return true;
+								}
+							}
+						}
+					}
+					else if (source->current != nullptr)
 						source->current->result.base.emplace_back(std::move(chunk));
 					goto retry;
 				}
 
-				PQlogNoticeOf(source->base);
-				if (source->current != nullptr && !source->current->result.error())
-					VI_DEBUG("pq OK execute on 0x%" PRIXPTR " (%" PRIu64 " ms, rid: %" PRIu64 ")", (uintptr_t)source, source->current->get_timing(), source->current->id);
-
-				auto* ready_request = source->make_idle();
-				if (ready_request != nullptr)
+				if (source->pipelined)
 				{
-					core::codefer([ready_request]()
+					if (source->current != nullptr)
+						goto retry;
+#ifdef LIBPQ_HAS_PIPELINING
+					if (PQexitPipelineMode(source->base) == 1)
+						source->pipelined = false;
+#endif
+					PQlogNoticeOf(source->base);
+					source->make_idle();
+				}
+				else
+				{
+					if (source->current != nullptr && source->current->rows != nullptr)
 					{
-						core::uptr<request> item = ready_request;
-						item->report_cursor();
-					});
+						auto* stream = source->current->rows;
+						if (!stream->batch.empty())
+						{
+							stream->ready.push(std::move(stream->batch));
+							stream->batch.clear();
+						}
+
+						if (stream->delivering || !stream->ready.empty())
+						{
+							deliver(source, source->current);
+							stream->paused = true;
+							return true;
+						}
+					}
+
+					if (source->current != nullptr && source->current->copy != nullptr)
+					{
+						auto* stream = source->current->copy;
+						if (stream->delivering || !stream->ready.empty())
+						{
+							deliver(source, source->current);
+							stream->paused = true;
+							return true;
+						}
+					}
+
+					if (source->current != nullptr && source->current->preparing)
+					{
+						auto* context = source->current;
+						context->preparing = false;
+						if (!context->result.error())
+						{
+							source->statements[context->params->signature] = context->statement;
+							context->result.base.clear();
+							execute(source, context);
+							goto retry;
+						}
+
+						source->statements[context->params->signature] = core::string();
+						if (source->get_tx_state() != transaction_state::in_error)
+						{
+							VI_DEBUG("pq prepare failed on 0x%" PRIXPTR " (rid: %" PRIu64 "): falling back to text query", (uintptr_t)source, context->id);
+							context->result.base.clear();
+							execute(source, context);
+							goto retry;
+						}
+					}
+
+					PQlogNoticeOf(source->base);
+					if (source->current != nullptr && !source->current->result.error())
+						VI_DEBUG("pq OK execute on 0x%" PRIXPTR " (%" PRIu64 " ms, rid: %" PRIu64 ")", (uintptr_t)source, source->current->get_timing(), source->current->id);
+
+					auto* ready_request = source->make_idle();
+					if (ready_request != nullptr)
+					{
+						core::codefer([ready_request]()
+						{
+							core::uptr<request> item = ready_request;
+							item->report_cursor();
+						});
+					}
 				}
 				if (consume(source))
 					goto retry;
@@ -2478,6 +3809,52 @@ namespace vitex
 
 				return "NULL";
 			}
+			bool utils::copy_row(core::string& buffer, copy_format format, const core::variant_list& row, const core::vector<oid_type>& types)
+			{
+				size_t offset = buffer.size();
+				if (format == copy_format::binary)
+					copy_network(buffer, (uint64_t)row.size(), 2);
+
+				for (size_t i = 0; i < row.size(); i++)
+				{
+					if (i > 0 && format != copy_format::binary)
+						buffer.push_back(format == copy_format::csv ? ',' : '\t');
+
+					if (!copy_field(buffer, format, row[i], nullptr, types, i))
+					{
+						buffer.resize(offset);
+						return false;
+					}
+				}
+
+				if (format != copy_format::binary)
+					buffer.push_back('\n');
+				return true;
+			}
+			bool utils::copy_row(core::string& buffer, copy_format format, core::schema* row, const core::vector<oid_type>& types)
+			{
+				VI_ASSERT(row != nullptr, "row should be set");
+				size_t offset = buffer.size();
+				auto& childs = row->get_childs();
+				if (format == copy_format::binary)
+					copy_network(buffer, (uint64_t)childs.size(), 2);
+
+				for (size_t i = 0; i < childs.size(); i++)
+				{
+					if (i > 0 && format != copy_format::binary)
+						buffer.push_back(format == copy_format::csv ? ',' : '\t');
+
+					if (!copy_field(buffer, format, childs[i]->value, childs[i], types, i))
+					{
+						buffer.resize(offset);
+						return false;
+					}
+				}
+
+				if (format != copy_format::binary)
+					buffer.push_back('\n');
+				return true;
+			}
 
 			driver::driver() noexcept : active(false), logger(nullptr)
 			{
@@ -2589,6 +3966,8 @@ namespace vitex
 
 				if (variables.empty())
 					result.cache = result.request;
+				else
+					compile(result);
 
 				core::umutex<std::mutex> unique(exclusive);
 				queries[core::string(name)] = std::move(result);
@@ -2688,6 +4067,8 @@ namespace vitex
 						}
 					}
 
+					compile(result);
+
 					core::string name = data->get_var("name").get_blob();
 					queries[name] = std::move(result);
 					++count;
@@ -2815,6 +4196,103 @@ namespace vitex
 
 				return result;
 			}
+			expects_db<prepared_query> driver::get_prepared_query(const std::string_view& name, core::schema_args* map) noexcept
+			{
+				core::umutex<std::mutex> unique(exclusive);
+				auto it = queries.find(core::key_lookup_cast(name));
+				if (it == queries.end())
+					return database_exception("query not found: " + core::string(name));
+
+				if (it->second.prepared.empty())
+					return database_exception("query cannot be prepared: " + core::string(name));
+
+				prepared_query result;
+				core::vector<core::string> parameters = it->second.parameters;
+				result.positions.reserve(it->second.positions.size());
+				for (auto& word : it->second.positions)
+					result.positions.emplace_back(word.offset, (size_t)(std::find(parameters.begin(), parameters.end(), word.key) - parameters.begin()));
+				result.request = it->second.request;
+				result.command = it->second.prepared;
+				unique.negate();
+
+				result.signature.assign(name);
+				result.values.reserve(parameters.size());
+				result.types.reserve(parameters.size());
+				result.formats.reserve(parameters.size());
+				result.nulls.reserve(parameters.size());
+				result.literals.reserve(parameters.size());
+				for (auto& key : parameters)
+				{
+					auto value = map ? map->find(key) : core::schema_args::iterator();
+					if (!map || value == map->end())
+						return database_exception("query expects @" + key + " constant: " + core::string(name));
+
+					core::schema* source = *value->second;
+					core::string data;
+					uint32_t type = 0;
+					int format = 0;
+					bool literal = false;
+					bool null = false;
+					switch (source ? source->value.get_type() : core::var_type::null)
+					{
+						case core::var_type::object:
+							core::schema::convert_to_json(source, [&data](core::var_form, const std::string_view& buffer) { data.append(buffer); });
+							break;
+						case core::var_type::array:
+							return database_exception("query cannot be prepared: array parameter @" + key + " in " + core::string(name));
+						case core::var_type::string:
+							data = source->value.get_blob();
+							break;
+						case core::var_type::integer:
+							data = core::to_string(source->value.get_integer());
+							literal = true;
+							break;
+						case core::var_type::number:
+							data = core::to_string(source->value.get_number());
+							literal = true;
+							break;
+						case core::var_type::boolean:
+							data = source->value.get_boolean() ? "TRUE" : "FALSE";
+							type = (uint32_t)oid_type::boolf;
+							literal = true;
+							break;
+						case core::var_type::decimal:
+						{
+							core::decimal number = source->value.get_decimal();
+							if (!number.is_nan())
+							{
+								data = number.to_string();
+								if (data.find('.') == core::string::npos)
+									data.append(".0");
+								type = (uint32_t)oid_type::numeric;
+								literal = true;
+							}
+							else
+								null = true;
+							break;
+						}
+						case core::var_type::binary:
+							data = source->value.get_string();
+							type = (uint32_t)oid_type::bytea;
+							format = 1;
+							break;
+						case core::var_type::null:
+						case core::var_type::undefined:
+						default:
+							null = true;
+							break;
+					}
+
+					result.signature.append(1, ':').append(core::to_string(type));
+					result.values.emplace_back(std::move(data));
+					result.types.push_back(type);
+					result.formats.push_back(format);
+					result.nulls.push_back(null ? 1 : 0);
+					result.literals.push_back(literal ? 1 : 0);
+				}
+
+				return result;
+			}
 			core::vector<core::string> driver::get_queries() noexcept
 			{
 				core::vector<core::string> result;
@@ -2825,6 +4303,38 @@ namespace vitex
 
 				return result;
 			}
+			void driver::compile(sequence& base)
+			{
+				base.prepared.clear();
+				base.parameters.clear();
+				if (base.positions.empty())
+					return;
+
+				for (auto& word : base.positions)
+				{
+					if (!word.escape || word.negate)
+						return;
+				}
+
+				if (is_multi_statement(base.request))
+					return;
+
+				core::string result = base.request;
+				size_t offset = 0;
+				for (auto& word : base.positions)
+				{
+					auto it = std::find(base.parameters.begin(), base.parameters.end(), word.key);
+					size_t index = (size_t)(it - base.parameters.begin());
+					if (it == base.parameters.end())
+						base.parameters.push_back(word.key);
+
+					core::string value = "$" + core::to_string(index + 1);
+					result.insert(word.offset + offset, value);
+					offset += value.size();
+				}
+
+				base.prepared = std::move(result);
+			}
 		}
 	}
 }
@@ -32,6 +32,7 @@ namespace vitex
 			typedef std::function<void(const std::string_view&)> on_query_log;
 			typedef std::function<void(const notify&)> on_notification;
 			typedef std::function<void(cursor&)> on_result;
+			typedef std::function<bool(core::vector<response>&)> on_rows;
 			typedef connection* session_id;
 			typedef pg_conn tconnection;
 			typedef pg_result tresponse;
@@ -51,7 +52,9 @@ namespace vitex
 			{
 				cache_short = (1 << 0),
 				cache_mid = (1 << 1),
-				cache_long = (1 << 2)
+				cache_long = (1 << 2),
+				binary_results = (1 << 3),
+				no_pipeline = (1 << 4)
 			};
 
 			enum class address_op
@@ -95,7 +98,9 @@ namespace vitex
 				non_fatal_error,
 				fatal_error,
 				copy_both,
-				single_tuple
+				single_tuple,
+				pipeline_sync,
+				pipeline_aborted
 			};
 
 			enum class field_code
@@ -193,6 +198,13 @@ namespace vitex
 				busy_in_transaction
 			};
 
+			enum class copy_format
+			{
+				text,
+				csv,
+				binary
+			};
+
 			inline size_t operator |(query_op a, query_op b)
 			{
 				return static_cast<size_t>(static_cast<size_t>(a) | static_cast<size_t>(b));
@@ -212,6 +224,39 @@ namespace vitex
 			template <typename t, typename executor = core::parallel_executor>
 			using expects_promise_db = core::basic_promise<expects_db<t>, executor>;
 
+			typedef std::function<expects_db<bool>(core::string&)> on_copy_in;
+			typedef std::function<bool(const std::string_view&)> on_copy_out;
+
+			struct prepared_query
+			{
+				core::vector<std::pair<size_t, size_t>> positions;
+				core::vector<core::string> values;
+				core::vector<uint32_t> types;
+				core::vector<int> formats;
+				core::vector<uint8_t> nulls;
+				core::vector<uint8_t> literals;
+				core::string request;
+				core::string command;
+				core::string signature;
+			};
+
+			struct copy_stream
+			{
+				core::single_queue<core::string> ready;
+				on_copy_in producer;
+				on_copy_out consumer;
+				core::string buffer;
+				core::string error;
+				size_t offset = 0;
+				copy_format format = copy_format::text;
+				bool started = false;
+				bool finished = false;
+				bool cancelled = false;
+				bool delivering = false;
+				bool producing = false;
+				bool paused = false;
+			};
+
 			class address
 			{
 			private:
@@ -463,16 +508,30 @@ namespace vitex
 				}
 			};
 
+			struct row_stream
+			{
+				core::single_queue<core::vector<response>> ready;
+				core::vector<response> batch;
+				on_rows callback;
+				size_t batch_size = 1024;
+				bool delivering = false;
+				bool paused = false;
+				bool cancelled = false;
+			};
+
 			class connection final : public core::reference<connection>
 			{
 				friend cluster;
 
 			private:
+				core::unordered_map<core::string, core::string> statements;
 				core::unordered_set<core::string> listens;
+				core::single_queue<request*> pipeline;
 				tconnection* base;
 				socket* stream;
 				request* current;
 				query_state status;
+				bool pipelined;
 
 			public:
 				connection(tconnection* new_base, socket_t fd);
@@ -483,10 +542,12 @@ namespace vitex
 				query_state get_state() const;
 				transaction_state get_tx_state() const;
 				bool in_transaction() const;
+				bool in_pipeline() const;
 				bool busy() const;
 
 			private:
 				void make_busy(request* data);
+				request* make_next();
 				request* make_idle();
 				request* make_lost();
 			};
@@ -498,15 +559,21 @@ namespace vitex
 			private:
 				expects_promise_db<cursor> future;
 				core::vector<char> command;
+				core::string statement;
 				std::chrono::microseconds time;
+				prepared_query* params;
+				copy_stream* copy;
+				row_stream* rows;
 				session_id session;
 				on_result callback;
 				cursor result;
 				uint64_t id;
 				size_t options;
+				bool preparing;
 
 			public:
 				request(const std::string_view& commands, session_id new_session, caching status, uint64_t rid, size_t new_options);
+				~request() noexcept;
 				void report_cursor();
 				void report_failure();
 				cursor&& get_result();
@@ -521,16 +588,75 @@ namespace vitex
 			{
 				friend driver;
 
+			public:
+				struct cache_stats
+				{
+					uint64_t hits = 0;
+					uint64_t misses = 0;
+					uint64_t evictions = 0;
+					uint64_t coalesced = 0;
+					uint64_t invalidations = 0;
+					size_t entries = 0;
+					size_t bytes = 0;
+				};
+
+			private:
+				struct cache_oid
+				{
+					uint64_t low = 0;
+					uint64_t high = 0;
+
+					bool operator ==(const cache_oid& other) const
+					{
+						return low == other.low && high == other.high;
+					}
+				};
+
+				struct cache_oid_hasher
+				{
+					size_t operator()(const cache_oid& value) const noexcept
+					{
+						return (size_t)(value.low ^ value.high);
+					}
+				};
+
+				struct cache_entry
+				{
+					core::vector<core::string> tables;
+					cache_oid key;
+					cursor data;
+					int64_t expires = 0;
+					size_t bytes = 0;
+				};
+
+				struct cache_shard
+				{
+					core::linked_list<cache_entry> order;
+					core::unordered_map<cache_oid, core::linked_list<cache_entry>::iterator, cache_oid_hasher> index;
+					std::mutex context;
+					size_t bytes = 0;
+				};
+
 			private:
 				struct
 				{
-					core::unordered_map<core::string, std::pair<int64_t, cursor>> objects;
+					core::unordered_map<cache_oid, core::vector<expects_promise_db<cursor>>, cache_oid_hasher> flights;
+					core::vector<cache_shard*> shards;
+					core::string listener;
+					std::atomic<uint64_t> hits = 0;
+					std::atomic<uint64_t> misses = 0;
+					std::atomic<uint64_t> evictions = 0;
+					std::atomic<uint64_t> coalesced = 0;
+					std::atomic<uint64_t> invalidations = 0;
+					std::atomic<int64_t> next_cleanup = 0;
+					std::atomic<bool> invalidates = false;
 					std::mutex context;
 					uint64_t short_duration = 10;
 					uint64_t mid_duration = 30;
 					uint64_t long_duration = 60;
-					uint64_t cleanup_duration = 300;
-					int64_t next_cleanup = 0;
+					std::atomic<uint64_t> cleanup_duration = 300;
+					size_t capacity = 1024 * 1024 * 64;
+					uint64_t listener_id = 0;
 				} cache;
 
 			private:
@@ -539,6 +665,9 @@ namespace vitex
 				core::vector<request*> requests;
 				std::atomic<uint64_t> channel;
 				std::atomic<uint64_t> counter;
+				std::atomic<uint64_t> round_trips_saved;
+				std::atomic<size_t> pipeline_depth;
+				std::atomic<bool> auto_prepare;
 				std::recursive_mutex update;
 				on_reconnect reconnected;
 				address source;
@@ -547,9 +676,14 @@ namespace vitex
 				cluster();
 				~cluster() noexcept;
 				void clear_cache();
+				void invalidate_cache(const std::string_view& table);
 				void set_cache_cleanup(uint64_t interval);
+				void set_cache_capacity(size_t max_bytes);
+				expects_promise_db<void> set_cache_invalidation(const std::string_view& channel);
 				void set_cache_duration(query_op cache_id, uint64_t duration);
 				void set_when_reconnected(const on_reconnect& new_callback);
+				void set_auto_prepare(bool enabled);
+				void set_pipeline_depth(size_t max_depth);
 				uint64_t add_channel(const std::string_view& name, const on_notification& new_callback);
 				bool remove_channel(const std::string_view& name, uint64_t id);
 				expects_promise_db<session_id> tx_begin(isolation type);
@@ -564,20 +698,38 @@ namespace vitex
 				expects_promise_db<cursor> emplace_query(const std::string_view& command, core::schema_list* map, size_t query_ops = 0, session_id session = nullptr);
 				expects_promise_db<cursor> template_query(const std::string_view& name, core::schema_args* map, size_t query_ops = 0, session_id session = nullptr);
 				expects_promise_db<cursor> query(const std::string_view& command, size_t query_ops = 0, session_id session = nullptr);
+				expects_promise_db<cursor> stream_query(const std::string_view& command, on_rows&& callback, size_t batch_size = 1024, size_t query_ops = 0, session_id session = nullptr);
+				expects_promise_db<cursor> copy_in(const std::string_view& table, const core::vector<core::string>& columns, copy_format format, on_copy_in&& producer, session_id session = nullptr);
+				expects_promise_db<cursor> copy_out(const std::string_view& command, copy_format format, on_copy_out&& consumer, session_id session = nullptr);
 				connection* get_connection(query_state state);
 				connection* get_any_connection() const;
+				cache_stats get_cache_stats();
+				uint64_t get_round_trips_saved() const;
+				size_t get_pipeline_depth() const;
+				bool is_auto_prepare() const;
 				bool is_connected() const;
 
 			private:
-				core::string get_cache_oid(const std::string_view& payload, size_t query_opts);
-				bool get_cache(const std::string_view& cache_oid, cursor* data);
-				void set_cache(const std::string_view& cache_oid, cursor* data, size_t query_opts);
+				expects_promise_db<cursor> submit(const std::string_view& command, prepared_query* params, size_t query_ops, session_id session);
+				expects_promise_db<cursor> enqueue(request* next);
+				cache_oid get_cache_oid(const std::string_view& payload, size_t query_opts);
+				cache_shard* get_cache_shard(const cache_oid& key);
+				bool get_cache(const cache_oid& key, cursor* data);
+				void set_cache(const cache_oid& key, const std::string_view& command, cursor* data, size_t query_opts);
+				request* dequeue(connection* base, bool transactional, bool pipelinable);
 				bool reestablish(connection* base);
 				bool consume(connection* base);
+				bool pipeline(connection* base);
 				bool reprocess(connection* base);
+				bool execute(connection* base, request* context);
+				void unprepare(connection* base, request* context);
+				bool transfer(connection* base, query_exec status);
+				void deliver(connection* base, request* context);
+				void produce(connection* base, request* context);
 				bool flush(connection* base, bool listen_for_results);
 				bool dispatch(connection* base);
 				bool is_managing(session_id session);
+				bool is_pipelinable(connection* base, request* context);
 				connection* is_listens(const std::string_view& name);
 			};
 
@@ -589,6 +741,8 @@ namespace vitex
 				static core::string get_char_array(connection* base, const std::string_view& src) noexcept;
 				static core::string get_byte_array(connection* base, const std::string_view& src) noexcept;
 				static core::string get_sql(connection* base, core::schema* source, bool escape, bool negate) noexcept;
+				static bool copy_row(core::string& buffer, copy_format format, const core::variant_list& row, const core::vector<oid_type>& types = core::vector<oid_type>());
+				static bool copy_row(core::string& buffer, copy_format format, core::schema* row, const core::vector<oid_type>& types = core::vector<oid_type>());
 			};
 
 			class driver final : public core::singleton<driver>
@@ -605,7 +759,9 @@ namespace vitex
 				struct sequence
 				{
 					core::vector<pose> positions;
+					core::vector<core::string> parameters;
 					core::string request;
+					core::string prepared;
 					core::string cache;
 				};
 
@@ -630,7 +786,11 @@ namespace vitex
 				core::schema* get_cache_dump() noexcept;
 				expects_db<core::string> emplace(cluster* base, const std::string_view& SQL, core::schema_list* map) noexcept;
 				expects_db<core::string> get_query(cluster* base, const std::string_view& name, core::schema_args* map) noexcept;
+				expects_db<prepared_query> get_prepared_query(const std::string_view& name, core::schema_args* map) noexcept;
 				core::vector<core::string> get_queries() noexcept;
+
+			private:
+				static void compile(sequence& base);
 			};
 		}
 	}
@@ -5,6 +5,9 @@
 #include <sqlite3ext.h>
 #endif
 #endif
+#define STATEMENT_CACHE_SIZE 64
+#define ROUTE_CACHE_SIZE 4096
+#define PROGRESS_STEP_OPS 1000
 
 namespace vitex
 {
@@ -58,9 +61,10 @@ namespace vitex
 					VI_ASSERT(callable != nullptr, "callable is null");
 					utils::context_return(context, callable->value());
 				}
-				static expects_db<void> execute(sqlite3* handle, sqlite3_stmt* target, sqlite::response& response, uint64_t timeout)
+				static expects_db<void> execute(sqlite3* handle, sqlite3_stmt* target, sqlite::response& response, uint64_t timeout, size_t opts)
 				{
 					bool slept = false;
+					response.infer_types = opts & (size_t)query_op::infer_types;
 				next_returnable:
 					int code = sqlite3_step(target);
 					if (response.columns.empty())
@@ -71,57 +75,58 @@ namespace vitex
 							response.columns.reserve((int)columns);
 							for (int i = 0; i < columns; i++)
 								response.columns.push_back(sqlite3_column_name(target, i));
+							response.fields.resize(response.columns.size());
 						}
 					}
 					switch (code)
 					{
 						case SQLITE_ROW:
 						{
-							response.values.emplace_back();
-							auto& row = response.values.back();
-							if (!response.columns.empty())
+							int columns = (int)response.fields.size();
+							for (int i = 0; i < columns; i++)
 							{
-								int columns = (int)response.columns.size();
-								row.reserve(response.columns.size());
-								for (int i = 0; i < columns; i++)
+								auto& field = response.fields[i];
+								sqlite::response::cell value;
+								value.offset = 0;
+								uint32_t size = 0;
+								sqlite::response::storage type = sqlite::response::storage::null;
+								switch (sqlite3_column_type(target, i))
 								{
-									switch (sqlite3_column_type(target, i))
+									case SQLITE_INTEGER:
+										value.integer = sqlite3_column_int64(target, i);
+										type = sqlite::response::storage::integer;
+										break;
+									case SQLITE_FLOAT:
+										value.number = sqlite3_column_double(target, i);
+										type = sqlite::response::storage::number;
+										break;
+									case SQLITE_TEXT:
+									{
+										const char* text = (const char*)sqlite3_column_text(target, i);
+										size = (uint32_t)sqlite3_column_bytes(target, i);
+										value.offset = response.arena.size();
+										response.arena.append(text ? text : "", size);
+										type = sqlite::response::storage::text;
+										break;
+									}
+									case SQLITE_BLOB:
 									{
-										case SQLITE_INTEGER:
-											row.push_back(core::var::integer(sqlite3_column_int64(target, i)));
-											break;
-										case SQLITE_FLOAT:
-											row.push_back(core::var::number(sqlite3_column_double(target, i)));
-											break;
-										case SQLITE_TEXT:
-										{
-											std::string_view text((const char*)sqlite3_column_text(target, i), (size_t)sqlite3_column_bytes(target, i));
-											if (core::stringify::has_decimal(text))
-												row.push_back(core::var::decimal_string(text));
-											else if (core::stringify::has_integer(text))
-												row.push_back(core::var::integer(core::from_string<int64_t>(text).or_else(0)));
-											else if (core::stringify::has_number(text))
-												row.push_back(core::var::number(core::from_string<double>(text).or_else(0.0)));
-											else
-												row.push_back(core::var::string(text));
-											break;
-										}
-										case SQLITE_BLOB:
-										{
-											const uint8_t* blob = (const uint8_t*)sqlite3_column_blob(target, i);
-											size_t blob_size = (size_t)sqlite3_column_bytes(target, i);
-											row.push_back(core::var::binary(blob ? blob : (uint8_t*)"", blob_size));
-											break;
-										}
-										case SQLITE_NULL:
-											row.push_back(core::var::null());
-											break;
-										default:
-											row.push_back(core::var::undefined());
-											break;
+										const char* blob = (const char*)sqlite3_column_blob(target, i);
+										size = (uint32_t)sqlite3_column_bytes(target, i);
+										value.offset = response.arena.size();
+										response.arena.append(blob ? blob : "", size);
+										type = sqlite::response::storage::blob;
+										break;
 									}
+									case SQLITE_NULL:
+									default:
+										break;
 								}
+								field.data.push_back(value);
+								field.sizes.push_back(size);
+								field.types.push_back(type);
 							}
+							++response.rows;
 							goto next_returnable;
 						}
 						case SQLITE_DONE:
@@ -149,6 +154,72 @@ namespace vitex
 					response.status_message = error == SQLITE_OK ? sqlite3_errstr(code) : sqlite3_errmsg(handle);
 					return database_exception(core::string(response.status_message));
 				}
+				static expects_db<sqlite3_stmt*> prepare(sqlite3* handle, const std::string_view& command, size_t* length, sqlite::response& response)
+				{
+					const char* trailing_statement = nullptr;
+					sqlite3_stmt* target = nullptr;
+					int code = sqlite3_prepare_v3(handle, command.data(), (int)command.size(), SQLITE_PREPARE_PERSISTENT, &target, &trailing_statement);
+					*length = (trailing_statement && trailing_statement > command.data() ? trailing_statement - command.data() : command.size());
+					if (code == SQLITE_OK)
+						return target;
+
+					int error = sqlite3_errcode(handle);
+					response.status_code = error == SQLITE_OK ? code : error;
+					response.status_message = error == SQLITE_OK ? sqlite3_errstr(code) : sqlite3_errmsg(handle);
+					if (target != nullptr)
+						sqlite3_finalize(target);
+					return database_exception(core::string(response.status_message));
+				}
+				static expects_db<void> bind(sqlite3_stmt* target, prepared_query* params, core::vector<core::string>& temps)
+				{
+					int count = sqlite3_bind_parameter_count(target);
+					for (int i = 1; i <= count; i++)
+					{
+						if (!sqlite3_bind_parameter_name(target, i))
+							continue;
+						else if ((size_t)i > params->values.size())
+							return database_exception("query expects at least " + core::to_string(i) + " arguments");
+
+						auto status = connection::bind_variant(target, (size_t)i - 1, params->values[(size_t)i - 1], temps);
+						if (!status)
+							return status;
+					}
+					return core::expectation::met;
+				}
+				static int progress_call(void* user_data)
+				{
+					query_token* token = (query_token*)user_data;
+					VI_ASSERT(token != nullptr, "token is null");
+					return token->is_expired() ? 1 : 0;
+				}
+				static database_exception cancellation(query_token* token)
+				{
+					return database_exception(token->is_cancelled() ? "query cancelled" : "query timeout");
+				}
+				static bool is_single(const std::string_view& command, size_t length)
+				{
+					for (size_t i = length; i < command.size(); i++)
+					{
+						char next = command[i];
+						if (!core::stringify::is_whitespace(next) && next != ';')
+							return false;
+					}
+					return true;
+				}
+				static bool is_control(const std::string_view& command, size_t length)
+				{
+					size_t start = 0;
+					while (start < length && core::stringify::is_whitespace(command[start]))
+						++start;
+
+					size_t end = start;
+					while (end < length && isalpha((uint8_t)command[end]))
+						++end;
+
+					core::string keyword = core::string(command.substr(start, end - start));
+					core::stringify::to_lower(keyword);
+					return keyword == "begin" || keyword == "commit" || keyword == "end" || keyword == "rollback" || keyword == "savepoint" || keyword == "release" || keyword == "attach" || keyword == "detach" || keyword == "pragma" || keyword == "vacuum" || keyword == "reindex" || keyword == "analyze";
+				}
 			};
 #endif
 			database_exception::database_exception(tconnection* connection)
@@ -195,7 +266,7 @@ namespace vitex
 				if (!base || row_index == std::numeric_limits<size_t>::max() || column_index == std::numeric_limits<size_t>::max())
 					return core::var::undefined();
 
-				return base->values[row_index][column_index];
+				return base->get_value(row_index, column_index);
 			}
 			core::schema* column::get_inline() const
 			{
@@ -205,8 +276,7 @@ namespace vitex
 				if (nullable())
 					return nullptr;
 
-				auto& column = base->values[row_index][column_index];
-				return utils::get_schema_from_value(column);
+				return utils::get_schema_from_value(base->get_value(row_index, column_index));
 			}
 			size_t column::index() const
 			{
@@ -217,14 +287,14 @@ namespace vitex
 				if (!base || row_index == std::numeric_limits<size_t>::max() || column_index == std::numeric_limits<size_t>::max())
 					return 0;
 
-				return base->values[row_index].size();
+				return base->fields.size();
 			}
 			size_t column::raw_size() const
 			{
 				VI_ASSERT(base != nullptr, "context should be valid");
 				VI_ASSERT(row_index != std::numeric_limits<size_t>::max(), "row should be valid");
 				VI_ASSERT(column_index != std::numeric_limits<size_t>::max(), "column should be valid");
-				return base->values[row_index][column_index].size();
+				return base->get_value_size(row_index, column_index);
 			}
 			row column::get_row() const
 			{
@@ -237,8 +307,7 @@ namespace vitex
 				if (!base || row_index == std::numeric_limits<size_t>::max() || column_index == std::numeric_limits<size_t>::max())
 					return true;
 
-				auto& column = base->values[row_index][column_index];
-				return column.is(core::var_type::null) || column.is(core::var_type::undefined);
+				return base->is_value_null(row_index, column_index);
 			}
 
 			row::row(const response* new_base, size_t fRowIndex) : base((response*)new_base), row_index(fRowIndex)
@@ -249,11 +318,11 @@ namespace vitex
 				if (!base || row_index == std::numeric_limits<size_t>::max())
 					return nullptr;
 
-				auto& row = base->values[row_index];
+				size_t size = base->fields.size();
 				core::schema* result = core::var::set::object();
-				result->get_childs().reserve(row.size());
-				for (size_t j = 0; j < row.size(); j++)
-					result->set(j < base->columns.size() ? base->columns[j] : core::to_string(j), utils::get_schema_from_value(row[j]));
+				result->get_childs().reserve(size);
+				for (size_t j = 0; j < size; j++)
+					result->set(j < base->columns.size() ? base->columns[j] : core::to_string(j), utils::get_schema_from_value(base->get_value(row_index, j)));
 
 				return result;
 			}
@@ -262,11 +331,11 @@ namespace vitex
 				if (!base || row_index == std::numeric_limits<size_t>::max())
 					return nullptr;
 
-				auto& row = base->values[row_index];
+				size_t size = base->fields.size();
 				core::schema* result = core::var::set::array();
-				result->get_childs().reserve(row.size());
-				for (auto& column : row)
-					result->push(utils::get_schema_from_value(column));
+				result->get_childs().reserve(size);
+				for (size_t j = 0; j < size; j++)
+					result->push(utils::get_schema_from_value(base->get_value(row_index, j)));
 
 				return result;
 			}
@@ -279,18 +348,17 @@ namespace vitex
 				if (!base || row_index == std::numeric_limits<size_t>::max())
 					return 0;
 
-				if (row_index >= base->values.size())
+				if (row_index >= base->rows)
 					return 0;
 
-				auto& row = base->values[row_index];
-				return row.size();
+				return base->fields.size();
 			}
 			column row::get_column(size_t index) const
 			{
 				if (!base || row_index == std::numeric_limits<size_t>::max() || index >= base->columns.size())
 					return column(base, std::numeric_limits<size_t>::max(), std::numeric_limits<size_t>::max());
 
-				if (index >= base->values[row_index].size())
+				if (index >= base->fields.size())
 					return column(base, std::numeric_limits<size_t>::max(), std::numeric_limits<size_t>::max());
 
 				return column(base, row_index, index);
@@ -301,7 +369,7 @@ namespace vitex
 					return column(base, std::numeric_limits<size_t>::max(), std::numeric_limits<size_t>::max());
 
 				size_t index = base->get_column_index(name);
-				if (index >= base->values[row_index].size())
+				if (index >= base->fields.size())
 					return column(base, std::numeric_limits<size_t>::max(), std::numeric_limits<size_t>::max());
 
 				return column(base, row_index, index);
@@ -322,16 +390,16 @@ namespace vitex
 			core::schema* response::get_array_of_objects() const
 			{
 				core::schema* result = core::var::set::array();
-				if (values.empty() || columns.empty())
+				if (!rows || columns.empty())
 					return result;
 
-				result->reserve(values.size());
-				for (auto& row : values)
+				result->reserve(rows);
+				for (size_t i = 0; i < rows; i++)
 				{
 					core::schema* subresult = core::var::set::object();
-					subresult->get_childs().reserve(row.size());
-					for (size_t j = 0; j < row.size(); j++)
-						subresult->set(j < columns.size() ? columns[j] : core::to_string(j), utils::get_schema_from_value(row[j]));
+					subresult->get_childs().reserve(fields.size());
+					for (size_t j = 0; j < fields.size(); j++)
+						subresult->set(j < columns.size() ? columns[j] : core::to_string(j), utils::get_schema_from_value(get_value(i, j)));
 					result->push(subresult);
 				}
 
@@ -340,16 +408,16 @@ namespace vitex
 			core::schema* response::get_array_of_arrays() const
 			{
 				core::schema* result = core::var::set::array();
-				if (values.empty())
+				if (!rows)
 					return result;
 
-				result->reserve(values.size());
-				for (auto& row : values)
+				result->reserve(rows);
+				for (size_t i = 0; i < rows; i++)
 				{
 					core::schema* subresult = core::var::set::array();
-					subresult->get_childs().reserve(row.size());
-					for (auto& column : row)
-						subresult->push(utils::get_schema_from_value(column));
+					subresult->get_childs().reserve(fields.size());
+					for (size_t j = 0; j < fields.size(); j++)
+						subresult->push(utils::get_schema_from_value(get_value(i, j)));
 					result->push(subresult);
 				}
 
@@ -396,11 +464,11 @@ namespace vitex
 			}
 			size_t response::size() const
 			{
-				return values.size();
+				return rows;
 			}
 			row response::get_row(size_t index) const
 			{
-				if (index >= values.size())
+				if (index >= rows)
 					return row(this, std::numeric_limits<size_t>::max());
 
 				return row(this, index);
@@ -425,7 +493,7 @@ namespace vitex
 			}
 			bool response::empty() const
 			{
-				return values.empty();
+				return !rows;
 			}
 			bool response::error() const
 			{
@@ -435,6 +503,67 @@ namespace vitex
 				return !status_message.empty() && status_code != 0;
 #endif
 			}
+			core::variant response::get_value(size_t row_index, size_t column_index) const
+			{
+				if (row_index >= rows || column_index >= fields.size())
+					return core::var::undefined();
+
+				auto& field = fields[column_index];
+				auto& value = field.data[row_index];
+				switch (field.types[row_index])
+				{
+					case storage::integer:
+						return core::var::integer(value.integer);
+					case storage::number:
+						return core::var::number(value.number);
+					case storage::text:
+					{
+						std::string_view text(arena.data() + value.offset, (size_t)field.sizes[row_index]);
+						if (!infer_types)
+							return core::var::string(text);
+						else if (core::stringify::has_decimal(text))
+							return core::var::decimal_string(text);
+						else if (core::stringify::has_integer(text))
+							return core::var::integer(core::from_string<int64_t>(text).or_else(0));
+						else if (core::stringify::has_number(text))
+							return core::var::number(core::from_string<double>(text).or_else(0.0));
+
+						return core::var::string(text);
+					}
+					case storage::blob:
+						return core::var::binary((const uint8_t*)arena.data() + value.offset, (size_t)field.sizes[row_index]);
+					case storage::null:
+					default:
+						return core::var::null();
+				}
+			}
+			size_t response::get_value_size(size_t row_index, size_t column_index) const
+			{
+				if (row_index >= rows || column_index >= fields.size())
+					return 0;
+
+				auto& field = fields[column_index];
+				switch (field.types[row_index])
+				{
+					case storage::integer:
+						return sizeof(int64_t);
+					case storage::number:
+						return sizeof(double);
+					case storage::text:
+					case storage::blob:
+						return (size_t)field.sizes[row_index];
+					case storage::null:
+					default:
+						return 0;
+				}
+			}
+			bool response::is_value_null(size_t row_index, size_t column_index) const
+			{
+				if (row_index >= rows || column_index >= fields.size())
+					return true;
+
+				return fields[column_index].types[row_index] == storage::null;
+			}
 
 			cursor::cursor() : cursor(nullptr)
 			{
@@ -563,7 +692,130 @@ namespace vitex
 				return base[response_index].get_array(index);
 			}
 
-			connection::connection() : handle(nullptr), timeout(0)
+			query_token::query_token(uint64_t timeout_ms) noexcept : deadline(0), cancelled(false)
+			{
+				set_timeout(timeout_ms);
+			}
+			void query_token::cancel() noexcept
+			{
+				cancelled = true;
+			}
+			void query_token::set_timeout(uint64_t timeout_ms) noexcept
+			{
+				if (!timeout_ms)
+				{
+					deadline = 0;
+					return;
+				}
+
+				int64_t time = (int64_t)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+				deadline = time + (int64_t)timeout_ms;
+			}
+			bool query_token::is_cancelled() const noexcept
+			{
+				return cancelled;
+			}
+			bool query_token::is_expired() const noexcept
+			{
+				if (cancelled)
+					return true;
+
+				int64_t limit = deadline;
+				if (!limit)
+					return false;
+
+				int64_t time = (int64_t)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+				return time >= limit;
+			}
+
+			statement_cache::statement_cache(size_t max_statements) noexcept : capacity(max_statements)
+			{
+			}
+			statement_cache::~statement_cache() noexcept
+			{
+				clear();
+			}
+			tstatement* statement_cache::acquire(const std::string_view& command, size_t* length) noexcept
+			{
+				VI_ASSERT(length != nullptr, "length should be set");
+				auto it = index.find(command);
+				if (it == index.end() || it->second->busy)
+					return nullptr;
+
+				auto& item = *it->second;
+				items.splice(items.begin(), items, it->second);
+				item.busy = true;
+				*length = item.length;
+				return item.statement;
+			}
+			void statement_cache::release(const std::string_view& command, tstatement* statement, size_t length) noexcept
+			{
+				VI_ASSERT(statement != nullptr, "statement should be set");
+#ifdef VI_SQLITE
+				sqlite3_reset(statement);
+				sqlite3_clear_bindings(statement);
+				auto it = index.find(command);
+				if (it != index.end())
+				{
+					if (it->second->statement == statement)
+						it->second->busy = false;
+					else
+						sqlite3_finalize(statement);
+					return;
+				}
+				else if (!capacity)
+				{
+					sqlite3_finalize(statement);
+					return;
+				}
+
+				items.emplace_front();
+				auto& item = items.front();
+				item.command = command;
+				item.statement = statement;
+				item.length = length;
+				index[item.command] = items.begin();
+				resize(capacity);
+#endif
+			}
+			void statement_cache::resize(size_t max_statements) noexcept
+			{
+				capacity = max_statements;
+#ifdef VI_SQLITE
+				auto it = items.end();
+				while (items.size() > capacity && it != items.begin())
+				{
+					if ((--it)->busy)
+						continue;
+
+					index.erase(it->command);
+					sqlite3_finalize(it->statement);
+					it = items.erase(it);
+				}
+#endif
+			}
+			void statement_cache::clear() noexcept
+			{
+#ifdef VI_SQLITE
+				for (auto& item : items)
+				{
+					if (!item.busy)
+						sqlite3_finalize(item.statement);
+				}
+#endif
+				index.clear();
+				items.clear();
+			}
+			size_t statement_cache::size() const noexcept
+			{
+				return items.size();
+			}
+			size_t statement_cache::get_capacity() const noexcept
+			{
+				return capacity;
+			}
+
+			connection::connection() : cache(STATEMENT_CACHE_SIZE), handle(nullptr), timeout(0)
 			{
 				library_handle = driver::get();
 				if (library_handle != nullptr)
@@ -574,6 +826,7 @@ namespace vitex
 #ifdef VI_SQLITE
 				for (auto& item : statements)
 					sqlite3_finalize(item.second);
+				cache.clear();
 				if (handle != nullptr)
 				{
 					sqlite3_close(handle);
@@ -749,6 +1002,16 @@ namespace vitex
 				return 0;
 #endif
 			}
+			void connection::set_statement_cache_size(size_t max_statements)
+			{
+				core::umutex<std::mutex> unique(update);
+				cache.resize(max_statements);
+			}
+			size_t connection::get_statement_cache_size()
+			{
+				core::umutex<std::mutex> unique(update);
+				return cache.get_capacity();
+			}
 			expects_db<void> connection::bind_null(tstatement* statement, size_t index)
 			{
 				VI_ASSERT(statement != nullptr, "statement should not be empty");
@@ -873,6 +1136,36 @@ namespace vitex
 				temps.push_back(std::move(numeric));
 				return bind_string(statement, index, temps.back());
 			}
+			expects_db<void> connection::bind_variant(tstatement* statement, size_t index, const core::variant& value, core::vector<core::string>& temps)
+			{
+				switch (value.get_type())
+				{
+					case core::var_type::pointer:
+						return bind_pointer(statement, index, value.get_pointer());
+					case core::var_type::string:
+						return bind_string(statement, index, value.get_string());
+					case core::var_type::binary:
+						return bind_blob(statement, index, value.get_string());
+					case core::var_type::integer:
+						return bind_int64(statement, index, value.get_integer());
+					case core::var_type::number:
+						return bind_double(statement, index, value.get_number());
+					case core::var_type::boolean:
+						return bind_boolean(statement, index, value.get_boolean());
+					case core::var_type::decimal:
+					{
+						core::decimal number = value.get_decimal();
+						if (number.is_nan())
+							return bind_null(statement, index);
+
+						return bind_decimal(statement, index, number, temps);
+					}
+					case core::var_type::null:
+					case core::var_type::undefined:
+					default:
+						return bind_null(statement, index);
+				}
+			}
 			expects_db<tstatement*> connection::prepare_statement(const std::string_view& command, std::string_view* leftover_command)
 			{
 #ifdef VI_SQLITE
@@ -991,6 +1284,7 @@ namespace vitex
 					return expects_db<void>(database_exception("disconnect: not connected"));
 
 				core::umutex<std::mutex> unique(update);
+				cache.clear();
 				if (handle != nullptr)
 				{
 					sqlite3_close(handle);
@@ -1031,7 +1325,7 @@ namespace vitex
 
 				cursor result(handle);
 				result.base.emplace_back();
-				auto status = sqlite3_util::execute(handle, statement, result.base.back(), timeout);
+				auto status = sqlite3_util::execute(handle, statement, result.base.back(), timeout, 0);
 				sqlite3_reset(statement);
 				if (!status)
 					return status.error();
@@ -1053,6 +1347,10 @@ namespace vitex
 			expects_db<cursor> connection::template_query(const std::string_view& name, core::schema_args* map, size_t opts, session_id session)
 			{
 				VI_DEBUG("sqlite template query %s", name.empty() ? "empty-query-name" : core::string(name).c_str());
+				auto params = driver::get()->get_prepared_query(name, map);
+				if (params)
+					return submit(params->command, &*params, opts, session);
+
 				auto pattern = driver::get()->get_query(name, map);
 				if (!pattern)
 					return expects_db<cursor>(pattern.error());
@@ -1060,6 +1358,10 @@ namespace vitex
 				return query(*pattern, opts, session);
 			}
 			expects_db<cursor> connection::query(const std::string_view& command, size_t opts, session_id session)
+			{
+				return submit(command, nullptr, opts, session);
+			}
+			expects_db<cursor> connection::submit(const std::string_view& command, sqlite::prepared_query* params, size_t opts, session_id session)
 			{
 				VI_ASSERT(!command.empty(), "command should not be empty");
 #ifdef VI_SQLITE
@@ -1070,33 +1372,46 @@ namespace vitex
 				auto time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch());
 				VI_DEBUG("sqlite execute query on 0x%" PRIXPTR "%s: %.64s%s", (uintptr_t)handle, session ? " (transaction)" : "", command.data(), command.size() > 64 ? " ..." : "");
 
+				core::vector<core::string> temps;
 				size_t offset = 0;
 				cursor result(handle);
 				while (offset < command.size())
 				{
 					VI_MEASURE(core::timings::intensive);
-					const char* trailing_statement = nullptr;
-					sqlite3_stmt* target = nullptr;
-					int code = sqlite3_prepare_v2(handle, command.data() + offset, (int)(command.size() - offset), &target, &trailing_statement);
-					offset = (trailing_statement ? trailing_statement - command.data() : command.size());
+					std::string_view next = command.substr(offset);
+					size_t length = 0;
+					core::umutex<std::mutex> unique(update);
+					tstatement* target = cache.acquire(next, &length);
+					unique.negate();
+
 					result.base.emplace_back();
-					if (code != SQLITE_OK)
-					{
-						int error = sqlite3_errcode(handle);
-						auto& response = result.base.back();
-						response.status_code = error == SQLITE_OK ? code : error;
-						response.status_message = error == SQLITE_OK ? sqlite3_errstr(code) : sqlite3_errmsg(handle);
-						if (target != nullptr)
-							sqlite3_finalize(target);
-						return database_exception(core::string(response.status_message));
-					}
-					else
+					if (!target)
 					{
-						auto status = sqlite3_util::execute(handle, target, result.base.back(), timeout);
-						sqlite3_finalize(target);
+						auto status = sqlite3_util::prepare(handle, next, &length, result.base.back());
 						if (!status)
 							return status.error();
+
+						target = *status;
 					}
+
+					offset += length;
+					if (!target)
+					{
+						result.base.pop_back();
+						continue;
+					}
+
+					expects_db<void> status = core::expectation::met;
+					if (params != nullptr)
+						status = sqlite3_util::bind(target, params, temps);
+					if (status)
+						status = sqlite3_util::execute(handle, target, result.base.back(), timeout, opts);
+
+					unique.negate();
+					cache.release(next, target, length);
+					unique.negate();
+					if (!status)
+						return status.error();
 				}
 
 				VI_DEBUG("sqlite OK execute on 0x%" PRIXPTR " (%" PRIu64 " ms)", (uintptr_t)handle, (uint64_t)(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()) - time).count()); (void)time;
@@ -1119,7 +1434,7 @@ namespace vitex
 				return handle != nullptr;
 			}
 
-			cluster::cluster() : timeout(0)
+			cluster::cluster() : timeout(0), cache_size(STATEMENT_CACHE_SIZE), group_size(0), routing(false), committing(false)
 			{
 				library_handle = driver::get();
 				if (library_handle != nullptr)
@@ -1127,7 +1442,16 @@ namespace vitex
 			}
 			cluster::~cluster() noexcept
 			{
+				stop_io();
 #ifdef VI_SQLITE
+				clear_statements();
+				while (!writes.empty())
+				{
+					auto* item = writes.front();
+					item->future.set(database_exception("group commit error: cluster destroyed"));
+					core::memory::deinit(item);
+					writes.pop();
+				}
 				for (auto* item : idle)
 					sqlite3_close(item);
 				for (auto* item : busy)
@@ -1271,6 +1595,53 @@ namespace vitex
 				return 0;
 #endif
 			}
+			void cluster::set_statement_cache_size(size_t max_statements)
+			{
+				core::umutex<std::mutex> unique(update);
+				cache_size = max_statements;
+				for (auto& item : caches)
+					item.second->resize(max_statements);
+			}
+			void cluster::set_wal_routing(bool enabled)
+			{
+				core::umutex<std::mutex> unique(update);
+				routing = enabled;
+				routes.clear();
+			}
+			void cluster::set_group_commit(size_t max_statements)
+			{
+				core::umutex<std::mutex> unique(update);
+				group_size = max_statements;
+			}
+			void cluster::set_io_threads(size_t count)
+			{
+				stop_io();
+				core::umutex<std::mutex> unique(workers.mutex);
+				workers.stopping = false;
+				workers.threads.reserve(count);
+				for (size_t i = 0; i < count; i++)
+					workers.threads.emplace_back(&cluster::io_loop, this);
+			}
+			size_t cluster::get_statement_cache_size()
+			{
+				core::umutex<std::mutex> unique(update);
+				return cache_size;
+			}
+			size_t cluster::get_io_threads()
+			{
+				core::umutex<std::mutex> unique(workers.mutex);
+				return workers.threads.size();
+			}
+			size_t cluster::get_group_commit()
+			{
+				core::umutex<std::mutex> unique(update);
+				return group_size;
+			}
+			bool cluster::is_wal_routing()
+			{
+				core::umutex<std::mutex> unique(update);
+				return routing;
+			}
 			expects_promise_db<session_id> cluster::tx_begin(isolation type)
 			{
 				switch (type)
@@ -1336,6 +1707,9 @@ namespace vitex
 				}
 
 				core::umutex<std::mutex> unique(update);
+				if (routing && is_in_memory)
+					return expects_promise_db<void>(database_exception("connect failed: wal routing requires a database file"));
+
 				source = location;
 				unique.negate();
 
@@ -1349,14 +1723,19 @@ namespace vitex
 						flags |= SQLITE_OPEN_MEMORY;
 
 					core::umutex<std::mutex> unique(update);
-					idle.reserve(connections);
-					busy.reserve(connections);
+					size_t count = routing ? connections + 1 : connections;
+					idle.reserve(count);
+					busy.reserve(count);
 
-					for (size_t i = 0; i < connections; i++)
+					for (size_t i = 0; i < count; i++)
 					{
 						VI_DEBUG("sqlite try connect to %s", source.c_str());
+						bool reader = routing && i > 0;
 						tconnection* connection = nullptr;
-						int code = sqlite3_open_v2(source.c_str(), &connection, flags, nullptr);
+						int code = sqlite3_open_v2(source.c_str(), &connection, reader ? SQLITE_OPEN_READONLY | SQLITE_OPEN_URI | SQLITE_OPEN_NOMUTEX : flags, nullptr);
+						if (code == SQLITE_OK && routing && !reader)
+							code = sqlite3_exec(connection, "PRAGMA journal_mode=WAL", nullptr, nullptr, nullptr);
+
 						if (code != SQLITE_OK)
 						{
 							database_exception error(connection);
@@ -1365,7 +1744,10 @@ namespace vitex
 							return error;
 						}
 
-						VI_DEBUG("sqlite OK open database on 0x%" PRIXPTR, (uintptr_t)connection);
+						VI_DEBUG("sqlite OK open database on 0x%" PRIXPTR "%s", (uintptr_t)connection, routing ? (reader ? " (reader)" : " (writer)") : "");
+						caches[connection] = core::memory::init<statement_cache>(cache_size);
+						if (reader)
+							readers.insert(connection);
 						idle.insert(connection);
 					}
 
@@ -1383,7 +1765,10 @@ namespace vitex
 
 				return core::cotask<expects_db<void>>([this]() -> expects_db<void>
 				{
+					clear_statements();
 					core::umutex<std::mutex> unique(update);
+					routes.clear();
+					readers.clear();
 					for (auto* item : idle)
 						sqlite3_close(item);
 					for (auto* item : busy)
@@ -1417,88 +1802,443 @@ namespace vitex
 				return expects_promise_db<void>(database_exception("flush: not supported"));
 #endif
 			}
-			expects_promise_db<cursor> cluster::emplace_query(const std::string_view& command, core::schema_list* map, size_t opts, session_id session)
+			expects_promise_db<cursor> cluster::emplace_query(const std::string_view& command, core::schema_list* map, size_t opts, session_id session, query_token* token)
 			{
 				auto pattern = driver::get()->emplace(command, map);
 				if (!pattern)
 					return expects_promise_db<cursor>(pattern.error());
 
-				return query(*pattern, opts, session);
+				return query(*pattern, opts, session, token);
 			}
-			expects_promise_db<cursor> cluster::template_query(const std::string_view& name, core::schema_args* map, size_t opts, session_id session)
+			expects_promise_db<cursor> cluster::template_query(const std::string_view& name, core::schema_args* map, size_t opts, session_id session, query_token* token)
 			{
 				VI_DEBUG("sqlite template query %s", name.empty() ? "empty-query-name" : core::string(name).c_str());
+				auto params = driver::get()->get_prepared_query(name, map);
+				if (params)
+					return submit(params->command, &*params, opts, session, token);
+
 				auto pattern = driver::get()->get_query(name, map);
 				if (!pattern)
 					return expects_promise_db<cursor>(pattern.error());
 
-				return query(*pattern, opts, session);
+				return query(*pattern, opts, session, token);
 			}
-			expects_promise_db<cursor> cluster::query(const std::string_view& command, size_t opts, session_id session)
+			expects_promise_db<cursor> cluster::query(const std::string_view& command, size_t opts, session_id session, query_token* token)
+			{
+				return submit(command, nullptr, opts, session, token);
+			}
+			cluster::io_stats cluster::get_io_stats()
+			{
+				io_stats result;
+				core::umutex<std::mutex> unique(workers.mutex);
+				result.completed = workers.completed;
+				result.cancelled = workers.cancelled;
+				result.threads = workers.threads.size();
+				result.queued = workers.tasks.size();
+				result.active = workers.active;
+				result.peak_queued = workers.peak_queued;
+				return result;
+			}
+			expects_promise_db<cursor> cluster::submit(const std::string_view& command, prepared_query* params, size_t opts, session_id session, query_token* token)
 			{
 				VI_ASSERT(!command.empty(), "command should not be empty");
 #ifdef VI_SQLITE
 				core::string copy = core::string(command);
+				prepared_query values = params ? std::move(*params) : prepared_query();
+				bool parameterized = params != nullptr;
+				if (token != nullptr)
+					token->add_ref();
+
+				core::uref<query_token> control = token;
 				driver::get()->log_query(command);
-				return core::coasync<expects_db<cursor>>([this, copy = std::move(copy), opts, session]() mutable -> expects_promise_db<cursor>
+				return core::coasync<expects_db<cursor>>([this, copy = std::move(copy), values = std::move(values), control = std::move(control), parameterized, opts, session]() mutable -> expects_promise_db<cursor>
 				{
 					std::string_view command = copy;
-					tconnection* connection = VI_AWAIT(acquire_connection(session, opts));
+					tconnection* connection = nullptr;
+					route target = get_route(command, opts, session);
+					if (target == route::unknown)
+					{
+						connection = VI_AWAIT(acquire_connection(session, opts, true));
+						if (!connection)
+							coreturn expects_db<cursor>(database_exception("acquire connection error: no candidate"));
+
+						target = classify(connection, command);
+						if (target != route::read)
+						{
+							release_connection(connection, opts);
+							connection = nullptr;
+						}
+					}
+
+					if (target == route::write && group_size > 0)
+						coreturn VI_AWAIT(enqueue_write(std::move(copy), std::move(values), parameterized, opts, *control));
+
 					if (!connection)
-						coreturn expects_db<cursor>(database_exception("acquire connection error: no candidate"));
+					{
+						connection = VI_AWAIT(acquire_connection(session, opts, target == route::read));
+						if (!connection)
+							coreturn expects_db<cursor>(database_exception("acquire connection error: no candidate"));
+					}
 
 					auto time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch());
 					VI_DEBUG("sqlite execute query on 0x%" PRIXPTR "%s: %.64s%s", (uintptr_t)connection, session ? " (transaction)" : "", command.data(), command.size() > 64 ? " ..." : "");
 
-					size_t queries = 0, offset = 0;
-					cursor result(connection);
+					expects_promise_db<cursor> future;
+					prepared_query* args = parameterized ? &values : nullptr;
+					query_token* token = *control;
+					dispatch_io([this, future, connection, command, args, opts, token]() mutable { future.set(execute_command(connection, command, args, opts, token)); });
+
+					auto result = VI_AWAIT(std::move(future));
+					VI_DEBUG("sqlite %s execute on 0x%" PRIXPTR " (%" PRIu64 " ms)", result ? "OK" : "FAIL", (uintptr_t)connection, (uint64_t)(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()) - time).count());
+					release_connection(connection, opts); (void)time;
+					coreturn result;
+				});
+#else
+				return expects_promise_db<cursor>(database_exception("query: not supported"));
+#endif
+			}
+			expects_promise_db<cursor> cluster::enqueue_write(core::string&& command, prepared_query&& params, bool parameterized, size_t opts, query_token* token)
+			{
+				if (token != nullptr)
+					token->add_ref();
+
+				group_write* next = core::memory::init<group_write>();
+				next->token = token;
+				next->command = std::move(command);
+				next->params = std::move(params);
+				next->parameterized = parameterized;
+				next->opts = opts;
+
+				auto future = next->future;
+				core::umutex<std::mutex> unique(update);
+				writes.push(next);
+				if (committing)
+					return future;
+
+				committing = true;
+				unique.negate();
+				dispatch_writes();
+				return future;
+			}
+			expects_db<cursor> cluster::execute_command(tconnection* connection, const std::string_view& command, prepared_query* params, size_t opts, query_token* token)
+			{
+#ifdef VI_SQLITE
+				if (token != nullptr)
+				{
+					if (token->is_expired())
+					{
+						core::umutex<std::mutex> unique(workers.mutex);
+						++workers.cancelled;
+						return sqlite3_util::cancellation(token);
+					}
+					sqlite3_progress_handler(connection, PROGRESS_STEP_OPS, &sqlite3_util::progress_call, token);
+				}
+
+				expects_db<bool> status = true;
+				cursor result(connection);
+				size_t offset = 0;
+				while (offset < command.size())
+				{
+					size_t length = 0;
+					status = execute_statement(connection, command.substr(offset), params, opts, result, &length);
+					offset += length;
+					if (!status || !*status)
+						break;
+				}
+
+				if (token != nullptr)
+				{
+					sqlite3_progress_handler(connection, 0, nullptr, nullptr);
+					if ((!status || !*status) && token->is_expired())
+					{
+						core::umutex<std::mutex> unique(workers.mutex);
+						++workers.cancelled;
+						return sqlite3_util::cancellation(token);
+					}
+				}
+
+				if (!status)
+					return status.error();
+
+				return expects_db<cursor>(std::move(result));
+#else
+				return database_exception("query: not supported");
+#endif
+			}
+			expects_db<bool> cluster::execute_statement(tconnection* connection, const std::string_view& command, prepared_query* params, size_t opts, cursor& result, size_t* length)
+			{
+#ifdef VI_SQLITE
+				VI_MEASURE(core::timings::intensive);
+				tstatement* target = acquire_statement(connection, command, length);
+				result.base.emplace_back();
+				if (!target)
+				{
+					auto status = sqlite3_util::prepare(connection, command, length, result.base.back());
+					if (!status)
+						return status.error();
+
+					target = *status;
+					if (!target)
+					{
+						result.base.pop_back();
+						return true;
+					}
+				}
+
+				core::vector<core::string> temps;
+				if (params != nullptr)
+				{
+					auto status = sqlite3_util::bind(target, params, temps);
+					if (!status)
+					{
+						release_statement(connection, command, target, *length);
+						return status.error();
+					}
+				}
+
+				auto status = sqlite3_util::execute(connection, target, result.base.back(), timeout, opts);
+				release_statement(connection, command, target, *length);
+				return !!status;
+#else
+				return database_exception("query: not supported");
+#endif
+			}
+			expects_db<void> cluster::commit_writes(tconnection* connection, core::vector<group_write*>& batch)
+			{
+#ifdef VI_SQLITE
+				VI_MEASURE(core::timings::intensive);
+				if (sqlite3_exec(connection, "BEGIN IMMEDIATE TRANSACTION", nullptr, nullptr, nullptr) != SQLITE_OK)
+					return database_exception(connection);
+
+				for (auto* item : batch)
+				{
+					std::string_view command = item->command;
+					prepared_query* args = item->parameterized ? &item->params : nullptr;
+					query_token* token = *item->token;
+					size_t offset = 0;
+					item->result = cursor(connection);
+					if (token != nullptr && token->is_expired())
+					{
+						item->error = sqlite3_util::cancellation(token).message();
+						continue;
+					}
+					else if (token != nullptr)
+						sqlite3_progress_handler(connection, PROGRESS_STEP_OPS, &sqlite3_util::progress_call, token);
+
+					sqlite3_exec(connection, "SAVEPOINT group_commit", nullptr, nullptr, nullptr);
 					while (offset < command.size())
 					{
-						VI_MEASURE(core::timings::intensive);
-						const char* trailing_statement = nullptr;
-						sqlite3_stmt* target = nullptr;
-						int code = sqlite3_prepare_v2(connection, command.data() + offset, (int)(command.size() - offset), &target, &trailing_statement);
-						offset = (trailing_statement ? trailing_statement - command.data() : command.size());
-						result.base.emplace_back();
-						if (code != SQLITE_OK)
+						size_t length = 0;
+						auto status = execute_statement(connection, command.substr(offset), args, item->opts, item->result, &length);
+						offset += length;
+						if (!status)
+						{
+							item->error = std::move(status.error().message());
+							break;
+						}
+						else if (!*status)
+							break;
+					}
+
+					if (token != nullptr)
+					{
+						sqlite3_progress_handler(connection, 0, nullptr, nullptr);
+						if ((!item->error.empty() || item->result.error()) && token->is_expired())
+							item->error = sqlite3_util::cancellation(token).message();
+					}
+
+					if (!item->error.empty() || item->result.error())
+						sqlite3_exec(connection, "ROLLBACK TO group_commit", nullptr, nullptr, nullptr);
+					sqlite3_exec(connection, "RELEASE group_commit", nullptr, nullptr, nullptr);
+				}
+
+				if (sqlite3_exec(connection, "COMMIT", nullptr, nullptr, nullptr) == SQLITE_OK)
+				{
+					VI_DEBUG("sqlite OK group commit on 0x%" PRIXPTR " (%" PRIu64 " writes)", (uintptr_t)connection, (uint64_t)batch.size());
+					return core::expectation::met;
+				}
+
+				database_exception error(connection);
+				sqlite3_exec(connection, "ROLLBACK", nullptr, nullptr, nullptr);
+				return error;
+#else
+				return database_exception("commit: not supported");
+#endif
+			}
+			tstatement* cluster::acquire_statement(tconnection* connection, const std::string_view& command, size_t* length)
+			{
+				core::umutex<std::mutex> unique(update);
+				auto it = caches.find(connection);
+				return it != caches.end() ? it->second->acquire(command, length) : nullptr;
+			}
+			void cluster::release_statement(tconnection* connection, const std::string_view& command, tstatement* statement, size_t length)
+			{
+#ifdef VI_SQLITE
+				core::umutex<std::mutex> unique(update);
+				auto it = caches.find(connection);
+				if (it != caches.end())
+					it->second->release(command, statement, length);
+				else
+					sqlite3_finalize(statement);
+#endif
+			}
+			void cluster::clear_statements()
+			{
+				core::umutex<std::mutex> unique(update);
+				for (auto& item : caches)
+					core::memory::deinit(item.second);
+				caches.clear();
+			}
+			void cluster::dispatch_writes()
+			{
+				core::coasync<void>([this]() -> core::promise<void>
+				{
+					while (true)
+					{
+						core::umutex<std::mutex> unique(update);
+						if (writes.empty())
 						{
-							int error = sqlite3_errcode(connection);
-							auto& response = result.base.back();
-							response.status_code = error == SQLITE_OK ? code : error;
-							response.status_message = error == SQLITE_OK ? sqlite3_errstr(code) : sqlite3_errmsg(connection);
-							if (target != nullptr)
-								sqlite3_finalize(target);
-							coreturn expects_db<cursor>(database_exception(core::string(response.status_message)));
+							committing = false;
+							coreturn_void;
 						}
 
-						VI_MEASURE(core::timings::intensive);
-						if (++queries > 1)
+						unique.negate();
+						tconnection* connection = VI_AWAIT(acquire_connection(nullptr, (size_t)query_op::transaction_start, false));
+						core::vector<group_write*> batch;
+						unique.negate();
+						batch.reserve(std::min(writes.size(), std::max<size_t>(group_size, 1)));
+						while (!writes.empty() && batch.size() < std::max<size_t>(group_size, 1))
 						{
-							if (!VI_AWAIT(core::cotask<expects_db<void>>(std::bind(&sqlite3_util::execute, connection, target, result.base.back(), timeout))))
-							{
-								sqlite3_finalize(target);
-								release_connection(connection, opts);
-								coreturn expects_db<cursor>(std::move(result));
-							}
+							batch.push_back(writes.front());
+							writes.pop();
 						}
-						else if (!sqlite3_util::execute(connection, target, result.base.back(), timeout))
+
+						unique.negate();
+						expects_db<void> status = database_exception("acquire connection error: no candidate");
+						if (connection != nullptr)
 						{
-							sqlite3_finalize(target);
-							release_connection(connection, opts);
-							coreturn expects_db<cursor>(std::move(result));
+							expects_promise_db<void> future;
+							dispatch_io([this, future, connection, &batch]() mutable { future.set(commit_writes(connection, batch)); });
+							status = VI_AWAIT(std::move(future));
+							release_connection(connection, (size_t)query_op::transaction_end);
 						}
-						sqlite3_finalize(target);
-					}
 
-					VI_DEBUG("sqlite OK execute on 0x%" PRIXPTR " (%" PRIu64 " ms)", (uintptr_t)connection, (uint64_t)(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()) - time).count());
-					release_connection(connection, opts); (void)time;
-					coreturn expects_db<cursor>(std::move(result));
+						for (auto* item : batch)
+						{
+							if (!status)
+								item->future.set(status.error());
+							else if (!item->error.empty())
+								item->future.set(database_exception(std::move(item->error)));
+							else
+								item->future.set(std::move(item->result));
+							core::memory::deinit(item);
+						}
+					}
 				});
+			}
+			void cluster::dispatch_io(std::function<void()>&& callback)
+			{
+				core::umutex<std::mutex> unique(workers.mutex);
+				if (workers.threads.empty())
+				{
+					unique.negate();
+					core::cotask<void>(std::move(callback));
+					return;
+				}
+
+				workers.tasks.push(std::move(callback));
+				workers.peak_queued = std::max(workers.peak_queued, workers.tasks.size());
+				unique.negate();
+				workers.notify.notify_one();
+			}
+			void cluster::stop_io()
+			{
+				core::umutex<std::mutex> unique(workers.mutex);
+				if (workers.threads.empty())
+					return;
+
+				core::vector<std::thread> threads = std::move(workers.threads);
+				workers.threads.clear();
+				workers.stopping = true;
+				unique.negate();
+
+				workers.notify.notify_all();
+				for (auto& thread : threads)
+				{
+					if (thread.joinable())
+						thread.join();
+				}
+			}
+			void cluster::io_loop()
+			{
+				VI_DEBUG("sqlite spawn i/o thread %s", core::os::process::get_thread_id(std::this_thread::get_id()).c_str());
+				std::unique_lock<std::mutex> unique(workers.mutex);
+				while (true)
+				{
+					workers.notify.wait(unique, [this]() { return workers.stopping || !workers.tasks.empty(); });
+					if (workers.tasks.empty())
+						break;
+
+					auto callback = std::move(workers.tasks.front());
+					workers.tasks.pop();
+					++workers.active;
+					unique.unlock();
+					callback();
+					unique.lock();
+					--workers.active;
+					++workers.completed;
+				}
+				VI_DEBUG("sqlite join i/o thread %s", core::os::process::get_thread_id(std::this_thread::get_id()).c_str());
+			}
+			cluster::route cluster::classify(tconnection* connection, const std::string_view& command)
+			{
+#ifdef VI_SQLITE
+				size_t length = 0;
+				tstatement* target = acquire_statement(connection, command, &length);
+				bool cached = target != nullptr;
+				if (!cached)
+				{
+					response scratch;
+					auto status = sqlite3_util::prepare(connection, command, &length, scratch);
+					if (!status || !*status)
+						return route::exclusive;
+
+					target = *status;
+				}
+
+				route result = route::write;
+				if (!sqlite3_util::is_single(command, length) || sqlite3_util::is_control(command, length))
+					result = route::exclusive;
+				else if (sqlite3_stmt_readonly(target))
+					result = route::read;
+
+				if (cached || result == route::read)
+					release_statement(connection, command, target, length);
+				else
+					sqlite3_finalize(target);
+
+				core::umutex<std::mutex> unique(update);
+				if (routes.size() >= ROUTE_CACHE_SIZE)
+					routes.clear();
+				routes[core::string(command)] = result;
+				return result;
 #else
-				return expects_promise_db<cursor>(database_exception("query: not supported"));
+				return route::exclusive;
 #endif
 			}
-			tconnection* cluster::try_acquire_connection(session_id session, size_t opts)
+			cluster::route cluster::get_route(const std::string_view& command, size_t opts, session_id session)
+			{
+				if (session != nullptr || opts & (size_t)query_op::transaction_start || opts & (size_t)query_op::transaction_end)
+					return route::exclusive;
+
+				core::umutex<std::mutex> unique(update);
+				if (readers.empty())
+					return route::exclusive;
+
+				auto it = routes.find(core::key_lookup_cast(command));
+				return it != routes.end() ? it->second : route::unknown;
+			}
+			tconnection* cluster::try_acquire_connection(session_id session, size_t opts, bool reader)
 			{
 #ifdef VI_SQLITE
 				auto it = idle.begin();
@@ -1511,6 +2251,11 @@ namespace vitex
 							return nullptr;
 						break;
 					}
+					else if (!readers.empty() && (readers.find(*it) != readers.end()) != reader)
+					{
+						++it;
+						continue;
+					}
 					else if (!is_in_transaction && !(opts & (size_t)query_op::transaction_end))
 					{
 						if (opts & (size_t)query_op::transaction_start)
@@ -1532,17 +2277,21 @@ namespace vitex
 				return nullptr;
 #endif
 			}
-			core::promise<tconnection*> cluster::acquire_connection(session_id session, size_t opts)
+			core::promise<tconnection*> cluster::acquire_connection(session_id session, size_t opts, bool reader)
 			{
 				core::umutex<std::mutex> unique(update);
-				tconnection* connection = try_acquire_connection(session, opts);
+				tconnection* connection = try_acquire_connection(session, opts, reader);
 				if (connection != nullptr)
 					return core::promise<tconnection*>(connection);
 
 				request target;
 				target.session = session;
 				target.opts = opts;
-				queues[session].push(target);
+				target.reader = reader;
+				if (!readers.empty() && reader && !session)
+					reads.push(target);
+				else
+					queues[session].push(target);
 				return target.future;
 			}
 			void cluster::release_connection(tconnection* connection, size_t opts)
@@ -1553,20 +2302,28 @@ namespace vitex
 				busy.erase(connection);
 				idle.insert(connection);
 
-				auto it = queues.find(connection);
-				if (it == queues.end() || it->second.empty())
-					it = queues.find(nullptr);
+				core::single_queue<request>* queue = nullptr;
+				if (readers.find(connection) != readers.end())
+					queue = &reads;
+				else
+				{
+					auto it = queues.find(connection);
+					if (it == queues.end() || it->second.empty())
+						it = queues.find(nullptr);
+					if (it != queues.end())
+						queue = &it->second;
+				}
 
-				if (it == queues.end() || it->second.empty())
+				if (!queue || queue->empty())
 					return;
 
-				request& target = it->second.front();
-				tconnection* new_connection = try_acquire_connection(target.session, target.opts);
+				request& target = queue->front();
+				tconnection* new_connection = try_acquire_connection(target.session, target.opts, target.reader);
 				if (!new_connection)
 					return;
 
 				auto future = std::move(target.future);
-				it->second.pop();
+				queue->pop();
 				unique.negate();
 				future.set(new_connection);
 			}
@@ -1980,6 +2737,8 @@ namespace vitex
 
 				if (variables.empty())
 					result.cache = result.request;
+				else
+					compile(result);
 
 				core::umutex<std::mutex> unique(exclusive);
 				queries[core::string(name)] = std::move(result);
@@ -2079,6 +2838,7 @@ namespace vitex
 						}
 					}
 
+					compile(result);
 					core::string name = data->get_var("name").get_blob();
 					queries[name] = std::move(result);
 					++count;
@@ -2204,6 +2964,58 @@ namespace vitex
 
 				return result;
 			}
+			expects_db<prepared_query> driver::get_prepared_query(const std::string_view& name, core::schema_args* map) noexcept
+			{
+				core::umutex<std::mutex> unique(exclusive);
+				auto it = queries.find(core::key_lookup_cast(name));
+				if (it == queries.end())
+					return database_exception("query not found: " + core::string(name));
+
+				if (it->second.prepared.empty())
+					return database_exception("query cannot be prepared: " + core::string(name));
+
+				prepared_query result;
+				core::vector<core::string> parameters = it->second.parameters;
+				result.command = it->second.prepared;
+				unique.negate();
+
+				result.values.reserve(parameters.size());
+				for (auto& key : parameters)
+				{
+					auto value = map ? map->find(key) : core::schema_args::iterator();
+					if (!map || value == map->end())
+						return database_exception("query expects @" + key + " constant: " + core::string(name));
+
+					core::schema* source = *value->second;
+					switch (source ? source->value.get_type() : core::var_type::null)
+					{
+						case core::var_type::object:
+						{
+							core::string data;
+							core::schema::convert_to_json(source, [&data](core::var_form, const std::string_view& buffer) { data.append(buffer); });
+							result.values.emplace_back(core::var::string(data));
+							break;
+						}
+						case core::var_type::array:
+							return database_exception("query cannot be prepared: array parameter @" + key + " in " + core::string(name));
+						case core::var_type::string:
+						case core::var_type::binary:
+						case core::var_type::integer:
+						case core::var_type::number:
+						case core::var_type::boolean:
+						case core::var_type::decimal:
+							result.values.emplace_back(source->value);
+							break;
+						case core::var_type::null:
+						case core::var_type::undefined:
+						default:
+							result.values.emplace_back(core::var::null());
+							break;
+					}
+				}
+
+				return result;
+			}
 			core::vector<core::string> driver::get_queries() noexcept
 			{
 				core::vector<core::string> result;
@@ -2218,6 +3030,35 @@ namespace vitex
 			{
 				return !!logger;
 			}
+			void driver::compile(sequence& base)
+			{
+				base.prepared.clear();
+				base.parameters.clear();
+				if (base.positions.empty())
+					return;
+
+				for (auto& word : base.positions)
+				{
+					if (!word.escape || word.negate)
+						return;
+				}
+
+				core::string result = base.request;
+				size_t offset = 0;
+				for (auto& word : base.positions)
+				{
+					auto it = std::find(base.parameters.begin(), base.parameters.end(), word.key);
+					size_t index = (size_t)(it - base.parameters.begin());
+					if (it == base.parameters.end())
+						base.parameters.push_back(word.key);
+
+					core::string value = "?" + core::to_string(index + 1);
+					result.insert(word.offset + offset, value);
+					offset += value.size();
+				}
+
+				base.prepared = std::move(result);
+			}
 		}
 	}
 }
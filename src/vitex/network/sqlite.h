@@ -56,7 +56,8 @@ namespace vitex
 			{
 				delete_args = 0,
 				transaction_start = (1 << 0),
-				transaction_end = (1 << 1)
+				transaction_end = (1 << 1),
+				infer_types = (1 << 2)
 			};
 
 			enum class checkpoint_mode
@@ -80,6 +81,12 @@ namespace vitex
 				int32_t status = -1;
 			};
 
+			struct prepared_query
+			{
+				core::variant_list values;
+				core::string command;
+			};
+
 			class database_exception final : public core::basic_exception
 			{
 			public:
@@ -202,6 +209,30 @@ namespace vitex
 					}
 				};
 
+			private:
+				enum class storage : uint8_t
+				{
+					null,
+					integer,
+					number,
+					text,
+					blob
+				};
+
+				union cell
+				{
+					int64_t integer;
+					double number;
+					size_t offset;
+				};
+
+				struct field
+				{
+					core::vector<cell> data;
+					core::vector<uint32_t> sizes;
+					core::vector<storage> types;
+				};
+
 			private:
 				struct
 				{
@@ -211,9 +242,12 @@ namespace vitex
 
 			private:
 				core::vector<core::string> columns;
-				core::vector<core::vector<core::variant>> values;
+				core::vector<field> fields;
+				core::string arena;
 				core::string status_message;
+				size_t rows = 0;
 				int status_code = -1;
+				bool infer_types = false;
 
 			public:
 				response() = default;
@@ -256,6 +290,11 @@ namespace vitex
 					return status_code == 0;
 				}
 
+			private:
+				core::variant get_value(size_t row_index, size_t column_index) const;
+				size_t get_value_size(size_t row_index, size_t column_index) const;
+				bool is_value_null(size_t row_index, size_t column_index) const;
+
 			public:
 				iterator begin() const
 				{
@@ -327,12 +366,59 @@ namespace vitex
 				}
 			};
 
+			class query_token final : public core::reference<query_token>
+			{
+			private:
+				std::atomic<int64_t> deadline;
+				std::atomic<bool> cancelled;
+
+			public:
+				query_token(uint64_t timeout_ms = 0) noexcept;
+				~query_token() noexcept = default;
+				void cancel() noexcept;
+				void set_timeout(uint64_t timeout_ms) noexcept;
+				bool is_cancelled() const noexcept;
+				bool is_expired() const noexcept;
+			};
+
+			class statement_cache
+			{
+			private:
+				struct entry
+				{
+					core::string command;
+					tstatement* statement = nullptr;
+					size_t length = 0;
+					bool busy = false;
+				};
+
+			private:
+				core::unordered_map<std::string_view, core::linked_list<entry>::iterator> index;
+				core::linked_list<entry> items;
+				size_t capacity;
+
+			public:
+				statement_cache(size_t max_statements) noexcept;
+				statement_cache(const statement_cache&) = delete;
+				statement_cache(statement_cache&&) = delete;
+				~statement_cache() noexcept;
+				statement_cache& operator =(const statement_cache&) = delete;
+				statement_cache& operator =(statement_cache&&) = delete;
+				tstatement* acquire(const std::string_view& command, size_t* length) noexcept;
+				void release(const std::string_view& command, tstatement* statement, size_t length) noexcept;
+				void resize(size_t max_statements) noexcept;
+				void clear() noexcept;
+				size_t size() const noexcept;
+				size_t get_capacity() const noexcept;
+			};
+
 			class connection final : public core::reference<connection>
 			{
 				friend driver;
 
 			private:
 				core::unordered_map<core::string, tstatement*> statements;
+				statement_cache cache;
 				core::vector<on_function_result*> functions;
 				core::vector<aggregate*> aggregates;
 				core::vector<window*> windows;
@@ -359,15 +445,18 @@ namespace vitex
 				core::vector<checkpoint> wal_checkpoint(checkpoint_mode mode, const std::string_view& database = std::string_view());
 				size_t free_memory_used(size_t bytes);
 				size_t get_memory_used() const;
-				expects_db<void> bind_null(tstatement* statement, size_t index);
-				expects_db<void> bind_pointer(tstatement* statement, size_t index, void* value);
-				expects_db<void> bind_string(tstatement* statement, size_t index, const std::string_view& value);
-				expects_db<void> bind_blob(tstatement* statement, size_t index, const std::string_view& value);
-				expects_db<void> bind_boolean(tstatement* statement, size_t index, bool value);
-				expects_db<void> bind_int32(tstatement* statement, size_t index, int32_t value);
-				expects_db<void> bind_int64(tstatement* statement, size_t index, int64_t value);
-				expects_db<void> bind_double(tstatement* statement, size_t index, double value);
-				expects_db<void> bind_decimal(tstatement* statement, size_t index, const core::decimal& value, core::vector<core::string>& temps);
+				void set_statement_cache_size(size_t max_statements);
+				size_t get_statement_cache_size();
+				static expects_db<void> bind_null(tstatement* statement, size_t index);
+				static expects_db<void> bind_pointer(tstatement* statement, size_t index, void* value);
+				static expects_db<void> bind_string(tstatement* statement, size_t index, const std::string_view& value);
+				static expects_db<void> bind_blob(tstatement* statement, size_t index, const std::string_view& value);
+				static expects_db<void> bind_boolean(tstatement* statement, size_t index, bool value);
+				static expects_db<void> bind_int32(tstatement* statement, size_t index, int32_t value);
+				static expects_db<void> bind_int64(tstatement* statement, size_t index, int64_t value);
+				static expects_db<void> bind_double(tstatement* statement, size_t index, double value);
+				static expects_db<void> bind_decimal(tstatement* statement, size_t index, const core::decimal& value, core::vector<core::string>& temps);
+				static expects_db<void> bind_variant(tstatement* statement, size_t index, const core::variant& value, core::vector<core::string>& temps);
 				expects_db<tstatement*> prepare_statement(const std::string_view& command, std::string_view* leftover_command);
 				expects_db<session_id> tx_begin(isolation type);
 				expects_db<session_id> tx_start(const std::string_view& command);
@@ -384,6 +473,9 @@ namespace vitex
 				tconnection* get_connection();
 				const core::string& get_address();
 				bool is_connected();
+
+			private:
+				expects_db<cursor> submit(const std::string_view& command, sqlite::prepared_query* params, size_t query_ops, session_id session);
 			};
 
 			class cluster final : public core::reference<cluster>
@@ -391,15 +483,66 @@ namespace vitex
 				friend driver;
 
 			private:
+				enum class route : uint8_t
+				{
+					unknown,
+					read,
+					write,
+					exclusive
+				};
+
 				struct request
 				{
 					core::promise<tconnection*> future;
 					session_id session = nullptr;
 					size_t opts = 0;
+					bool reader = false;
+				};
+
+				struct group_write
+				{
+					expects_promise_db<cursor> future;
+					core::uref<query_token> token;
+					prepared_query params;
+					core::string command;
+					core::string error;
+					cursor result;
+					size_t opts = 0;
+					bool parameterized = false;
+				};
+
+			public:
+				struct io_stats
+				{
+					uint64_t completed = 0;
+					uint64_t cancelled = 0;
+					size_t threads = 0;
+					size_t queued = 0;
+					size_t active = 0;
+					size_t peak_queued = 0;
 				};
 
+			private:
+				struct
+				{
+					core::single_queue<std::function<void()>> tasks;
+					core::vector<std::thread> threads;
+					std::condition_variable notify;
+					std::mutex mutex;
+					uint64_t completed = 0;
+					uint64_t cancelled = 0;
+					size_t active = 0;
+					size_t peak_queued = 0;
+					bool stopping = false;
+				} workers;
+
 			private:
 				core::unordered_map<tconnection*, core::single_queue<request>> queues;
+				core::unordered_map<tconnection*, statement_cache*> caches;
+				core::unordered_map<core::string, route> routes;
+				core::unordered_set<tconnection*> readers;
+				core::single_queue<group_write*> writes;
+				core::single_queue<request> reads;
 				core::unordered_set<tconnection*> idle;
 				core::unordered_set<tconnection*> busy;
 				core::vector<on_function_result*> functions;
@@ -408,6 +551,10 @@ namespace vitex
 				core::string source;
 				driver* library_handle;
 				uint64_t timeout;
+				size_t cache_size;
+				size_t group_size;
+				bool routing;
+				bool committing;
 				std::mutex update;
 
 			public:
@@ -426,6 +573,14 @@ namespace vitex
 				core::vector<checkpoint> wal_checkpoint(checkpoint_mode mode, const std::string_view& database = std::string_view());
 				size_t free_memory_used(size_t bytes);
 				size_t get_memory_used() const;
+				void set_statement_cache_size(size_t max_statements);
+				void set_wal_routing(bool enabled);
+				void set_group_commit(size_t max_statements);
+				void set_io_threads(size_t count);
+				size_t get_statement_cache_size();
+				size_t get_io_threads();
+				size_t get_group_commit();
+				bool is_wal_routing();
 				expects_promise_db<session_id> tx_begin(isolation type);
 				expects_promise_db<session_id> tx_start(const std::string_view& command);
 				expects_promise_db<void> tx_end(const std::string_view& command, session_id session);
@@ -434,9 +589,10 @@ namespace vitex
 				expects_promise_db<void> connect(const std::string_view& location, size_t connections);
 				expects_promise_db<void> disconnect();
 				expects_promise_db<void> flush();
-				expects_promise_db<cursor> emplace_query(const std::string_view& command, core::schema_list* map, size_t query_ops = 0, session_id session = nullptr);
-				expects_promise_db<cursor> template_query(const std::string_view& name, core::schema_args* map, size_t query_ops = 0, session_id session = nullptr);
-				expects_promise_db<cursor> query(const std::string_view& command, size_t query_ops = 0, session_id session = nullptr);
+				expects_promise_db<cursor> emplace_query(const std::string_view& command, core::schema_list* map, size_t query_ops = 0, session_id session = nullptr, query_token* token = nullptr);
+				expects_promise_db<cursor> template_query(const std::string_view& name, core::schema_args* map, size_t query_ops = 0, session_id session = nullptr, query_token* token = nullptr);
+				expects_promise_db<cursor> query(const std::string_view& command, size_t query_ops = 0, session_id session = nullptr, query_token* token = nullptr);
+				io_stats get_io_stats();
 				tconnection* get_idle_connection();
 				tconnection* get_busy_connection();
 				tconnection* get_any_connection();
@@ -444,8 +600,22 @@ namespace vitex
 				bool is_connected();
 
 			private:
-				tconnection* try_acquire_connection(session_id session, size_t opts);
-				core::promise<tconnection*> acquire_connection(session_id session, size_t opts);
+				expects_promise_db<cursor> submit(const std::string_view& command, prepared_query* params, size_t query_ops, session_id session, query_token* token);
+				expects_promise_db<cursor> enqueue_write(core::string&& command, prepared_query&& params, bool parameterized, size_t query_ops, query_token* token);
+				expects_db<cursor> execute_command(tconnection* connection, const std::string_view& command, prepared_query* params, size_t query_ops, query_token* token);
+				expects_db<bool> execute_statement(tconnection* connection, const std::string_view& command, prepared_query* params, size_t query_ops, cursor& result, size_t* length);
+				expects_db<void> commit_writes(tconnection* connection, core::vector<group_write*>& batch);
+				tstatement* acquire_statement(tconnection* connection, const std::string_view& command, size_t* length);
+				void release_statement(tconnection* connection, const std::string_view& command, tstatement* statement, size_t length);
+				void clear_statements();
+				void dispatch_writes();
+				void dispatch_io(std::function<void()>&& callback);
+				void stop_io();
+				void io_loop();
+				route classify(tconnection* connection, const std::string_view& command);
+				route get_route(const std::string_view& command, size_t query_ops, session_id session);
+				tconnection* try_acquire_connection(session_id session, size_t opts, bool reader);
+				core::promise<tconnection*> acquire_connection(session_id session, size_t opts, bool reader = false);
 				void release_connection(tconnection* connection, size_t opts);
 			};
 
@@ -476,7 +646,9 @@ namespace vitex
 				struct sequence
 				{
 					core::vector<pose> positions;
+					core::vector<core::string> parameters;
 					core::string request;
+					core::string prepared;
 					core::string cache;
 				};
 
@@ -501,8 +673,12 @@ namespace vitex
 				core::schema* get_cache_dump() noexcept;
 				expects_db<core::string> emplace(const std::string_view& SQL, core::schema_list* map) noexcept;
 				expects_db<core::string> get_query(const std::string_view& name, core::schema_args* map) noexcept;
+				expects_db<prepared_query> get_prepared_query(const std::string_view& name, core::schema_args* map) noexcept;
 				core::vector<core::string> get_queries() noexcept;
 				bool is_log_active() const noexcept;
+
+			private:
+				static void compile(sequence& base);
 			};
 		}
 	}
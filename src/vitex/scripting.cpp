@@ -3,11 +3,32 @@
 #include "vitex.h"
 #include <sstream>
 #define ADDON_ANY "any"
+#define ISOLATE_BATCH_SIZE 64
 #ifdef VI_ANGELSCRIPT
 #include <angelscript.h>
 #include <as_texts.h>
+#include <as_context.h>
+#include <as_scriptengine.h>
+#ifdef VI_MICROSOFT
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#if defined(__x86_64__) || defined(_M_X64)
+#define JIT_TARGET_X64
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define JIT_TARGET_ARM64
+#endif
+#define JIT_THUNK_SIZE 16
+#define BYTE_CODE_IMPORTED_FUNCTION 0x40000000
 #define COMPILER_BLOCKED_WAIT_US 100
 #define THREAD_BLOCKED_WAIT_MS 50
+#define BYTE_CODE_FILE_MAGIC "VIBCODE1"
+#define BYTE_CODE_FILE_HEADER 17
+#define BYTE_CODE_FILE_VERSIONS 4
 
 namespace
 {
@@ -37,80 +58,2649 @@ namespace
 			memcpy(&code[write_pos], ptr, size);
 			write_pos += size;
 
-			return 0;
-		}
-		vitex::core::vector<asBYTE>& GetCode()
-		{
-			return code;
-		}
-		asUINT GetSize()
-		{
-			return (asUINT)code.size();
+			return 0;
+		}
+		vitex::core::vector<asBYTE>& GetCode()
+		{
+			return code;
+		}
+		asUINT GetSize()
+		{
+			return (asUINT)code.size();
+		}
+	};
+
+	struct byte_code_view : public asIBinaryStream
+	{
+		const uint8_t* data;
+		size_t size, read_pos;
+
+		byte_code_view(const uint8_t* new_data, size_t new_size) : data(new_data), size(new_size), read_pos(0)
+		{
+		}
+		int Read(void* ptr, asUINT length) override
+		{
+			VI_ASSERT(ptr && length, "corrupted read");
+			if (length > size - read_pos)
+				return -1;
+
+			memcpy(ptr, data + read_pos, length);
+			read_pos += length;
+			return 0;
+		}
+		int Write(const void* ptr, asUINT length) override
+		{
+			return -1;
+		}
+	};
+
+	struct byte_code_mapping
+	{
+		uint8_t* data = nullptr;
+		size_t size = 0;
+
+		~byte_code_mapping()
+		{
+			unmap();
+		}
+		bool map(const vitex::core::string& path)
+		{
+			unmap();
+			if (!vitex::core::os::control::has(vitex::core::os::access_option::fs))
+				return false;
+#ifdef VI_MICROSOFT
+			auto buffer = vitex::core::os::file::read_all(path, &size);
+			if (!buffer)
+				return false;
+
+			data = *buffer;
+			return true;
+#else
+			int fd = open(path.c_str(), O_RDONLY);
+			if (fd < 0)
+				return false;
+
+			struct stat state;
+			if (fstat(fd, &state) != 0 || state.st_size <= 0)
+			{
+				close(fd);
+				return false;
+			}
+
+			void* address = mmap(nullptr, (size_t)state.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			close(fd);
+			if (address == MAP_FAILED)
+				return false;
+
+			data = (uint8_t*)address;
+			size = (size_t)state.st_size;
+			return true;
+#endif
+		}
+		void unmap()
+		{
+			if (!data)
+				return;
+#ifdef VI_MICROSOFT
+			vitex::core::memory::deallocate(data);
+#else
+			munmap(data, size);
+#endif
+			data = nullptr;
+			size = 0;
+		}
+	};
+
+	struct denum
+	{
+		vitex::core::vector<vitex::core::string> values;
+	};
+
+	struct dclass
+	{
+		vitex::core::vector<vitex::core::string> props;
+		vitex::core::vector<vitex::core::string> interfaces;
+		vitex::core::vector<vitex::core::string> types;
+		vitex::core::vector<vitex::core::string> funcdefs;
+		vitex::core::vector<vitex::core::string> methods;
+		vitex::core::vector<vitex::core::string> functions;
+	};
+
+	struct dnamespace
+	{
+		vitex::core::unordered_map<vitex::core::string, denum> enums;
+		vitex::core::unordered_map<vitex::core::string, dclass> classes;
+		vitex::core::vector<vitex::core::string> funcdefs;
+		vitex::core::vector<vitex::core::string> functions;
+	};
+
+	vitex::core::string get_combination(const vitex::core::vector<vitex::core::string>& names, const vitex::core::string& by)
+	{
+		vitex::core::string result;
+		for (size_t i = 0; i < names.size(); i++)
+		{
+			result.append(names[i]);
+			if (i + 1 < names.size())
+				result.append(by);
+		}
+
+		return result;
+	}
+	vitex::core::string get_combination_all(const vitex::core::vector<vitex::core::string>& names, const vitex::core::string& by, const vitex::core::string& end_by)
+	{
+		vitex::core::string result;
+		for (size_t i = 0; i < names.size(); i++)
+		{
+			result.append(names[i]);
+			if (i + 1 < names.size())
+				result.append(by);
+			else
+				result.append(end_by);
+		}
+
+		return result;
+	}
+	vitex::core::string get_type_naming(asITypeInfo* type)
+	{
+		const char* name_space = type->GetNamespace();
+		return (name_space ? name_space + vitex::core::string("::") : vitex::core::string("")) + type->GetName();
+	}
+	asITypeInfo* get_type_namespacing(asIScriptEngine* engine, const vitex::core::string& name)
+	{
+		asITypeInfo* result = engine->GetTypeInfoByName(name.c_str());
+		if (result != nullptr)
+			return result;
+
+		return engine->GetTypeInfoByName((name + "@").c_str());
+	}
+	static_assert(sizeof(vitex::scripting::native_registers) == sizeof(asSVMRegisters), "native registers should mirror vm registers");
+	static_assert(offsetof(vitex::scripting::native_registers, stack_pointer) == offsetof(asSVMRegisters, stackPointer), "native registers should mirror vm registers");
+	static_assert(offsetof(vitex::scripting::native_registers, value_register) == offsetof(asSVMRegisters, valueRegister), "native registers should mirror vm registers");
+	static_assert(offsetof(vitex::scripting::native_registers, object_register) == offsetof(asSVMRegisters, objectRegister), "native registers should mirror vm registers");
+	static_assert(offsetof(vitex::scripting::native_registers, do_process_suspend) == offsetof(asSVMRegisters, doProcessSuspend), "native registers should mirror vm registers");
+	static_assert(offsetof(vitex::scripting::native_registers, context) == offsetof(asSVMRegisters, ctx), "native registers should mirror vm registers");
+
+	void append_function_identity(asIScriptFunction* function, vitex::core::string& data)
+	{
+		if (function != nullptr)
+			data.append(function->GetDeclaration(true, true, true));
+		data.append(1, '\0');
+	}
+	void append_type_identity(asIScriptEngine* engine, int type_id, vitex::core::string& data)
+	{
+		const char* decl = type_id != 0 ? engine->GetTypeDeclaration(type_id, true) : nullptr;
+		if (decl != nullptr)
+			data.append(decl);
+		data.append(1, '\0');
+	}
+	void append_global_identity(asIScriptFunction* function, void* address, vitex::core::string& data)
+	{
+		asIScriptModule* module = function->GetModule();
+		if (module != nullptr)
+		{
+			for (asUINT i = 0; i < module->GetGlobalVarCount(); i++)
+			{
+				if (module->GetAddressOfGlobalVar(i) != address)
+					continue;
+
+				data.append(module->GetGlobalVarDeclaration(i, true));
+				data.append(1, '\0');
+				return;
+			}
+		}
+
+		asIScriptEngine* engine = function->GetEngine();
+		for (asUINT i = 0; i < engine->GetGlobalPropertyCount(); i++)
+		{
+			const char* name = nullptr, *name_space = nullptr;
+			void* pointer = nullptr;
+			if (engine->GetGlobalPropertyByIndex(i, &name, &name_space, nullptr, nullptr, nullptr, &pointer) < 0 || pointer != address)
+				continue;
+
+			if (name_space != nullptr && *name_space != '\0')
+				data.append(name_space).append("::");
+			if (name != nullptr)
+				data.append(name);
+			break;
+		}
+		data.append(1, '\0');
+	}
+	vitex::core::string get_native_literal(const std::string_view& value)
+	{
+		vitex::core::string result = "\"";
+		for (char v : value)
+		{
+			if (v == '\\' || v == '\"')
+				result.append(1, '\\').append(1, v);
+			else if ((uint8_t)v < 0x20)
+				result.append(vitex::core::stringify::text("\\x%02x\"\"", (int)(uint8_t)v));
+			else
+				result.append(1, v);
+		}
+		return result.append(1, '\"');
+	}
+	bool translate_native_function(asIScriptFunction* function, const vitex::core::string& name, vitex::core::string& source)
+	{
+		asUINT length = 0;
+		asDWORD* code = function->GetByteCode(&length);
+		if (!code || !length)
+			return false;
+
+		vitex::core::vector<asUINT> entries;
+		vitex::core::vector<uint8_t> marks((size_t)length + 1, 0);
+		auto jump = [code](asUINT offset, asUINT size) { return (int64_t)offset + (int64_t)size + (int64_t)asBC_INTARG(code + offset); };
+		auto branch = [](asBYTE opcode) { return opcode == asBC_JMP || opcode == asBC_JZ || opcode == asBC_JNZ || opcode == asBC_JS || opcode == asBC_JNS || opcode == asBC_JP || opcode == asBC_JNP || opcode == asBC_JLowZ || opcode == asBC_JLowNZ; };
+		for (asUINT offset = 0; offset < length;)
+		{
+			asBYTE opcode = *(asBYTE*)(code + offset);
+			asUINT size = std::max<asUINT>(1, asBCTypeSize[asBCInfo[opcode].type]);
+			marks[offset] |= 1;
+			if (opcode == asBC_JitEntry)
+			{
+				entries.push_back(offset);
+				marks[offset] |= 2;
+			}
+			offset += size;
+		}
+		marks[length] |= 1;
+
+		for (asUINT offset = 0; offset < length;)
+		{
+			asBYTE opcode = *(asBYTE*)(code + offset);
+			asUINT size = std::max<asUINT>(1, asBCTypeSize[asBCInfo[opcode].type]);
+			if (branch(opcode))
+			{
+				int64_t target = jump(offset, size);
+				if (target < 0 || target > (int64_t)length || !(marks[(size_t)target] & 1))
+					return false;
+				marks[(size_t)target] |= 2;
+			}
+			offset += size;
+		}
+
+		if (entries.empty())
+			return false;
+
+		const char* value = "&regs->value_register";
+		auto slot = [](asDWORD* pc, size_t index)
+		{
+			short shift = *((short*)pc + 1 + index);
+			return shift >= 0 ? vitex::core::stringify::text("(fp - %i)", (int)shift) : vitex::core::stringify::text("(fp + %i)", -(int)shift);
+		};
+		auto exit = [](asUINT offset) { return vitex::core::stringify::text("{ regs->program_pointer = code + %u; regs->stack_pointer = sp; return; }", offset); };
+		auto operand = [](asUINT offset) { return vitex::core::stringify::text("aot_load<void*>(code + %u)", offset + 1); };
+		auto binary = [&slot](asDWORD* pc, const char* type, const char* operation)
+		{
+			return vitex::core::stringify::text("aot_store<%s>(%s, (%s)(aot_load<%s>(%s) %s aot_load<%s>(%s)));", type, slot(pc, 0).c_str(), type, type, slot(pc, 1).c_str(), operation, type, slot(pc, 2).c_str());
+		};
+		auto convert = [&slot](asDWORD* pc, const char* from, const char* to, const char* via)
+		{
+			bool in_place = asBCInfo[*(asBYTE*)pc].type != asBCTYPE_wW_rW_ARG;
+			return vitex::core::stringify::text("aot_store<%s>(%s, (%s)(%s)aot_load<%s>(%s));", to, slot(pc, 0).c_str(), to, via, from, slot(pc, in_place ? 0 : 1).c_str());
+		};
+
+		vitex::core::string body;
+		size_t supported = 0;
+		const size_t pointer = sizeof(asPWORD) / sizeof(asDWORD);
+		for (asUINT offset = 0; offset < length;)
+		{
+			asDWORD* pc = code + offset;
+			asBYTE opcode = *(asBYTE*)pc;
+			asUINT size = std::max<asUINT>(1, asBCTypeSize[asBCInfo[opcode].type]);
+			vitex::core::string target = slot(pc, 0), line;
+			if (marks[offset] & 2)
+				body += vitex::core::stringify::text("\tl_%u:\n", offset);
+
+			switch (opcode)
+			{
+				case asBC_JitEntry:
+					offset += size;
+					continue;
+				case asBC_SUSPEND:
+					line = "if (regs->do_process_suspend) " + exit(offset);
+					break;
+				case asBC_PshC4:
+					line = vitex::core::stringify::text("sp -= 1; aot_store<uint32_t>(sp, 0x%xu);", (uint32_t)asBC_DWORDARG(pc));
+					break;
+				case asBC_PshC8:
+					line = vitex::core::stringify::text("sp -= 2; aot_store<uint64_t>(sp, 0x%" PRIx64 "ull);", (uint64_t)asBC_QWORDARG(pc));
+					break;
+				case asBC_PshV4:
+					line = vitex::core::stringify::text("sp -= 1; aot_store<uint32_t>(sp, aot_load<uint32_t>(%s));", target.c_str());
+					break;
+				case asBC_PshV8:
+					line = vitex::core::stringify::text("sp -= 2; aot_store<uint64_t>(sp, aot_load<uint64_t>(%s));", target.c_str());
+					break;
+				case asBC_PshVPtr:
+					line = vitex::core::stringify::text("sp -= %i; aot_store<void*>(sp, aot_load<void*>(%s));", (int)pointer, target.c_str());
+					break;
+				case asBC_PSF:
+					line = vitex::core::stringify::text("sp -= %i; aot_store<void*>(sp, (void*)%s);", (int)pointer, target.c_str());
+					break;
+				case asBC_PGA:
+					line = vitex::core::stringify::text("sp -= %i; aot_store<void*>(sp, %s);", (int)pointer, operand(offset).c_str());
+					break;
+				case asBC_PshG4:
+					line = vitex::core::stringify::text("sp -= 1; aot_store<uint32_t>(sp, aot_load<uint32_t>(%s));", operand(offset).c_str());
+					break;
+				case asBC_PopPtr:
+					line = vitex::core::stringify::text("sp += %i;", (int)pointer);
+					break;
+				case asBC_JMP:
+					line = vitex::core::stringify::text("goto l_%u;", (asUINT)jump(offset, size));
+					break;
+				case asBC_JZ:
+				case asBC_JNZ:
+				case asBC_JS:
+				case asBC_JNS:
+				case asBC_JP:
+				case asBC_JNP:
+				case asBC_JLowZ:
+				case asBC_JLowNZ:
+				{
+					const char* condition = opcode == asBC_JZ || opcode == asBC_JLowZ ? "==" : (opcode == asBC_JNZ || opcode == asBC_JLowNZ ? "!=" : (opcode == asBC_JS ? "<" : (opcode == asBC_JNS ? ">=" : (opcode == asBC_JP ? ">" : "<="))));
+					line = vitex::core::stringify::text("if (aot_load<%s>(%s) %s 0) goto l_%u;", opcode == asBC_JLowZ || opcode == asBC_JLowNZ ? "uint8_t" : "int32_t", value, condition, (asUINT)jump(offset, size));
+					break;
+				}
+				case asBC_TZ:
+				case asBC_TNZ:
+				case asBC_TS:
+				case asBC_TNS:
+				case asBC_TP:
+				case asBC_TNP:
+				{
+					const char* condition = opcode == asBC_TZ ? "==" : (opcode == asBC_TNZ ? "!=" : (opcode == asBC_TS ? "<" : (opcode == asBC_TNS ? ">=" : (opcode == asBC_TP ? ">" : "<="))));
+					line = vitex::core::stringify::text("regs->value_register = aot_load<int32_t>(%s) %s 0 ? 1 : 0;", value, condition);
+					break;
+				}
+				case asBC_ClrHi:
+					line = vitex::core::stringify::text("aot_store<uint32_t>(%s, aot_load<uint8_t>(%s));", value, value);
+					break;
+				case asBC_NOT:
+					line = vitex::core::stringify::text("aot_store<uint32_t>(%s, aot_load<uint8_t>(%s) == 0 ? 1u : 0u);", target.c_str(), target.c_str());
+					break;
+				case asBC_CMPi:
+				case asBC_CMPu:
+				case asBC_CMPi64:
+				case asBC_CMPu64:
+				{
+					const char* type = opcode == asBC_CMPi ? "int32_t" : (opcode == asBC_CMPu ? "uint32_t" : (opcode == asBC_CMPi64 ? "int64_t" : "uint64_t"));
+					line = vitex::core::stringify::text("{ %s a = aot_load<%s>(%s), b = aot_load<%s>(%s); aot_store<int32_t>(%s, a == b ? 0 : (a < b ? -1 : 1)); }", type, type, target.c_str(), type, slot(pc, 1).c_str(), value);
+					break;
+				}
+				case asBC_CMPf:
+				case asBC_CMPd:
+				{
+					const char* type = opcode == asBC_CMPf ? "float" : "double";
+					line = vitex::core::stringify::text("{ %s v = aot_load<%s>(%s) - aot_load<%s>(%s); aot_store<int32_t>(%s, v == 0 ? 0 : (v < 0 ? -1 : 1)); }", type, type, target.c_str(), type, slot(pc, 1).c_str(), value);
+					break;
+				}
+				case asBC_CMPIi:
+				case asBC_CMPIu:
+				case asBC_CMPIf:
+				{
+					const char* type = opcode == asBC_CMPIi ? "int32_t" : (opcode == asBC_CMPIu ? "uint32_t" : "float");
+					if (opcode == asBC_CMPIf)
+						line = vitex::core::stringify::text("{ float v = aot_load<float>(%s) - aot_load<float>(code + %u); aot_store<int32_t>(%s, v == 0 ? 0 : (v < 0 ? -1 : 1)); }", target.c_str(), offset + 1, value);
+					else
+						line = vitex::core::stringify::text("{ %s a = aot_load<%s>(%s), b = aot_load<%s>(code + %u); aot_store<int32_t>(%s, a == b ? 0 : (a < b ? -1 : 1)); }", type, type, target.c_str(), type, offset + 1, value);
+					break;
+				}
+				case asBC_IncVi:
+				case asBC_DecVi:
+					line = vitex::core::stringify::text("aot_store<uint32_t>(%s, aot_load<uint32_t>(%s) %s 1u);", target.c_str(), target.c_str(), opcode == asBC_IncVi ? "+" : "-");
+					break;
+				case asBC_INCi8:
+				case asBC_DECi8:
+				case asBC_INCi16:
+				case asBC_DECi16:
+				case asBC_INCi:
+				case asBC_DECi:
+				case asBC_INCi64:
+				case asBC_DECi64:
+				case asBC_INCf:
+				case asBC_DECf:
+				case asBC_INCd:
+				case asBC_DECd:
+				{
+					const char* type = opcode == asBC_INCi8 || opcode == asBC_DECi8 ? "uint8_t" : (opcode == asBC_INCi16 || opcode == asBC_DECi16 ? "uint16_t" : (opcode == asBC_INCi || opcode == asBC_DECi ? "uint32_t" : (opcode == asBC_INCi64 || opcode == asBC_DECi64 ? "uint64_t" : (opcode == asBC_INCf || opcode == asBC_DECf ? "float" : "double"))));
+					bool increment = opcode == asBC_INCi8 || opcode == asBC_INCi16 || opcode == asBC_INCi || opcode == asBC_INCi64 || opcode == asBC_INCf || opcode == asBC_INCd;
+					line = vitex::core::stringify::text("{ void* p = aot_load<void*>(%s); aot_store<%s>(p, (%s)(aot_load<%s>(p) %s 1)); }", value, type, type, type, increment ? "+" : "-");
+					break;
+				}
+				case asBC_NEGi:
+				case asBC_NEGi64:
+					line = vitex::core::stringify::text("aot_store<%s>(%s, 0 - aot_load<%s>(%s));", opcode == asBC_NEGi ? "uint32_t" : "uint64_t", target.c_str(), opcode == asBC_NEGi ? "uint32_t" : "uint64_t", target.c_str());
+					break;
+				case asBC_BNOT:
+				case asBC_BNOT64:
+					line = vitex::core::stringify::text("aot_store<%s>(%s, ~aot_load<%s>(%s));", opcode == asBC_BNOT ? "uint32_t" : "uint64_t", target.c_str(), opcode == asBC_BNOT ? "uint32_t" : "uint64_t", target.c_str());
+					break;
+				case asBC_NEGf:
+				case asBC_NEGd:
+					line = vitex::core::stringify::text("aot_store<%s>(%s, -aot_load<%s>(%s));", opcode == asBC_NEGf ? "float" : "double", target.c_str(), opcode == asBC_NEGf ? "float" : "double", target.c_str());
+					break;
+				case asBC_ADDi:
+				case asBC_ADDi64:
+					line = binary(pc, opcode == asBC_ADDi ? "uint32_t" : "uint64_t", "+");
+					break;
+				case asBC_SUBi:
+				case asBC_SUBi64:
+					line = binary(pc, opcode == asBC_SUBi ? "uint32_t" : "uint64_t", "-");
+					break;
+				case asBC_MULi:
+				case asBC_MULi64:
+					line = binary(pc, opcode == asBC_MULi ? "uint32_t" : "uint64_t", "*");
+					break;
+				case asBC_BAND:
+				case asBC_BAND64:
+					line = binary(pc, opcode == asBC_BAND ? "uint32_t" : "uint64_t", "&");
+					break;
+				case asBC_BOR:
+				case asBC_BOR64:
+					line = binary(pc, opcode == asBC_BOR ? "uint32_t" : "uint64_t", "|");
+					break;
+				case asBC_BXOR:
+				case asBC_BXOR64:
+					line = binary(pc, opcode == asBC_BXOR ? "uint32_t" : "uint64_t", "^");
+					break;
+				case asBC_BSLL:
+				case asBC_BSRL:
+				case asBC_BSRA:
+				case asBC_BSLL64:
+				case asBC_BSRL64:
+				case asBC_BSRA64:
+				{
+					bool wide = opcode == asBC_BSLL64 || opcode == asBC_BSRL64 || opcode == asBC_BSRA64;
+					const char* type = opcode == asBC_BSRA ? "int32_t" : (opcode == asBC_BSRA64 ? "int64_t" : (wide ? "uint64_t" : "uint32_t"));
+					line = vitex::core::stringify::text("aot_store<%s>(%s, aot_load<%s>(%s) %s (aot_load<uint32_t>(%s) & %i));", type, target.c_str(), type, slot(pc, 1).c_str(), opcode == asBC_BSLL || opcode == asBC_BSLL64 ? "<<" : ">>", slot(pc, 2).c_str(), wide ? 63 : 31);
+					break;
+				}
+				case asBC_DIVi:
+				case asBC_MODi:
+				case asBC_DIVi64:
+				case asBC_MODi64:
+				case asBC_DIVu:
+				case asBC_MODu:
+				case asBC_DIVu64:
+				case asBC_MODu64:
+				{
+					bool sign = opcode == asBC_DIVi || opcode == asBC_MODi || opcode == asBC_DIVi64 || opcode == asBC_MODi64;
+					bool wide = opcode == asBC_DIVi64 || opcode == asBC_MODi64 || opcode == asBC_DIVu64 || opcode == asBC_MODu64;
+					const char* type = sign ? (wide ? "int64_t" : "int32_t") : (wide ? "uint64_t" : "uint32_t");
+					line = vitex::core::stringify::text("{ %s b = aot_load<%s>(%s); if (b == 0%s) %s aot_store<%s>(%s, aot_load<%s>(%s) %s b); }", type, type, slot(pc, 2).c_str(), sign ? " || b == -1" : "", exit(offset).c_str(), type, target.c_str(), type, slot(pc, 1).c_str(), opcode == asBC_DIVi || opcode == asBC_DIVi64 || opcode == asBC_DIVu || opcode == asBC_DIVu64 ? "/" : "%");
+					break;
+				}
+				case asBC_ADDIi:
+				case asBC_SUBIi:
+				case asBC_MULIi:
+					line = vitex::core::stringify::text("aot_store<uint32_t>(%s, aot_load<uint32_t>(%s) %s 0x%xu);", target.c_str(), slot(pc, 1).c_str(), opcode == asBC_ADDIi ? "+" : (opcode == asBC_SUBIi ? "-" : "*"), (uint32_t)asBC_DWORDARG(pc + 1));
+					break;
+				case asBC_ADDf:
+				case asBC_ADDd:
+					line = binary(pc, opcode == asBC_ADDf ? "float" : "double", "+");
+					break;
+				case asBC_SUBf:
+				case asBC_SUBd:
+					line = binary(pc, opcode == asBC_SUBf ? "float" : "double", "-");
+					break;
+				case asBC_MULf:
+				case asBC_MULd:
+					line = binary(pc, opcode == asBC_MULf ? "float" : "double", "*");
+					break;
+				case asBC_DIVf:
+				case asBC_DIVd:
+				case asBC_MODf:
+				case asBC_MODd:
+				{
+					const char* type = opcode == asBC_DIVf || opcode == asBC_MODf ? "float" : "double";
+					if (opcode == asBC_DIVf || opcode == asBC_DIVd)
+						line = vitex::core::stringify::text("{ %s b = aot_load<%s>(%s); if (b == 0) %s aot_store<%s>(%s, aot_load<%s>(%s) / b); }", type, type, slot(pc, 2).c_str(), exit(offset).c_str(), type, target.c_str(), type, slot(pc, 1).c_str());
+					else
+						line = vitex::core::stringify::text("{ %s b = aot_load<%s>(%s); if (b == 0) %s aot_store<%s>(%s, (%s)std::fmod(aot_load<%s>(%s), b)); }", type, type, slot(pc, 2).c_str(), exit(offset).c_str(), type, target.c_str(), type, type, slot(pc, 1).c_str());
+					break;
+				}
+				case asBC_ADDIf:
+				case asBC_SUBIf:
+				case asBC_MULIf:
+					line = vitex::core::stringify::text("aot_store<float>(%s, aot_load<float>(%s) %s aot_load<float>(code + %u));", target.c_str(), slot(pc, 1).c_str(), opcode == asBC_ADDIf ? "+" : (opcode == asBC_SUBIf ? "-" : "*"), offset + 2);
+					break;
+				case asBC_CpyVtoV4:
+				case asBC_CpyVtoV8:
+					line = vitex::core::stringify::text("aot_store<%s>(%s, aot_load<%s>(%s));", opcode == asBC_CpyVtoV4 ? "uint32_t" : "uint64_t", target.c_str(), opcode == asBC_CpyVtoV4 ? "uint32_t" : "uint64_t", slot(pc, 1).c_str());
+					break;
+				case asBC_CpyVtoR4:
+				case asBC_CpyVtoR8:
+					line = vitex::core::stringify::text("aot_store<%s>(%s, aot_load<%s>(%s));", opcode == asBC_CpyVtoR4 ? "uint32_t" : "uint64_t", value, opcode == asBC_CpyVtoR4 ? "uint32_t" : "uint64_t", target.c_str());
+					break;
+				case asBC_CpyRtoV4:
+				case asBC_CpyRtoV8:
+					line = vitex::core::stringify::text("aot_store<%s>(%s, aot_load<%s>(%s));", opcode == asBC_CpyRtoV4 ? "uint32_t" : "uint64_t", target.c_str(), opcode == asBC_CpyRtoV4 ? "uint32_t" : "uint64_t", value);
+					break;
+				case asBC_SetV1:
+				case asBC_SetV2:
+				case asBC_SetV4:
+					line = vitex::core::stringify::text("aot_store<%s>(%s, (%s)0x%xu);", opcode == asBC_SetV1 ? "uint8_t" : (opcode == asBC_SetV2 ? "uint16_t" : "uint32_t"), target.c_str(), opcode == asBC_SetV1 ? "uint8_t" : (opcode == asBC_SetV2 ? "uint16_t" : "uint32_t"), (uint32_t)asBC_DWORDARG(pc));
+					break;
+				case asBC_SetV8:
+					line = vitex::core::stringify::text("aot_store<uint64_t>(%s, 0x%" PRIx64 "ull);", target.c_str(), (uint64_t)asBC_QWORDARG(pc));
+					break;
+				case asBC_sbTOi:
+					line = convert(pc, "int8_t", "int32_t", "int32_t");
+					break;
+				case asBC_swTOi:
+					line = convert(pc, "int16_t", "int32_t", "int32_t");
+					break;
+				case asBC_ubTOi:
+				case asBC_iTOb:
+					line = convert(pc, "uint8_t", "uint32_t", "uint32_t");
+					break;
+				case asBC_uwTOi:
+				case asBC_iTOw:
+					line = convert(pc, "uint16_t", "uint32_t", "uint32_t");
+					break;
+				case asBC_i64TOi:
+					line = convert(pc, "uint64_t", "uint32_t", "uint32_t");
+					break;
+				case asBC_iTOi64:
+					line = convert(pc, "int32_t", "int64_t", "int64_t");
+					break;
+				case asBC_uTOi64:
+					line = convert(pc, "uint32_t", "uint64_t", "uint64_t");
+					break;
+				case asBC_iTOf:
+					line = convert(pc, "int32_t", "float", "float");
+					break;
+				case asBC_uTOf:
+					line = convert(pc, "uint32_t", "float", "float");
+					break;
+				case asBC_i64TOf:
+					line = convert(pc, "int64_t", "float", "float");
+					break;
+				case asBC_u64TOf:
+					line = convert(pc, "uint64_t", "float", "float");
+					break;
+				case asBC_iTOd:
+					line = convert(pc, "int32_t", "double", "double");
+					break;
+				case asBC_uTOd:
+					line = convert(pc, "uint32_t", "double", "double");
+					break;
+				case asBC_i64TOd:
+					line = convert(pc, "int64_t", "double", "double");
+					break;
+				case asBC_u64TOd:
+					line = convert(pc, "uint64_t", "double", "double");
+					break;
+				case asBC_fTOi:
+					line = convert(pc, "float", "int32_t", "int32_t");
+					break;
+				case asBC_dTOi:
+					line = convert(pc, "double", "int32_t", "int32_t");
+					break;
+				case asBC_fTOu:
+					line = convert(pc, "float", "uint32_t", "int32_t");
+					break;
+				case asBC_dTOu:
+					line = convert(pc, "double", "uint32_t", "int32_t");
+					break;
+				case asBC_fTOi64:
+					line = convert(pc, "float", "int64_t", "int64_t");
+					break;
+				case asBC_dTOi64:
+					line = convert(pc, "double", "int64_t", "int64_t");
+					break;
+				case asBC_fTOu64:
+					line = convert(pc, "float", "uint64_t", "int64_t");
+					break;
+				case asBC_dTOu64:
+					line = convert(pc, "double", "uint64_t", "int64_t");
+					break;
+				case asBC_fTOd:
+					line = convert(pc, "float", "double", "double");
+					break;
+				case asBC_dTOf:
+					line = convert(pc, "double", "float", "float");
+					break;
+				case asBC_RDR1:
+				case asBC_RDR2:
+				case asBC_RDR4:
+				case asBC_RDR8:
+				{
+					const char* type = opcode == asBC_RDR1 ? "uint8_t" : (opcode == asBC_RDR2 ? "uint16_t" : (opcode == asBC_RDR4 ? "uint32_t" : "uint64_t"));
+					line = vitex::core::stringify::text("aot_store<%s>(%s, aot_load<%s>(aot_load<void*>(%s)));", opcode == asBC_RDR8 ? "uint64_t" : "uint32_t", target.c_str(), type, value);
+					break;
+				}
+				case asBC_WRTV1:
+				case asBC_WRTV2:
+				case asBC_WRTV4:
+				case asBC_WRTV8:
+				{
+					const char* type = opcode == asBC_WRTV1 ? "uint8_t" : (opcode == asBC_WRTV2 ? "uint16_t" : (opcode == asBC_WRTV4 ? "uint32_t" : "uint64_t"));
+					line = vitex::core::stringify::text("aot_store<%s>(aot_load<void*>(%s), aot_load<%s>(%s));", type, value, type, target.c_str());
+					break;
+				}
+				case asBC_LDV:
+					line = vitex::core::stringify::text("aot_store<void*>(%s, (void*)%s);", value, target.c_str());
+					break;
+				case asBC_LDG:
+					line = vitex::core::stringify::text("aot_store<void*>(%s, %s);", value, operand(offset).c_str());
+					break;
+				case asBC_CpyGtoV4:
+					line = vitex::core::stringify::text("aot_store<uint32_t>(%s, aot_load<uint32_t>(%s));", target.c_str(), operand(offset).c_str());
+					break;
+				case asBC_CpyVtoG4:
+					line = vitex::core::stringify::text("aot_store<uint32_t>(%s, aot_load<uint32_t>(%s));", operand(offset).c_str(), target.c_str());
+					break;
+				case asBC_LdGRdR4:
+					line = vitex::core::stringify::text("{ void* p = %s; aot_store<void*>(%s, p); aot_store<uint32_t>(%s, aot_load<uint32_t>(p)); }", operand(offset).c_str(), value, target.c_str());
+					break;
+				case asBC_SetG4:
+					line = vitex::core::stringify::text("aot_store<uint32_t>(%s, 0x%xu);", operand(offset).c_str(), (uint32_t)*(pc + 1 + pointer));
+					break;
+				default:
+					break;
+			}
+
+			if (line.empty())
+				line = exit(offset);
+			else
+				++supported;
+			body += "\t\t" + line + "\n";
+			offset += size;
+		}
+
+		if (!supported)
+			return false;
+
+		if (marks[length] & 2)
+			body += vitex::core::stringify::text("\tl_%u:\n", length);
+		body += "\t\t" + exit(length) + "\n";
+
+		source += vitex::core::stringify::text("\tvoid %s(asSVMRegisters* registers, size_t ordinal)\n\t{\n", name.c_str());
+		source += "\t\tvitex::scripting::native_registers* regs = (vitex::scripting::native_registers*)registers;\n";
+		source += "\t\tuint32_t* code = regs->program_pointer;\n";
+		if (body.find("(fp ") != vitex::core::string::npos)
+			source += "\t\tuint32_t* fp = regs->stack_frame_pointer;\n";
+		source += "\t\tuint32_t* sp = regs->stack_pointer;\n\t\tswitch (ordinal)\n\t\t{\n";
+		for (size_t i = 0; i < entries.size(); i++)
+			source += vitex::core::stringify::text("\t\t\tcase %i:\n\t\t\t\tcode -= %u;\n\t\t\t\tgoto l_%u;\n", (int)i + 1, entries[i], entries[i]);
+		source += vitex::core::stringify::text("\t\t\tdefault:\n\t\t\t\tregs->program_pointer += %i;\n\t\t\t\treturn;\n\t\t}\n", (int)asBCTypeSize[asBCInfo[asBC_JitEntry].type]);
+
+		source += body;
+		source += "\t}\n";
+		return true;
+	}
+
+	class native_compiler final : public asIJITCompiler
+	{
+	private:
+		struct native_entry;
+
+		struct native_point
+		{
+			native_entry* base;
+			size_t ordinal;
+		};
+
+		struct native_entry
+		{
+			vitex::core::vector<native_point*> points;
+			std::atomic<vitex::scripting::native_entry_ptr> callable;
+			std::atomic<uint64_t> calls;
+			std::atomic<uint64_t> mismatches;
+			native_compiler* base;
+			uint64_t hash;
+		};
+
+	private:
+		static thread_local bool interpreted;
+		static thread_local bool validating;
+
+	private:
+		vitex::core::unordered_map<vitex::core::string, native_entry*> entries;
+		std::atomic<bool> validation;
+		asIJITCompiler* next;
+		std::mutex exchange;
+
+	public:
+		native_compiler(asIJITCompiler* base) noexcept : validation(false), next(base)
+		{
+		}
+		~native_compiler() noexcept
+		{
+			for (auto& entry : entries)
+			{
+				for (auto* point : entry.second->points)
+					vitex::core::memory::deinit(point);
+				vitex::core::memory::deinit(entry.second);
+			}
+		}
+		void insert(const std::string_view& decl, uint64_t hash, vitex::scripting::native_entry_ptr callable)
+		{
+			std::unique_lock<std::mutex> unique(exchange);
+			auto*& entry = entries[vitex::core::string(decl)];
+			if (!entry)
+			{
+				entry = vitex::core::memory::init<native_entry>();
+				entry->calls = 0;
+				entry->mismatches = 0;
+				entry->base = this;
+			}
+			entry->hash = hash;
+			entry->callable = callable;
+		}
+		void chain(asIJITCompiler* base)
+		{
+			std::unique_lock<std::mutex> unique(exchange);
+			next = base;
+		}
+		void set_validation(bool enabled)
+		{
+			validation = enabled;
+		}
+		size_t get_calls(const std::string_view& decl)
+		{
+			std::unique_lock<std::mutex> unique(exchange);
+			auto it = entries.find(vitex::core::key_lookup_cast(decl));
+			return it != entries.end() ? (size_t)it->second->calls.load() : 0;
+		}
+		size_t get_mismatches(const std::string_view& decl)
+		{
+			std::unique_lock<std::mutex> unique(exchange);
+			auto it = entries.find(vitex::core::key_lookup_cast(decl));
+			return it != entries.end() ? (size_t)it->second->mismatches.load() : 0;
+		}
+		int CompileFunction(asIScriptFunction* function, asJITFunction* output) override
+		{
+			vitex::core::string decl = function->GetDeclaration(true, true, false);
+			std::unique_lock<std::mutex> unique(exchange);
+			auto it = entries.find(decl);
+			if (it == entries.end())
+			{
+				asIJITCompiler* base = next;
+				unique.unlock();
+				return base != nullptr ? base->CompileFunction(function, output) : asNOT_SUPPORTED;
+			}
+
+			native_entry* entry = it->second;
+			uint64_t hash = vitex::scripting::virtual_machine::get_byte_code_hash(function);
+			if (hash != entry->hash)
+			{
+				VI_WARN("asc native function %s is stale: bytecode hash %" PRIu64 " != %" PRIu64 ", using interpreter", decl.c_str(), hash, entry->hash);
+				asIJITCompiler* base = next;
+				unique.unlock();
+				return base != nullptr ? base->CompileFunction(function, output) : asNOT_SUPPORTED;
+			}
+
+			asUINT length = 0;
+			asDWORD* code = function->GetByteCode(&length);
+			size_t ordinal = 0;
+			for (asUINT offset = 0; code != nullptr && offset < length;)
+			{
+				asBYTE opcode = *(asBYTE*)(code + offset);
+				if (opcode == asBC_JitEntry)
+				{
+					if (entry->points.size() <= ordinal)
+					{
+						native_point* point = vitex::core::memory::init<native_point>();
+						point->base = entry;
+						point->ordinal = ordinal + 1;
+						entry->points.push_back(point);
+					}
+					asBC_PTRARG(code + offset) = (asPWORD)entry->points[ordinal++];
+				}
+				offset += std::max<asUINT>(1, asBCTypeSize[asBCInfo[opcode].type]);
+			}
+
+			if (!ordinal)
+			{
+				VI_WARN("asc native function %s has no jit entry points: enable jit instructions before building, using interpreter", decl.c_str());
+				return asNOT_SUPPORTED;
+			}
+
+			VI_DEBUG("asc native function %s bound at %i entry points", decl.c_str(), (int)ordinal);
+			*output = &native_compiler::execute;
+			return asSUCCESS;
+		}
+		void ReleaseJITFunction(asJITFunction function) override
+		{
+			if (function == &native_compiler::execute)
+				return;
+
+			std::unique_lock<std::mutex> unique(exchange);
+			asIJITCompiler* base = next;
+			unique.unlock();
+			if (base != nullptr)
+				base->ReleaseJITFunction(function);
+		}
+
+	private:
+		static void validate(asSVMRegisters* registers, native_entry* entry)
+		{
+			asIScriptContext* context = (asIScriptContext*)registers->ctx;
+			asIScriptFunction* function = context->GetFunction(0);
+			if (!function || function->GetObjectType() != nullptr)
+				return;
+
+			asDWORD flags = 0;
+			asIScriptEngine* engine = function->GetEngine();
+			int type_id = function->GetReturnTypeId(&flags);
+			if ((type_id & asTYPEID_MASK_OBJECT) || (flags & asTM_INOUTREF))
+				return;
+
+			size_t return_size = type_id != asTYPEID_VOID ? (size_t)engine->GetSizeOfPrimitiveType(type_id) : 0;
+			vitex::core::vector<std::pair<asQWORD, size_t>> args;
+			asDWORD* frame = registers->stackFramePointer;
+			for (asUINT i = 0; i < function->GetParamCount(); i++)
+			{
+				if (function->GetParam(i, &type_id, &flags) < 0 || (type_id & asTYPEID_MASK_OBJECT) || (flags & asTM_INOUTREF))
+					return;
+
+				int size = engine->GetSizeOfPrimitiveType(type_id);
+				if (size <= 0 || size > (int)sizeof(asQWORD))
+					return;
+
+				asQWORD value = 0;
+				memcpy(&value, frame, (size_t)size);
+				args.push_back(std::make_pair(value, (size_t)size));
+				frame += size > (int)sizeof(asDWORD) ? 2 : 1;
+			}
+
+			asQWORD results[2] = { 0, 0 };
+			int states[2] = { asERROR, asERROR };
+			validating = true;
+			for (size_t i = 0; i < 2; i++)
+			{
+				asIScriptContext* next = engine->RequestContext();
+				if (!next)
+					break;
+
+				interpreted = (i == 0);
+				int status = next->Prepare(function);
+				for (asUINT j = 0; status >= 0 && j < (asUINT)args.size(); j++)
+				{
+					auto& arg = args[j];
+					if (arg.second == sizeof(asBYTE))
+						status = next->SetArgByte(j, (asBYTE)arg.first);
+					else if (arg.second == sizeof(asWORD))
+						status = next->SetArgWord(j, (asWORD)arg.first);
+					else if (arg.second == sizeof(asDWORD))
+						status = next->SetArgDWord(j, (asDWORD)arg.first);
+					else
+						status = next->SetArgQWord(j, arg.first);
+				}
+				if (status >= 0)
+					status = next->Execute();
+				if (status == asEXECUTION_FINISHED && return_size > 0)
+					memcpy(&results[i], next->GetAddressOfReturnValue(), std::min(return_size, sizeof(asQWORD)));
+				states[i] = status;
+				engine->ReturnContext(next);
+			}
+			interpreted = false;
+			validating = false;
+
+			if (states[0] == states[1] && results[0] == results[1])
+				return;
+
+			entry->mismatches.fetch_add(1, std::memory_order_relaxed);
+			VI_ERR("asc native function %s diverges from interpreter: state %i != %i, result 0x%" PRIx64 " != 0x%" PRIx64, function->GetDeclaration(true, true, false), states[0], states[1], (uint64_t)results[0], (uint64_t)results[1]);
+		}
+		static void execute(asSVMRegisters* registers, asPWORD argument)
+		{
+			native_point* point = (native_point*)argument;
+			native_entry* entry = point->base;
+			if (interpreted)
+			{
+				registers->programPointer += asBCTypeSize[asBCInfo[asBC_JitEntry].type];
+				return;
+			}
+
+			if (point->ordinal == 1 && !validating && entry->base->validation.load(std::memory_order_relaxed))
+				validate(registers, entry);
+
+			entry->calls.fetch_add(1, std::memory_order_relaxed);
+			entry->callable.load(std::memory_order_relaxed)(registers, point->ordinal);
+		}
+	};
+	thread_local bool native_compiler::interpreted = false;
+	thread_local bool native_compiler::validating = false;
+#if defined(JIT_TARGET_X64) || defined(JIT_TARGET_ARM64)
+	enum class jit_register
+	{
+		a,
+		b
+	};
+
+	enum class jit_base
+	{
+		frame,
+		stack,
+		registers,
+		pointer
+	};
+
+	enum class jit_operation
+	{
+		add,
+		sub,
+		mul,
+		sdiv,
+		udiv,
+		srem,
+		urem,
+		band,
+		bor,
+		bxor,
+		shl,
+		shr,
+		sar
+	};
+
+	enum class jit_condition
+	{
+		eq,
+		ne,
+		lt,
+		ge,
+		gt,
+		le
+	};
+
+	enum class jit_comparison
+	{
+		s32,
+		u32,
+		s64,
+		u64,
+		f32,
+		f64
+	};
+
+	enum class jit_conversion
+	{
+		i32_f32,
+		u32_f32,
+		i64_f32,
+		i32_f64,
+		u32_f64,
+		i64_f64,
+		f32_i32,
+		f64_i32,
+		f32_i64,
+		f64_i64,
+		f32_f64,
+		f64_f32
+	};
+
+	class jit_memory
+	{
+	public:
+		static size_t page_size()
+		{
+#ifdef VI_MICROSOFT
+			SYSTEM_INFO info;
+			GetSystemInfo(&info);
+			return (size_t)info.dwPageSize;
+#else
+			long size = sysconf(_SC_PAGESIZE);
+			return size > 0 ? (size_t)size : 4096;
+#endif
+		}
+		static size_t align(size_t size)
+		{
+			size_t page = page_size();
+			return (size + page - 1) / page * page;
+		}
+		static uint8_t* allocate(size_t size)
+		{
+#ifdef VI_MICROSOFT
+			return (uint8_t*)VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+#else
+			void* address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			return address != MAP_FAILED ? (uint8_t*)address : nullptr;
+#endif
+		}
+		static bool seal(uint8_t* address, size_t size)
+		{
+#ifdef VI_MICROSOFT
+			DWORD protection = 0;
+			if (!VirtualProtect(address, size, PAGE_EXECUTE_READ, &protection))
+				return false;
+
+			FlushInstructionCache(GetCurrentProcess(), address, size);
+			return true;
+#else
+			if (mprotect(address, size, PROT_READ | PROT_EXEC) != 0)
+				return false;
+
+			__builtin___clear_cache((char*)address, (char*)address + size);
+			return true;
+#endif
+		}
+		static void free(uint8_t* address, size_t size)
+		{
+#ifdef VI_MICROSOFT
+			VirtualFree(address, 0, MEM_RELEASE);
+#else
+			munmap(address, size);
+#endif
+		}
+	};
+
+	class jit_assembler
+	{
+	private:
+		struct fixup
+		{
+			size_t offset;
+			size_t label;
+			bool wide;
+		};
+
+	private:
+		vitex::core::vector<uint8_t> code;
+		vitex::core::vector<size_t> labels;
+		vitex::core::vector<fixup> fixups;
+
+	public:
+		size_t label()
+		{
+			labels.push_back(std::numeric_limits<size_t>::max());
+			return labels.size() - 1;
+		}
+		void bind(size_t id)
+		{
+			labels[id] = code.size();
+		}
+		bool link()
+		{
+			for (auto& next : fixups)
+			{
+				size_t target = labels[next.label];
+				if (target == std::numeric_limits<size_t>::max())
+					return false;
+#ifdef JIT_TARGET_X64
+				int32_t distance = (int32_t)((int64_t)target - (int64_t)(next.offset + sizeof(int32_t)));
+				memcpy(code.data() + next.offset, &distance, sizeof(distance));
+#else
+				int64_t distance = ((int64_t)target - (int64_t)next.offset) / 4;
+				int64_t limit = next.wide ? (1 << 25) : (1 << 18);
+				if (distance < -limit || distance >= limit)
+					return false;
+
+				uint32_t instruction;
+				memcpy(&instruction, code.data() + next.offset, sizeof(instruction));
+				instruction |= next.wide ? ((uint32_t)distance & 0x3FFFFFF) : (((uint32_t)distance & 0x7FFFF) << 5);
+				memcpy(code.data() + next.offset, &instruction, sizeof(instruction));
+#endif
+			}
+			return true;
+		}
+		size_t offset_of(size_t id) const
+		{
+			return labels[id];
+		}
+		size_t size() const
+		{
+			return code.size();
+		}
+		const uint8_t* data() const
+		{
+			return code.data();
+		}
+#ifdef JIT_TARGET_X64
+		void prologue()
+		{
+			emit({ 0x53, 0x41, 0x54, 0x41, 0x55, 0x48, 0x83, 0xEC, 0x20 });
+#ifdef VI_MICROSOFT
+			emit({ 0x48, 0x89, 0xCB });
+#else
+			emit({ 0x48, 0x89, 0xFB });
+#endif
+			encode(0, true, { 0x8B }, 12, 3, (int32_t)offsetof(asSVMRegisters, stackFramePointer));
+			encode(0, true, { 0x8B }, 13, 3, (int32_t)offsetof(asSVMRegisters, stackPointer));
+#ifdef VI_MICROSOFT
+			emit({ 0xFF, 0xE2 });
+#else
+			emit({ 0xFF, 0xE6 });
+#endif
+		}
+		void epilogue(size_t exit, size_t leave)
+		{
+			bind(exit);
+			encode(0, true, { 0x89 }, 0, 3, (int32_t)offsetof(asSVMRegisters, programPointer));
+			encode(0, true, { 0x89 }, 13, 3, (int32_t)offsetof(asSVMRegisters, stackPointer));
+			bind(leave);
+			emit({ 0x48, 0x83, 0xC4, 0x20, 0x41, 0x5D, 0x41, 0x5C, 0x5B, 0xC3 });
+		}
+		void load(jit_register reg, size_t size, bool sign, jit_base base, int32_t disp)
+		{
+			uint8_t target = hardware(reg), source = hardware(base);
+			switch (size)
+			{
+				case 1:
+					encode(0, sign, { 0x0F, (uint8_t)(sign ? 0xBE : 0xB6) }, target, source, disp);
+					break;
+				case 2:
+					encode(0, sign, { 0x0F, (uint8_t)(sign ? 0xBF : 0xB7) }, target, source, disp);
+					break;
+				case 4:
+					encode(0, sign, { (uint8_t)(sign ? 0x63 : 0x8B) }, target, source, disp);
+					break;
+				default:
+					encode(0, true, { 0x8B }, target, source, disp);
+					break;
+			}
+		}
+		void store(jit_register reg, size_t size, jit_base base, int32_t disp)
+		{
+			uint8_t source = hardware(reg), target = hardware(base);
+			switch (size)
+			{
+				case 1:
+					encode(0, false, { 0x88 }, source, target, disp);
+					break;
+				case 2:
+					encode(0x66, false, { 0x89 }, source, target, disp);
+					break;
+				case 4:
+					encode(0, false, { 0x89 }, source, target, disp);
+					break;
+				default:
+					encode(0, true, { 0x89 }, source, target, disp);
+					break;
+			}
+		}
+		void load_float(jit_register reg, bool wide, jit_base base, int32_t disp)
+		{
+			encode(wide ? 0xF2 : 0xF3, false, { 0x0F, 0x10 }, hardware(reg), hardware(base), disp);
+		}
+		void store_float(jit_register reg, bool wide, jit_base base, int32_t disp)
+		{
+			encode(wide ? 0xF2 : 0xF3, false, { 0x0F, 0x11 }, hardware(reg), hardware(base), disp);
+		}
+		void address(jit_register reg, jit_base base, int32_t disp)
+		{
+			encode(0, true, { 0x8D }, hardware(reg), hardware(base), disp);
+		}
+		void move(jit_register reg, uint64_t value)
+		{
+			uint8_t target = hardware(reg);
+			if (value <= std::numeric_limits<uint32_t>::max())
+			{
+				emit((uint8_t)(0xB8 + target));
+				emit32((uint32_t)value);
+			}
+			else if ((int64_t)value >= std::numeric_limits<int32_t>::min() && (int64_t)value < 0)
+			{
+				emit({ 0x48, 0xC7, (uint8_t)(0xC0 + target) });
+				emit32((uint32_t)value);
+			}
+			else
+			{
+				emit({ 0x48, (uint8_t)(0xB8 + target) });
+				emit64(value);
+			}
+		}
+		void move_float(jit_register target, jit_register source, bool wide)
+		{
+			direct(0x66, wide, { 0x0F, 0x6E }, hardware(target), hardware(source));
+		}
+		void adjust(int32_t bytes)
+		{
+			encode(0, true, { 0x8D }, 13, 13, bytes);
+		}
+		void compute(jit_operation operation, bool wide)
+		{
+			switch (operation)
+			{
+				case jit_operation::add:
+					direct(0, wide, { 0x01 }, 1, 0);
+					break;
+				case jit_operation::sub:
+					direct(0, wide, { 0x29 }, 1, 0);
+					break;
+				case jit_operation::mul:
+					direct(0, wide, { 0x0F, 0xAF }, 0, 1);
+					break;
+				case jit_operation::band:
+					direct(0, wide, { 0x21 }, 1, 0);
+					break;
+				case jit_operation::bor:
+					direct(0, wide, { 0x09 }, 1, 0);
+					break;
+				case jit_operation::bxor:
+					direct(0, wide, { 0x31 }, 1, 0);
+					break;
+				case jit_operation::shl:
+					direct(0, wide, { 0xD3 }, 4, 0);
+					break;
+				case jit_operation::shr:
+					direct(0, wide, { 0xD3 }, 5, 0);
+					break;
+				case jit_operation::sar:
+					direct(0, wide, { 0xD3 }, 7, 0);
+					break;
+				case jit_operation::sdiv:
+				case jit_operation::srem:
+					if (wide)
+						emit({ 0x48, 0x99 });
+					else
+						emit(0x99);
+					direct(0, wide, { 0xF7 }, 7, 1);
+					if (operation == jit_operation::srem)
+						direct(0, wide, { 0x89 }, 2, 0);
+					break;
+				case jit_operation::udiv:
+				case jit_operation::urem:
+					direct(0, false, { 0x31 }, 2, 2);
+					direct(0, wide, { 0xF7 }, 6, 1);
+					if (operation == jit_operation::urem)
+						direct(0, wide, { 0x89 }, 2, 0);
+					break;
+			}
+		}
+		void negate(bool wide)
+		{
+			direct(0, wide, { 0xF7 }, 3, 0);
+		}
+		void invert(bool wide)
+		{
+			direct(0, wide, { 0xF7 }, 2, 0);
+		}
+		void increment(jit_register reg, bool wide, int32_t value)
+		{
+			direct(0, wide, { 0x81 }, 0, hardware(reg));
+			emit32((uint32_t)value);
+		}
+		void compute_float(jit_operation operation, bool wide)
+		{
+			uint8_t opcode = 0x58;
+			switch (operation)
+			{
+				case jit_operation::sub:
+					opcode = 0x5C;
+					break;
+				case jit_operation::mul:
+					opcode = 0x59;
+					break;
+				case jit_operation::sdiv:
+					opcode = 0x5E;
+					break;
+				default:
+					break;
+			}
+			direct(wide ? 0xF2 : 0xF3, false, { 0x0F, opcode }, 0, 1);
+		}
+		void convert(jit_conversion conversion)
+		{
+			switch (conversion)
+			{
+				case jit_conversion::i32_f32:
+					direct(0xF3, false, { 0x0F, 0x2A }, 0, 0);
+					break;
+				case jit_conversion::u32_f32:
+					direct(0, false, { 0x89 }, 0, 0);
+					direct(0xF3, true, { 0x0F, 0x2A }, 0, 0);
+					break;
+				case jit_conversion::i64_f32:
+					direct(0xF3, true, { 0x0F, 0x2A }, 0, 0);
+					break;
+				case jit_conversion::i32_f64:
+					direct(0xF2, false, { 0x0F, 0x2A }, 0, 0);
+					break;
+				case jit_conversion::u32_f64:
+					direct(0, false, { 0x89 }, 0, 0);
+					direct(0xF2, true, { 0x0F, 0x2A }, 0, 0);
+					break;
+				case jit_conversion::i64_f64:
+					direct(0xF2, true, { 0x0F, 0x2A }, 0, 0);
+					break;
+				case jit_conversion::f32_i32:
+					direct(0xF3, false, { 0x0F, 0x2C }, 0, 0);
+					break;
+				case jit_conversion::f64_i32:
+					direct(0xF2, false, { 0x0F, 0x2C }, 0, 0);
+					break;
+				case jit_conversion::f32_i64:
+					direct(0xF3, true, { 0x0F, 0x2C }, 0, 0);
+					break;
+				case jit_conversion::f64_i64:
+					direct(0xF2, true, { 0x0F, 0x2C }, 0, 0);
+					break;
+				case jit_conversion::f32_f64:
+					direct(0xF3, false, { 0x0F, 0x5A }, 0, 0);
+					break;
+				case jit_conversion::f64_f32:
+					direct(0xF2, false, { 0x0F, 0x5A }, 0, 0);
+					break;
+			}
+		}
+		void compare(jit_comparison comparison)
+		{
+			switch (comparison)
+			{
+				case jit_comparison::s32:
+				case jit_comparison::s64:
+					direct(0, comparison == jit_comparison::s64, { 0x39 }, 1, 0);
+					emit({ 0x0F, 0x9F, 0xC1, 0x0F, 0x9C, 0xC0 });
+					break;
+				case jit_comparison::u32:
+				case jit_comparison::u64:
+					direct(0, comparison == jit_comparison::u64, { 0x39 }, 1, 0);
+					emit({ 0x0F, 0x97, 0xC1, 0x0F, 0x92, 0xC0 });
+					break;
+				case jit_comparison::f32:
+				case jit_comparison::f64:
+					if (comparison == jit_comparison::f64)
+						emit(0x66);
+					emit({ 0x0F, 0x2E, 0xC8, 0x0F, 0x92, 0xC1, 0x0F, 0x97, 0xC0 });
+					break;
+			}
+			emit({ 0x0F, 0xB6, 0xC9, 0x0F, 0xB6, 0xC0, 0x29, 0xC1, 0x89, 0xC8 });
+		}
+		void test(jit_condition condition)
+		{
+			emit({ 0x85, 0xC0, 0x0F, (uint8_t)(0x90 + code_of(condition)), 0xC0, 0x0F, 0xB6, 0xC0 });
+		}
+		void jump(size_t id)
+		{
+			emit(0xE9);
+			relative(id);
+		}
+		void branch(jit_condition condition, size_t id)
+		{
+			emit({ 0x85, 0xC0, 0x0F, (uint8_t)(0x80 + code_of(condition)) });
+			relative(id);
+		}
+		void branch_if(jit_register reg, bool wide, int64_t value, size_t id)
+		{
+			uint8_t target = hardware(reg);
+			if (value == 0)
+			{
+				direct(0, wide, { 0x85 }, target, target);
+			}
+			else
+			{
+				direct(0, wide, { 0x83 }, 7, target);
+				emit((uint8_t)value);
+			}
+			emit({ 0x0F, 0x84 });
+			relative(id);
+		}
+		void branch_if_zero_float(bool wide, size_t id)
+		{
+			emit({ 0x0F, 0x57, 0xD2 });
+			if (wide)
+				emit(0x66);
+			emit({ 0x0F, 0x2E, 0xCA, 0x0F, 0x84 });
+			relative(id);
+		}
+		void branch_if_suspend(size_t id)
+		{
+			encode(0, false, { 0x80 }, 7, 3, (int32_t)offsetof(asSVMRegisters, doProcessSuspend));
+			emit({ 0x00, 0x0F, 0x85 });
+			relative(id);
+		}
+		void call(void* callable, void* argument, uint64_t next, size_t leave)
+		{
+			move(jit_register::a, next);
+			encode(0, true, { 0x89 }, 0, 3, (int32_t)offsetof(asSVMRegisters, programPointer));
+			encode(0, true, { 0x89 }, 13, 3, (int32_t)offsetof(asSVMRegisters, stackPointer));
+#ifdef VI_MICROSOFT
+			emit({ 0x48, 0x89, 0xD9, 0x48, 0xBA });
+#else
+			emit({ 0x48, 0x89, 0xDF, 0x48, 0xBE });
+#endif
+			emit64((uint64_t)(uintptr_t)argument);
+			emit({ 0x48, 0xB8 });
+			emit64((uint64_t)(uintptr_t)callable);
+			emit({ 0xFF, 0xD0 });
+			jump(leave);
+		}
+		void exit(uint64_t next, size_t id)
+		{
+			move(jit_register::a, next);
+			jump(id);
+		}
+
+	public:
+		static void thunk(uint8_t* target, void* callable)
+		{
+			uint64_t address = (uint64_t)(uintptr_t)callable;
+			uint8_t code[JIT_THUNK_SIZE] = { 0x48, 0xB8, 0, 0, 0, 0, 0, 0, 0, 0, 0xFF, 0xE0, 0xCC, 0xCC, 0xCC, 0xCC };
+			memcpy(code + 2, &address, sizeof(address));
+			memcpy(target, code, sizeof(code));
+		}
+
+	private:
+		void emit(uint8_t value)
+		{
+			code.push_back(value);
+		}
+		void emit(std::initializer_list<uint8_t> values)
+		{
+			code.insert(code.end(), values.begin(), values.end());
+		}
+		void emit32(uint32_t value)
+		{
+			for (size_t i = 0; i < sizeof(value); i++)
+				code.push_back((uint8_t)(value >> (i * 8)));
+		}
+		void emit64(uint64_t value)
+		{
+			for (size_t i = 0; i < sizeof(value); i++)
+				code.push_back((uint8_t)(value >> (i * 8)));
+		}
+		void relative(size_t id)
+		{
+			fixups.push_back({ code.size(), id, true });
+			emit32(0);
+		}
+		void prefix(uint8_t operand, bool wide, uint8_t reg, uint8_t base)
+		{
+			if (operand != 0)
+				emit(operand);
+
+			uint8_t rex = (uint8_t)(0x40 | (wide ? 0x08 : 0) | ((reg & 8) ? 0x04 : 0) | ((base & 8) ? 0x01 : 0));
+			if (rex != 0x40)
+				emit(rex);
+		}
+		void encode(uint8_t operand, bool wide, std::initializer_list<uint8_t> opcode, uint8_t reg, uint8_t base, int32_t disp)
+		{
+			prefix(operand, wide, reg, base);
+			emit(opcode);
+			emit((uint8_t)(0x80 | ((reg & 7) << 3) | (base & 7)));
+			if ((base & 7) == 4)
+				emit(0x24);
+			emit32((uint32_t)disp);
+		}
+		void direct(uint8_t operand, bool wide, std::initializer_list<uint8_t> opcode, uint8_t reg, uint8_t base)
+		{
+			prefix(operand, wide, reg, base);
+			emit(opcode);
+			emit((uint8_t)(0xC0 | ((reg & 7) << 3) | (base & 7)));
+		}
+
+	private:
+		static uint8_t hardware(jit_register reg)
+		{
+			return reg == jit_register::a ? 0 : 1;
+		}
+		static uint8_t hardware(jit_base base)
+		{
+			switch (base)
+			{
+				case jit_base::frame:
+					return 12;
+				case jit_base::stack:
+					return 13;
+				case jit_base::registers:
+					return 3;
+				case jit_base::pointer:
+				default:
+					return 1;
+			}
+		}
+		static uint8_t code_of(jit_condition condition)
+		{
+			switch (condition)
+			{
+				case jit_condition::eq:
+					return 0x4;
+				case jit_condition::ne:
+					return 0x5;
+				case jit_condition::lt:
+					return 0xC;
+				case jit_condition::ge:
+					return 0xD;
+				case jit_condition::gt:
+					return 0xF;
+				case jit_condition::le:
+				default:
+					return 0xE;
+			}
+		}
+#else
+		void prologue()
+		{
+			emit(0xA9BD7BFD);
+			emit(0x910003FD);
+			emit(0xA90153F3);
+			emit(0xF90013F5);
+			emit(0xAA0003F3);
+			memory(0xF8400000, 20, 19, (int32_t)offsetof(asSVMRegisters, stackFramePointer));
+			memory(0xF8400000, 21, 19, (int32_t)offsetof(asSVMRegisters, stackPointer));
+			emit(0xD61F0020);
+		}
+		void epilogue(size_t exit, size_t leave)
+		{
+			bind(exit);
+			memory(0xF8000000, 0, 19, (int32_t)offsetof(asSVMRegisters, programPointer));
+			memory(0xF8000000, 21, 19, (int32_t)offsetof(asSVMRegisters, stackPointer));
+			bind(leave);
+			emit(0xF94013F5);
+			emit(0xA94153F3);
+			emit(0xA8C37BFD);
+			emit(0xD65F03C0);
+		}
+		void load(jit_register reg, size_t size, bool sign, jit_base base, int32_t disp)
+		{
+			uint32_t opcode;
+			switch (size)
+			{
+				case 1:
+					opcode = sign ? 0x38800000 : 0x38400000;
+					break;
+				case 2:
+					opcode = sign ? 0x78800000 : 0x78400000;
+					break;
+				case 4:
+					opcode = sign ? 0xB8800000 : 0xB8400000;
+					break;
+				default:
+					opcode = 0xF8400000;
+					break;
+			}
+			memory(opcode, hardware(reg), hardware(base), disp);
+		}
+		void store(jit_register reg, size_t size, jit_base base, int32_t disp)
+		{
+			uint32_t opcode;
+			switch (size)
+			{
+				case 1:
+					opcode = 0x38000000;
+					break;
+				case 2:
+					opcode = 0x78000000;
+					break;
+				case 4:
+					opcode = 0xB8000000;
+					break;
+				default:
+					opcode = 0xF8000000;
+					break;
+			}
+			memory(opcode, hardware(reg), hardware(base), disp);
+		}
+		void load_float(jit_register reg, bool wide, jit_base base, int32_t disp)
+		{
+			memory(wide ? 0xFC400000 : 0xBC400000, hardware(reg), hardware(base), disp);
+		}
+		void store_float(jit_register reg, bool wide, jit_base base, int32_t disp)
+		{
+			memory(wide ? 0xFC000000 : 0xBC000000, hardware(reg), hardware(base), disp);
+		}
+		void address(jit_register reg, jit_base base, int32_t disp)
+		{
+			uint32_t target = hardware(reg), source = hardware(base);
+			if (disp >= 0 && disp <= 4095)
+			{
+				emit(0x91000000 | ((uint32_t)disp << 10) | (source << 5) | target);
+			}
+			else if (disp < 0 && disp >= -4095)
+			{
+				emit(0xD1000000 | ((uint32_t)-disp << 10) | (source << 5) | target);
+			}
+			else
+			{
+				constant(16, (uint64_t)(int64_t)disp);
+				emit(0x8B000000 | (16 << 16) | (source << 5) | target);
+			}
+		}
+		void move(jit_register reg, uint64_t value)
+		{
+			constant(hardware(reg), value);
+		}
+		void move_float(jit_register target, jit_register source, bool wide)
+		{
+			emit((wide ? 0x9E670000 : 0x1E270000) | (hardware(source) << 5) | hardware(target));
+		}
+		void adjust(int32_t bytes)
+		{
+			if (bytes >= 0)
+				emit(0x91000000 | ((uint32_t)bytes << 10) | (21 << 5) | 21);
+			else
+				emit(0xD1000000 | ((uint32_t)-bytes << 10) | (21 << 5) | 21);
+		}
+		void compute(jit_operation operation, bool wide)
+		{
+			uint32_t size = wide ? 0x80000000 : 0, operands = (1 << 16) | (0 << 5) | 0;
+			switch (operation)
+			{
+				case jit_operation::add:
+					emit(0x0B000000 | size | operands);
+					break;
+				case jit_operation::sub:
+					emit(0x4B000000 | size | operands);
+					break;
+				case jit_operation::mul:
+					emit(0x1B007C00 | size | operands);
+					break;
+				case jit_operation::band:
+					emit(0x0A000000 | size | operands);
+					break;
+				case jit_operation::bor:
+					emit(0x2A000000 | size | operands);
+					break;
+				case jit_operation::bxor:
+					emit(0x4A000000 | size | operands);
+					break;
+				case jit_operation::shl:
+					emit(0x1AC02000 | size | operands);
+					break;
+				case jit_operation::shr:
+					emit(0x1AC02400 | size | operands);
+					break;
+				case jit_operation::sar:
+					emit(0x1AC02800 | size | operands);
+					break;
+				case jit_operation::sdiv:
+					emit(0x1AC00C00 | size | operands);
+					break;
+				case jit_operation::udiv:
+					emit(0x1AC00800 | size | operands);
+					break;
+				case jit_operation::srem:
+					emit(0x1AC00C00 | size | (1 << 16) | (0 << 5) | 2);
+					emit(0x1B008000 | size | (1 << 16) | (0 << 10) | (2 << 5) | 0);
+					break;
+				case jit_operation::urem:
+					emit(0x1AC00800 | size | (1 << 16) | (0 << 5) | 2);
+					emit(0x1B008000 | size | (1 << 16) | (0 << 10) | (2 << 5) | 0);
+					break;
+			}
+		}
+		void negate(bool wide)
+		{
+			emit(0x4B0003E0 | (wide ? 0x80000000 : 0));
+		}
+		void invert(bool wide)
+		{
+			emit(0x2A2003E0 | (wide ? 0x80000000 : 0));
+		}
+		void increment(jit_register reg, bool wide, int32_t value)
+		{
+			uint32_t target = hardware(reg), size = wide ? 0x80000000 : 0;
+			if (value >= 0)
+				emit(0x11000000 | size | ((uint32_t)value << 10) | (target << 5) | target);
+			else
+				emit(0x51000000 | size | ((uint32_t)-value << 10) | (target << 5) | target);
+		}
+		void compute_float(jit_operation operation, bool wide)
+		{
+			uint32_t opcode = 0x1E202800;
+			switch (operation)
+			{
+				case jit_operation::sub:
+					opcode = 0x1E203800;
+					break;
+				case jit_operation::mul:
+					opcode = 0x1E200800;
+					break;
+				case jit_operation::sdiv:
+					opcode = 0x1E201800;
+					break;
+				default:
+					break;
+			}
+			emit(opcode | (wide ? 0x00400000 : 0) | (1 << 16) | (0 << 5) | 0);
+		}
+		void convert(jit_conversion conversion)
+		{
+			switch (conversion)
+			{
+				case jit_conversion::i32_f32:
+					emit(0x1E220000);
+					break;
+				case jit_conversion::u32_f32:
+					emit(0x1E230000);
+					break;
+				case jit_conversion::i64_f32:
+					emit(0x9E220000);
+					break;
+				case jit_conversion::i32_f64:
+					emit(0x1E620000);
+					break;
+				case jit_conversion::u32_f64:
+					emit(0x1E630000);
+					break;
+				case jit_conversion::i64_f64:
+					emit(0x9E620000);
+					break;
+				case jit_conversion::f32_i32:
+					emit(0x1E380000);
+					break;
+				case jit_conversion::f64_i32:
+					emit(0x1E780000);
+					break;
+				case jit_conversion::f32_i64:
+					emit(0x9E380000);
+					break;
+				case jit_conversion::f64_i64:
+					emit(0x9E780000);
+					break;
+				case jit_conversion::f32_f64:
+					emit(0x1E22C000);
+					break;
+				case jit_conversion::f64_f32:
+					emit(0x1E624000);
+					break;
+			}
+		}
+		void compare(jit_comparison comparison)
+		{
+			switch (comparison)
+			{
+				case jit_comparison::s32:
+					emit(0x6B00001F | (1 << 16));
+					select(2, 12, false);
+					select(0, 11, true);
+					break;
+				case jit_comparison::u32:
+					emit(0x6B00001F | (1 << 16));
+					select(2, 8, false);
+					select(0, 3, true);
+					break;
+				case jit_comparison::s64:
+					emit(0xEB00001F | (1 << 16));
+					select(2, 12, false);
+					select(0, 11, true);
+					break;
+				case jit_comparison::u64:
+					emit(0xEB00001F | (1 << 16));
+					select(2, 8, false);
+					select(0, 3, true);
+					break;
+				case jit_comparison::f32:
+					emit(0x1E202000 | (1 << 16));
+					select(2, 8, false);
+					select(0, 4, true);
+					break;
+				case jit_comparison::f64:
+					emit(0x1E602000 | (1 << 16));
+					select(2, 8, false);
+					select(0, 4, true);
+					break;
+			}
+			emit(0x2A000000 | (2 << 16) | (0 << 5) | 0);
+		}
+		void test(jit_condition condition)
+		{
+			emit(0x7100001F);
+			select(0, code_of(condition), false);
+		}
+		void jump(size_t id)
+		{
+			relative(0x14000000, id, true);
+		}
+		void branch(jit_condition condition, size_t id)
+		{
+			if (condition == jit_condition::eq)
+				return relative(0x34000000, id, false);
+			else if (condition == jit_condition::ne)
+				return relative(0x35000000, id, false);
+
+			emit(0x7100001F);
+			relative(0x54000000 | code_of(condition), id, false);
+		}
+		void branch_if(jit_register reg, bool wide, int64_t value, size_t id)
+		{
+			uint32_t target = hardware(reg);
+			if (value == 0)
+				return relative((wide ? 0xB4000000 : 0x34000000) | target, id, false);
+
+			emit((wide ? 0xB100001F : 0x3100001F) | (1 << 10) | (target << 5));
+			relative(0x54000000, id, false);
+		}
+		void branch_if_zero_float(bool wide, size_t id)
+		{
+			emit((wide ? 0x1E602008 : 0x1E202008) | (1 << 5));
+			relative(0x54000000, id, false);
+			relative(0x54000006, id, false);
+		}
+		void branch_if_suspend(size_t id)
+		{
+			memory(0x38400000, 2, 19, (int32_t)offsetof(asSVMRegisters, doProcessSuspend));
+			relative(0x35000002, id, false);
+		}
+		void call(void* callable, void* argument, uint64_t next, size_t leave)
+		{
+			constant(0, next);
+			memory(0xF8000000, 0, 19, (int32_t)offsetof(asSVMRegisters, programPointer));
+			memory(0xF8000000, 21, 19, (int32_t)offsetof(asSVMRegisters, stackPointer));
+			emit(0xAA1303E0);
+			constant(1, (uint64_t)(uintptr_t)argument);
+			constant(16, (uint64_t)(uintptr_t)callable);
+			emit(0xD63F0200);
+			jump(leave);
+		}
+		void exit(uint64_t next, size_t id)
+		{
+			constant(0, next);
+			jump(id);
+		}
+
+	public:
+		static void thunk(uint8_t* target, void* callable)
+		{
+			uint64_t address = (uint64_t)(uintptr_t)callable;
+			uint32_t code[JIT_THUNK_SIZE / sizeof(uint32_t)] = { 0x58000050, 0xD61F0200, 0, 0 };
+			memcpy(code + 2, &address, sizeof(address));
+			memcpy(target, code, sizeof(code));
+		}
+
+	private:
+		void emit(uint32_t instruction)
+		{
+			for (size_t i = 0; i < sizeof(instruction); i++)
+				code.push_back((uint8_t)(instruction >> (i * 8)));
+		}
+		void relative(uint32_t instruction, size_t id, bool wide)
+		{
+			fixups.push_back({ code.size(), id, wide });
+			emit(instruction);
+		}
+		void constant(uint32_t target, uint64_t value)
+		{
+			emit(0xD2800000 | ((uint32_t)(value & 0xFFFF) << 5) | target);
+			for (uint32_t shift = 1; shift < 4; shift++)
+			{
+				uint32_t part = (uint32_t)(value >> (shift * 16)) & 0xFFFF;
+				if (part != 0)
+					emit(0xF2800000 | (shift << 21) | (part << 5) | target);
+			}
+		}
+		void memory(uint32_t opcode, uint32_t target, uint32_t base, int32_t disp)
+		{
+			if (disp >= -256 && disp <= 255)
+				return emit(opcode | (((uint32_t)disp & 0x1FF) << 12) | (base << 5) | target);
+
+			constant(16, (uint64_t)(int64_t)disp);
+			emit(0x8B000000 | (16 << 16) | (base << 5) | 16);
+			emit(opcode | (16 << 5) | target);
+		}
+		void select(uint32_t target, uint32_t condition, bool mask)
+		{
+			emit((mask ? 0x5A9F03E0 : 0x1A9F07E0) | ((condition ^ 1) << 12) | target);
+		}
+
+	private:
+		static uint32_t hardware(jit_register reg)
+		{
+			return reg == jit_register::a ? 0 : 1;
+		}
+		static uint32_t hardware(jit_base base)
+		{
+			switch (base)
+			{
+				case jit_base::frame:
+					return 20;
+				case jit_base::stack:
+					return 21;
+				case jit_base::registers:
+					return 19;
+				case jit_base::pointer:
+				default:
+					return 1;
+			}
+		}
+		static uint32_t code_of(jit_condition condition)
+		{
+			switch (condition)
+			{
+				case jit_condition::eq:
+					return 0;
+				case jit_condition::ne:
+					return 1;
+				case jit_condition::lt:
+					return 11;
+				case jit_condition::ge:
+					return 10;
+				case jit_condition::gt:
+					return 12;
+				case jit_condition::le:
+				default:
+					return 13;
+			}
+		}
+#endif
+	};
+
+	class jit_compiler final : public asIJITCompiler
+	{
+	public:
+		struct stats
+		{
+			size_t functions = 0;
+			size_t compiled = 0;
+			size_t failed = 0;
+			size_t entries = 0;
+			size_t code_size = 0;
+		};
+
+	private:
+		typedef void(*code_ptr)(asSVMRegisters*, uint8_t*);
+
+	private:
+		struct jit_function;
+
+		struct jit_point
+		{
+			jit_function* base;
+			std::atomic<uint8_t*> target;
+		};
+
+		struct jit_function
+		{
+			vitex::core::vector<jit_point*> points;
+			jit_compiler* base = nullptr;
+			asIScriptFunction* source = nullptr;
+			uint8_t* thunk = nullptr;
+			uint8_t* code = nullptr;
+			size_t size = 0;
+			std::atomic<uint64_t> calls = { 0 };
+			std::atomic<bool> failed = { false };
+		};
+
+	private:
+		vitex::core::unordered_map<uint8_t*, jit_function*> functions;
+		vitex::core::vector<std::pair<uint8_t*, size_t>> pages;
+		vitex::core::vector<uint8_t*> thunks;
+		std::atomic<uint64_t> threshold;
+		std::atomic<size_t> compiled;
+		std::atomic<size_t> failed;
+		std::atomic<size_t> entries;
+		std::atomic<size_t> code_size;
+		std::atomic<bool> active;
+		std::mutex exchange;
+
+	public:
+		jit_compiler() noexcept : threshold(64), compiled(0), failed(0), entries(0), code_size(0), active(false)
+		{
+		}
+		~jit_compiler() noexcept
+		{
+			for (auto& function : functions)
+				release(function.second);
+			for (auto& page : pages)
+				jit_memory::free(page.first, page.second);
+		}
+		void activate(bool enabled, size_t call_threshold)
+		{
+			threshold = std::max<size_t>(1, call_threshold);
+			active = enabled;
+		}
+		stats get_stats()
+		{
+			std::unique_lock<std::mutex> unique(exchange);
+			stats result;
+			result.functions = functions.size();
+			result.compiled = compiled.load();
+			result.failed = failed.load();
+			result.entries = entries.load();
+			result.code_size = code_size.load();
+			return result;
+		}
+		int CompileFunction(asIScriptFunction* function, asJITFunction* output) override
+		{
+			if (!active)
+				return asNOT_SUPPORTED;
+
+			asUINT length = 0;
+			asDWORD* code = function->GetByteCode(&length);
+			size_t count = 0;
+			for (asUINT offset = 0; code != nullptr && offset < length;)
+			{
+				asBYTE opcode = *(asBYTE*)(code + offset);
+				if (opcode == asBC_JitEntry)
+					++count;
+				offset += std::max<asUINT>(1, asBCTypeSize[asBCInfo[opcode].type]);
+			}
+
+			if (!count)
+				return asNOT_SUPPORTED;
+
+			std::unique_lock<std::mutex> unique(exchange);
+			uint8_t* thunk = allocate_thunk();
+			if (!thunk)
+				return asERROR;
+
+			jit_function* entry = vitex::core::memory::init<jit_function>();
+			entry->base = this;
+			entry->source = function;
+			entry->thunk = thunk;
+			for (asUINT offset = 0; offset < length;)
+			{
+				asBYTE opcode = *(asBYTE*)(code + offset);
+				if (opcode == asBC_JitEntry)
+				{
+					jit_point* point = vitex::core::memory::init<jit_point>();
+					point->base = entry;
+					point->target = nullptr;
+					entry->points.push_back(point);
+					asBC_PTRARG(code + offset) = (asPWORD)point;
+				}
+				offset += std::max<asUINT>(1, asBCTypeSize[asBCInfo[opcode].type]);
+			}
+
+			functions[thunk] = entry;
+			*output = (asJITFunction)thunk;
+			return asSUCCESS;
+		}
+		void ReleaseJITFunction(asJITFunction function) override
+		{
+			std::unique_lock<std::mutex> unique(exchange);
+			auto it = functions.find((uint8_t*)function);
+			if (it == functions.end())
+				return;
+
+			thunks.push_back(it->first);
+			release(it->second);
+			functions.erase(it);
+		}
+
+	private:
+		uint8_t* allocate_thunk()
+		{
+			if (thunks.empty())
+			{
+				size_t size = jit_memory::align(JIT_THUNK_SIZE);
+				uint8_t* page = jit_memory::allocate(size);
+				if (!page)
+					return nullptr;
+
+				for (size_t offset = 0; offset + JIT_THUNK_SIZE <= size; offset += JIT_THUNK_SIZE)
+					jit_assembler::thunk(page + offset, (void*)&jit_compiler::dispatch);
+
+				if (!jit_memory::seal(page, size))
+				{
+					jit_memory::free(page, size);
+					return nullptr;
+				}
+
+				pages.push_back(std::make_pair(page, size));
+				for (size_t offset = size; offset >= JIT_THUNK_SIZE; offset -= JIT_THUNK_SIZE)
+					thunks.push_back(page + offset - JIT_THUNK_SIZE);
+			}
+
+			uint8_t* thunk = thunks.back();
+			thunks.pop_back();
+			return thunk;
+		}
+		void release(jit_function* function)
+		{
+			if (function->code != nullptr)
+			{
+				jit_memory::free(function->code, function->size);
+				code_size -= function->size;
+			}
+			for (auto* point : function->points)
+				vitex::core::memory::deinit(point);
+			vitex::core::memory::deinit(function);
+		}
+		void compile(jit_function* function)
+		{
+			std::unique_lock<std::mutex> unique(exchange);
+			if (function->code != nullptr || function->failed)
+				return;
+
+			asUINT length = 0;
+			asDWORD* code = function->source->GetByteCode(&length);
+			jit_assembler assembler;
+			vitex::core::vector<size_t> labels;
+			if (!generate(function->source, code, length, assembler, labels))
+			{
+				VI_DEBUG("asc jit skipped %s: no compilable instructions", function->source->GetDeclaration(true, true, false));
+				function->failed = true;
+				++failed;
+				return;
+			}
+
+			size_t size = jit_memory::align(assembler.size());
+			uint8_t* address = jit_memory::allocate(size);
+			if (!address)
+			{
+				function->failed = true;
+				++failed;
+				return;
+			}
+
+			memcpy(address, assembler.data(), assembler.size());
+			if (!jit_memory::seal(address, size))
+			{
+				jit_memory::free(address, size);
+				function->failed = true;
+				++failed;
+				return;
+			}
+
+			function->code = address;
+			function->size = size;
+			size_t ordinal = 0;
+			for (asUINT offset = 0; offset < length;)
+			{
+				asBYTE opcode = *(asBYTE*)(code + offset);
+				if (opcode == asBC_JitEntry && ordinal < function->points.size())
+					function->points[ordinal++]->target.store(address + assembler.offset_of(labels[offset]), std::memory_order_release);
+				offset += std::max<asUINT>(1, asBCTypeSize[asBCInfo[opcode].type]);
+			}
+
+			code_size += size;
+			++compiled;
+			VI_DEBUG("asc jit compiled %s: %i bytecode dwords into %i bytes", function->source->GetDeclaration(true, true, false), (int)length, (int)assembler.size());
+		}
+		bool generate(asIScriptFunction* function, asDWORD* code, asUINT length, jit_assembler& assembler, vitex::core::vector<size_t>& labels)
+		{
+			labels.assign((size_t)length + 1, std::numeric_limits<size_t>::max());
+			for (asUINT offset = 0; offset < length;)
+			{
+				asBYTE opcode = *(asBYTE*)(code + offset);
+				labels[offset] = assembler.label();
+				offset += std::max<asUINT>(1, asBCTypeSize[asBCInfo[opcode].type]);
+			}
+			labels[length] = assembler.label();
+
+			vitex::core::vector<std::pair<size_t, asUINT>> guards;
+			asIScriptEngine* engine = function->GetEngine();
+			size_t exit = assembler.label(), leave = assembler.label(), supported = 0;
+			auto address = [code](asUINT offset) { return (uint64_t)(uintptr_t)(code + offset); };
+			auto guard = [&guards, &assembler](asUINT offset)
+			{
+				guards.push_back(std::make_pair(assembler.label(), offset));
+				return guards.back().first;
+			};
+			auto jump = [&labels, code, length](asUINT offset, asUINT size, size_t* label)
+			{
+				int64_t target = (int64_t)offset + (int64_t)size + (int64_t)asBC_INTARG(code + offset);
+				if (target < 0 || target > (int64_t)length || labels[(size_t)target] == std::numeric_limits<size_t>::max())
+					return false;
+
+				*label = labels[(size_t)target];
+				return true;
+			};
+			auto var = [](asDWORD* pc, size_t index) { return (int32_t)-4 * (int32_t)*((short*)pc + 1 + index); };
+			int32_t value = (int32_t)offsetof(asSVMRegisters, valueRegister);
+
+			assembler.prologue();
+			for (asUINT offset = 0; offset < length;)
+			{
+				asDWORD* pc = code + offset;
+				asBYTE opcode = *(asBYTE*)pc;
+				asUINT size = std::max<asUINT>(1, asBCTypeSize[asBCInfo[opcode].type]);
+				bool wide = false, sign = false, in_place = asBCInfo[opcode].type != asBCTYPE_wW_rW_ARG;
+				int32_t source = in_place ? var(pc, 0) : var(pc, 1), target = var(pc, 0);
+				jit_operation operation = jit_operation::add;
+				jit_condition condition = jit_condition::eq;
+				jit_comparison comparison = jit_comparison::s32;
+				jit_conversion conversion = jit_conversion::i32_f32;
+				size_t bytes = 4, label = 0;
+				assembler.bind(labels[offset]);
+				++supported;
+				switch (opcode)
+				{
+					case asBC_JitEntry:
+						--supported;
+						break;
+					case asBC_SUSPEND:
+						assembler.branch_if_suspend(guard(offset));
+						break;
+					case asBC_PshC4:
+						assembler.move(jit_register::a, asBC_DWORDARG(pc));
+						assembler.adjust(-4);
+						assembler.store(jit_register::a, 4, jit_base::stack, 0);
+						break;
+					case asBC_PshC8:
+						assembler.move(jit_register::a, asBC_QWORDARG(pc));
+						assembler.adjust(-8);
+						assembler.store(jit_register::a, 8, jit_base::stack, 0);
+						break;
+					case asBC_PshV4:
+					case asBC_PshV8:
+					case asBC_PshVPtr:
+						bytes = opcode == asBC_PshV4 ? 4 : 8;
+						assembler.load(jit_register::a, bytes, false, jit_base::frame, target);
+						assembler.adjust(-(int32_t)bytes);
+						assembler.store(jit_register::a, bytes, jit_base::stack, 0);
+						break;
+					case asBC_PSF:
+						assembler.address(jit_register::a, jit_base::frame, target);
+						assembler.adjust(-(int32_t)sizeof(asPWORD));
+						assembler.store(jit_register::a, sizeof(asPWORD), jit_base::stack, 0);
+						break;
+					case asBC_PGA:
+						assembler.move(jit_register::a, asBC_PTRARG(pc));
+						assembler.adjust(-(int32_t)sizeof(asPWORD));
+						assembler.store(jit_register::a, sizeof(asPWORD), jit_base::stack, 0);
+						break;
+					case asBC_PshG4:
+						assembler.move(jit_register::b, asBC_PTRARG(pc));
+						assembler.load(jit_register::a, 4, false, jit_base::pointer, 0);
+						assembler.adjust(-4);
+						assembler.store(jit_register::a, 4, jit_base::stack, 0);
+						break;
+					case asBC_PopPtr:
+						assembler.adjust((int32_t)sizeof(asPWORD));
+						break;
+					case asBC_JMP:
+						if (!jump(offset, size, &label))
+							return false;
+						assembler.jump(label);
+						break;
+					case asBC_JZ:
+					case asBC_JNZ:
+					case asBC_JS:
+					case asBC_JNS:
+					case asBC_JP:
+					case asBC_JNP:
+					case asBC_JLowZ:
+					case asBC_JLowNZ:
+						if (!jump(offset, size, &label))
+							return false;
+						condition = opcode == asBC_JZ || opcode == asBC_JLowZ ? jit_condition::eq : (opcode == asBC_JNZ || opcode == asBC_JLowNZ ? jit_condition::ne : (opcode == asBC_JS ? jit_condition::lt : (opcode == asBC_JNS ? jit_condition::ge : (opcode == asBC_JP ? jit_condition::gt : jit_condition::le))));
+						assembler.load(jit_register::a, opcode == asBC_JLowZ || opcode == asBC_JLowNZ ? 1 : 4, false, jit_base::registers, value);
+						assembler.branch(condition, label);
+						break;
+					case asBC_TZ:
+					case asBC_TNZ:
+					case asBC_TS:
+					case asBC_TNS:
+					case asBC_TP:
+					case asBC_TNP:
+						condition = opcode == asBC_TZ ? jit_condition::eq : (opcode == asBC_TNZ ? jit_condition::ne : (opcode == asBC_TS ? jit_condition::lt : (opcode == asBC_TNS ? jit_condition::ge : (opcode == asBC_TP ? jit_condition::gt : jit_condition::le))));
+						assembler.load(jit_register::a, 4, false, jit_base::registers, value);
+						assembler.test(condition);
+						assembler.store(jit_register::a, 8, jit_base::registers, value);
+						break;
+					case asBC_ClrHi:
+						assembler.load(jit_register::a, 1, false, jit_base::registers, value);
+						assembler.store(jit_register::a, 4, jit_base::registers, value);
+						break;
+					case asBC_NOT:
+						assembler.load(jit_register::a, 1, false, jit_base::frame, target);
+						assembler.test(jit_condition::eq);
+						assembler.store(jit_register::a, 4, jit_base::frame, target);
+						break;
+					case asBC_CMPi:
+					case asBC_CMPu:
+					case asBC_CMPi64:
+					case asBC_CMPu64:
+						wide = opcode == asBC_CMPi64 || opcode == asBC_CMPu64;
+						comparison = opcode == asBC_CMPi ? jit_comparison::s32 : (opcode == asBC_CMPu ? jit_comparison::u32 : (opcode == asBC_CMPi64 ? jit_comparison::s64 : jit_comparison::u64));
+						assembler.load(jit_register::a, wide ? 8 : 4, false, jit_base::frame, var(pc, 0));
+						assembler.load(jit_register::b, wide ? 8 : 4, false, jit_base::frame, var(pc, 1));
+						assembler.compare(comparison);
+						assembler.store(jit_register::a, 4, jit_base::registers, value);
+						break;
+					case asBC_CMPf:
+					case asBC_CMPd:
+						wide = opcode == asBC_CMPd;
+						assembler.load_float(jit_register::a, wide, jit_base::frame, var(pc, 0));
+						assembler.load_float(jit_register::b, wide, jit_base::frame, var(pc, 1));
+						assembler.compare(wide ? jit_comparison::f64 : jit_comparison::f32);
+						assembler.store(jit_register::a, 4, jit_base::registers, value);
+						break;
+					case asBC_CMPIi:
+					case asBC_CMPIu:
+						assembler.load(jit_register::a, 4, false, jit_base::frame, target);
+						assembler.move(jit_register::b, asBC_DWORDARG(pc));
+						assembler.compare(opcode == asBC_CMPIi ? jit_comparison::s32 : jit_comparison::u32);
+						assembler.store(jit_register::a, 4, jit_base::registers, value);
+						break;
+					case asBC_CMPIf:
+						assembler.load_float(jit_register::a, false, jit_base::frame, target);
+						assembler.move(jit_register::b, asBC_DWORDARG(pc));
+						assembler.move_float(jit_register::b, jit_register::b, false);
+						assembler.compare(jit_comparison::f32);
+						assembler.store(jit_register::a, 4, jit_base::registers, value);
+						break;
+					case asBC_IncVi:
+					case asBC_DecVi:
+						assembler.load(jit_register::a, 4, false, jit_base::frame, target);
+						assembler.increment(jit_register::a, false, opcode == asBC_IncVi ? 1 : -1);
+						assembler.store(jit_register::a, 4, jit_base::frame, target);
+						break;
+					case asBC_INCi:
+					case asBC_DECi:
+					case asBC_INCi64:
+					case asBC_DECi64:
+						wide = opcode == asBC_INCi64 || opcode == asBC_DECi64;
+						assembler.load(jit_register::b, sizeof(asPWORD), false, jit_base::registers, value);
+						assembler.load(jit_register::a, wide ? 8 : 4, false, jit_base::pointer, 0);
+						assembler.increment(jit_register::a, wide, opcode == asBC_INCi || opcode == asBC_INCi64 ? 1 : -1);
+						assembler.store(jit_register::a, wide ? 8 : 4, jit_base::pointer, 0);
+						break;
+					case asBC_NEGi:
+					case asBC_NEGi64:
+					case asBC_BNOT:
+					case asBC_BNOT64:
+						wide = opcode == asBC_NEGi64 || opcode == asBC_BNOT64;
+						assembler.load(jit_register::a, wide ? 8 : 4, false, jit_base::frame, target);
+						if (opcode == asBC_NEGi || opcode == asBC_NEGi64)
+							assembler.negate(wide);
+						else
+							assembler.invert(wide);
+						assembler.store(jit_register::a, wide ? 8 : 4, jit_base::frame, target);
+						break;
+					case asBC_NEGf:
+					case asBC_NEGd:
+						wide = opcode == asBC_NEGd;
+						assembler.load(jit_register::a, wide ? 8 : 4, false, jit_base::frame, target);
+						assembler.move(jit_register::b, wide ? 0x8000000000000000ull : 0x80000000ull);
+						assembler.compute(jit_operation::bxor, wide);
+						assembler.store(jit_register::a, wide ? 8 : 4, jit_base::frame, target);
+						break;
+					case asBC_ADDi:
+					case asBC_SUBi:
+					case asBC_MULi:
+					case asBC_DIVi:
+					case asBC_MODi:
+					case asBC_DIVu:
+					case asBC_MODu:
+					case asBC_BAND:
+					case asBC_BOR:
+					case asBC_BXOR:
+					case asBC_BSLL:
+					case asBC_BSRL:
+					case asBC_BSRA:
+					case asBC_ADDi64:
+					case asBC_SUBi64:
+					case asBC_MULi64:
+					case asBC_DIVi64:
+					case asBC_MODi64:
+					case asBC_DIVu64:
+					case asBC_MODu64:
+					case asBC_BAND64:
+					case asBC_BOR64:
+					case asBC_BXOR64:
+					case asBC_BSLL64:
+					case asBC_BSRL64:
+					case asBC_BSRA64:
+						switch (opcode)
+						{
+							case asBC_SUBi:
+							case asBC_SUBi64:
+								operation = jit_operation::sub;
+								break;
+							case asBC_MULi:
+							case asBC_MULi64:
+								operation = jit_operation::mul;
+								break;
+							case asBC_DIVi:
+							case asBC_DIVi64:
+								operation = jit_operation::sdiv;
+								break;
+							case asBC_MODi:
+							case asBC_MODi64:
+								operation = jit_operation::srem;
+								break;
+							case asBC_DIVu:
+							case asBC_DIVu64:
+								operation = jit_operation::udiv;
+								break;
+							case asBC_MODu:
+							case asBC_MODu64:
+								operation = jit_operation::urem;
+								break;
+							case asBC_BAND:
+							case asBC_BAND64:
+								operation = jit_operation::band;
+								break;
+							case asBC_BOR:
+							case asBC_BOR64:
+								operation = jit_operation::bor;
+								break;
+							case asBC_BXOR:
+							case asBC_BXOR64:
+								operation = jit_operation::bxor;
+								break;
+							case asBC_BSLL:
+							case asBC_BSLL64:
+								operation = jit_operation::shl;
+								break;
+							case asBC_BSRL:
+							case asBC_BSRL64:
+								operation = jit_operation::shr;
+								break;
+							case asBC_BSRA:
+							case asBC_BSRA64:
+								operation = jit_operation::sar;
+								break;
+							default:
+								operation = jit_operation::add;
+								break;
+						}
+						wide = opcode == asBC_ADDi64 || opcode == asBC_SUBi64 || opcode == asBC_MULi64 || opcode == asBC_DIVi64 || opcode == asBC_MODi64 || opcode == asBC_DIVu64 || opcode == asBC_MODu64 || opcode == asBC_BAND64 || opcode == asBC_BOR64 || opcode == asBC_BXOR64 || opcode == asBC_BSLL64 || opcode == asBC_BSRL64 || opcode == asBC_BSRA64;
+						sign = operation == jit_operation::shl || operation == jit_operation::shr || operation == jit_operation::sar;
+						assembler.load(jit_register::a, wide ? 8 : 4, false, jit_base::frame, var(pc, 1));
+						assembler.load(jit_register::b, wide && !sign ? 8 : 4, false, jit_base::frame, var(pc, 2));
+						if (operation == jit_operation::sdiv || operation == jit_operation::srem)
+						{
+							label = guard(offset);
+							assembler.branch_if(jit_register::b, wide, 0, label);
+							assembler.branch_if(jit_register::b, wide, -1, label);
+						}
+						else if (operation == jit_operation::udiv || operation == jit_operation::urem)
+							assembler.branch_if(jit_register::b, wide, 0, guard(offset));
+						assembler.compute(operation, wide);
+						assembler.store(jit_register::a, wide ? 8 : 4, jit_base::frame, target);
+						break;
+					case asBC_ADDIi:
+					case asBC_SUBIi:
+					case asBC_MULIi:
+						assembler.load(jit_register::a, 4, false, jit_base::frame, var(pc, 1));
+						assembler.move(jit_register::b, (asDWORD)asBC_INTARG(pc + 1));
+						assembler.compute(opcode == asBC_ADDIi ? jit_operation::add : (opcode == asBC_SUBIi ? jit_operation::sub : jit_operation::mul), false);
+						assembler.store(jit_register::a, 4, jit_base::frame, target);
+						break;
+					case asBC_ADDf:
+					case asBC_SUBf:
+					case asBC_MULf:
+					case asBC_DIVf:
+					case asBC_ADDd:
+					case asBC_SUBd:
+					case asBC_MULd:
+					case asBC_DIVd:
+						wide = opcode == asBC_ADDd || opcode == asBC_SUBd || opcode == asBC_MULd || opcode == asBC_DIVd;
+						operation = opcode == asBC_ADDf || opcode == asBC_ADDd ? jit_operation::add : (opcode == asBC_SUBf || opcode == asBC_SUBd ? jit_operation::sub : (opcode == asBC_MULf || opcode == asBC_MULd ? jit_operation::mul : jit_operation::sdiv));
+						assembler.load_float(jit_register::a, wide, jit_base::frame, var(pc, 1));
+						assembler.load_float(jit_register::b, wide, jit_base::frame, var(pc, 2));
+						if (operation == jit_operation::sdiv)
+							assembler.branch_if_zero_float(wide, guard(offset));
+						assembler.compute_float(operation, wide);
+						assembler.store_float(jit_register::a, wide, jit_base::frame, target);
+						break;
+					case asBC_ADDIf:
+					case asBC_SUBIf:
+					case asBC_MULIf:
+						assembler.load_float(jit_register::a, false, jit_base::frame, var(pc, 1));
+						assembler.move(jit_register::b, asBC_DWORDARG(pc + 1));
+						assembler.move_float(jit_register::b, jit_register::b, false);
+						assembler.compute_float(opcode == asBC_ADDIf ? jit_operation::add : (opcode == asBC_SUBIf ? jit_operation::sub : jit_operation::mul), false);
+						assembler.store_float(jit_register::a, false, jit_base::frame, target);
+						break;
+					case asBC_CpyVtoV4:
+					case asBC_CpyVtoV8:
+						bytes = opcode == asBC_CpyVtoV4 ? 4 : 8;
+						assembler.load(jit_register::a, bytes, false, jit_base::frame, var(pc, 1));
+						assembler.store(jit_register::a, bytes, jit_base::frame, target);
+						break;
+					case asBC_CpyVtoR4:
+					case asBC_CpyVtoR8:
+						bytes = opcode == asBC_CpyVtoR4 ? 4 : 8;
+						assembler.load(jit_register::a, bytes, false, jit_base::frame, target);
+						assembler.store(jit_register::a, bytes, jit_base::registers, value);
+						break;
+					case asBC_CpyRtoV4:
+					case asBC_CpyRtoV8:
+						bytes = opcode == asBC_CpyRtoV4 ? 4 : 8;
+						assembler.load(jit_register::a, bytes, false, jit_base::registers, value);
+						assembler.store(jit_register::a, bytes, jit_base::frame, target);
+						break;
+					case asBC_SetV1:
+					case asBC_SetV2:
+					case asBC_SetV4:
+						bytes = opcode == asBC_SetV1 ? 1 : (opcode == asBC_SetV2 ? 2 : 4);
+						assembler.move(jit_register::a, asBC_DWORDARG(pc));
+						assembler.store(jit_register::a, bytes, jit_base::frame, target);
+						break;
+					case asBC_SetV8:
+						assembler.move(jit_register::a, asBC_QWORDARG(pc));
+						assembler.store(jit_register::a, 8, jit_base::frame, target);
+						break;
+					case asBC_sbTOi:
+					case asBC_swTOi:
+					case asBC_ubTOi:
+					case asBC_uwTOi:
+					case asBC_iTOb:
+					case asBC_iTOw:
+					case asBC_i64TOi:
+					case asBC_iTOi64:
+					case asBC_uTOi64:
+						bytes = opcode == asBC_sbTOi || opcode == asBC_ubTOi || opcode == asBC_iTOb ? 1 : (opcode == asBC_swTOi || opcode == asBC_uwTOi || opcode == asBC_iTOw ? 2 : 4);
+						sign = opcode == asBC_sbTOi || opcode == asBC_swTOi || opcode == asBC_iTOi64;
+						assembler.load(jit_register::a, bytes, sign, jit_base::frame, source);
+						assembler.store(jit_register::a, opcode == asBC_iTOi64 || opcode == asBC_uTOi64 ? 8 : 4, jit_base::frame, target);
+						break;
+					case asBC_iTOf:
+					case asBC_uTOf:
+					case asBC_i64TOf:
+					case asBC_iTOd:
+					case asBC_uTOd:
+					case asBC_i64TOd:
+						conversion = opcode == asBC_iTOf ? jit_conversion::i32_f32 : (opcode == asBC_uTOf ? jit_conversion::u32_f32 : (opcode == asBC_i64TOf ? jit_conversion::i64_f32 : (opcode == asBC_iTOd ? jit_conversion::i32_f64 : (opcode == asBC_uTOd ? jit_conversion::u32_f64 : jit_conversion::i64_f64))));
+						assembler.load(jit_register::a, opcode == asBC_i64TOf || opcode == asBC_i64TOd ? 8 : 4, false, jit_base::frame, source);
+						assembler.convert(conversion);
+						assembler.store_float(jit_register::a, opcode == asBC_iTOd || opcode == asBC_uTOd || opcode == asBC_i64TOd, jit_base::frame, target);
+						break;
+					case asBC_fTOi:
+					case asBC_dTOi:
+					case asBC_fTOi64:
+					case asBC_dTOi64:
+						wide = opcode == asBC_dTOi || opcode == asBC_dTOi64;
+						conversion = opcode == asBC_fTOi ? jit_conversion::f32_i32 : (opcode == asBC_dTOi ? jit_conversion::f64_i32 : (opcode == asBC_fTOi64 ? jit_conversion::f32_i64 : jit_conversion::f64_i64));
+						assembler.load_float(jit_register::a, wide, jit_base::frame, source);
+						assembler.convert(conversion);
+						assembler.store(jit_register::a, opcode == asBC_fTOi64 || opcode == asBC_dTOi64 ? 8 : 4, jit_base::frame, target);
+						break;
+					case asBC_fTOd:
+					case asBC_dTOf:
+						wide = opcode == asBC_dTOf;
+						assembler.load_float(jit_register::a, wide, jit_base::frame, source);
+						assembler.convert(wide ? jit_conversion::f64_f32 : jit_conversion::f32_f64);
+						assembler.store_float(jit_register::a, !wide, jit_base::frame, target);
+						break;
+					case asBC_RDR1:
+					case asBC_RDR2:
+					case asBC_RDR4:
+					case asBC_RDR8:
+						bytes = opcode == asBC_RDR1 ? 1 : (opcode == asBC_RDR2 ? 2 : (opcode == asBC_RDR4 ? 4 : 8));
+						assembler.load(jit_register::b, sizeof(asPWORD), false, jit_base::registers, value);
+						assembler.load(jit_register::a, bytes, false, jit_base::pointer, 0);
+						assembler.store(jit_register::a, std::max<size_t>(4, bytes), jit_base::frame, target);
+						break;
+					case asBC_WRTV1:
+					case asBC_WRTV2:
+					case asBC_WRTV4:
+					case asBC_WRTV8:
+						bytes = opcode == asBC_WRTV1 ? 1 : (opcode == asBC_WRTV2 ? 2 : (opcode == asBC_WRTV4 ? 4 : 8));
+						assembler.load(jit_register::b, sizeof(asPWORD), false, jit_base::registers, value);
+						assembler.load(jit_register::a, bytes, false, jit_base::frame, target);
+						assembler.store(jit_register::a, bytes, jit_base::pointer, 0);
+						break;
+					case asBC_LDV:
+						assembler.address(jit_register::a, jit_base::frame, target);
+						assembler.store(jit_register::a, sizeof(asPWORD), jit_base::registers, value);
+						break;
+					case asBC_LDG:
+						assembler.move(jit_register::a, asBC_PTRARG(pc));
+						assembler.store(jit_register::a, sizeof(asPWORD), jit_base::registers, value);
+						break;
+					case asBC_CpyGtoV4:
+						assembler.move(jit_register::b, asBC_PTRARG(pc));
+						assembler.load(jit_register::a, 4, false, jit_base::pointer, 0);
+						assembler.store(jit_register::a, 4, jit_base::frame, target);
+						break;
+					case asBC_CpyVtoG4:
+						assembler.move(jit_register::b, asBC_PTRARG(pc));
+						assembler.load(jit_register::a, 4, false, jit_base::frame, target);
+						assembler.store(jit_register::a, 4, jit_base::pointer, 0);
+						break;
+					case asBC_LdGRdR4:
+						assembler.move(jit_register::b, asBC_PTRARG(pc));
+						assembler.store(jit_register::b, sizeof(asPWORD), jit_base::registers, value);
+						assembler.load(jit_register::a, 4, false, jit_base::pointer, 0);
+						assembler.store(jit_register::a, 4, jit_base::frame, target);
+						break;
+					case asBC_SetG4:
+						assembler.move(jit_register::b, asBC_PTRARG(pc));
+						assembler.move(jit_register::a, *(pc + 1 + sizeof(asPWORD) / sizeof(asDWORD)));
+						assembler.store(jit_register::a, 4, jit_base::pointer, 0);
+						break;
+					case asBC_CALL:
+					{
+						asIScriptFunction* callable = engine->GetFunctionById(asBC_INTARG(pc));
+						if (callable != nullptr && callable->GetFuncType() == asFUNC_SCRIPT)
+						{
+							assembler.call((void*)&jit_compiler::invoke, callable, address(offset + size), leave);
+							break;
+						}
+						--supported;
+						assembler.exit(address(offset), exit);
+						break;
+					}
+					default:
+						--supported;
+						assembler.exit(address(offset), exit);
+						break;
+				}
+				offset += size;
+			}
+
+			assembler.bind(labels[length]);
+			assembler.exit(address(length), exit);
+			for (auto& next : guards)
+			{
+				assembler.bind(next.first);
+				assembler.exit(address(next.second), exit);
+			}
+			assembler.epilogue(exit, leave);
+			return supported > 0 && assembler.link();
 		}
-	};
-
-	struct denum
-	{
-		vitex::core::vector<vitex::core::string> values;
-	};
-
-	struct dclass
-	{
-		vitex::core::vector<vitex::core::string> props;
-		vitex::core::vector<vitex::core::string> interfaces;
-		vitex::core::vector<vitex::core::string> types;
-		vitex::core::vector<vitex::core::string> funcdefs;
-		vitex::core::vector<vitex::core::string> methods;
-		vitex::core::vector<vitex::core::string> functions;
-	};
-
-	struct dnamespace
-	{
-		vitex::core::unordered_map<vitex::core::string, denum> enums;
-		vitex::core::unordered_map<vitex::core::string, dclass> classes;
-		vitex::core::vector<vitex::core::string> funcdefs;
-		vitex::core::vector<vitex::core::string> functions;
-	};
 
-	vitex::core::string get_combination(const vitex::core::vector<vitex::core::string>& names, const vitex::core::string& by)
-	{
-		vitex::core::string result;
-		for (size_t i = 0; i < names.size(); i++)
+	private:
+		static void invoke(asSVMRegisters* registers, void* function)
 		{
-			result.append(names[i]);
-			if (i + 1 < names.size())
-				result.append(by);
+			((asCContext*)registers->ctx)->CallScriptFunction((asCScriptFunction*)function);
 		}
-
-		return result;
-	}
-	vitex::core::string get_combination_all(const vitex::core::vector<vitex::core::string>& names, const vitex::core::string& by, const vitex::core::string& end_by)
-	{
-		vitex::core::string result;
-		for (size_t i = 0; i < names.size(); i++)
+		static void dispatch(asSVMRegisters* registers, asPWORD argument)
 		{
-			result.append(names[i]);
-			if (i + 1 < names.size())
-				result.append(by);
-			else
-				result.append(end_by);
-		}
+			jit_point* point = (jit_point*)argument;
+			jit_function* function = point->base;
+			jit_compiler* base = function->base;
+			if (base->active.load(std::memory_order_relaxed))
+			{
+				uint8_t* target = point->target.load(std::memory_order_acquire);
+				if (!target && !function->failed.load(std::memory_order_relaxed) && function->calls.fetch_add(1, std::memory_order_relaxed) + 1 >= base->threshold.load(std::memory_order_relaxed))
+				{
+					base->compile(function);
+					target = point->target.load(std::memory_order_acquire);
+				}
 
-		return result;
-	}
-	vitex::core::string get_type_naming(asITypeInfo* type)
-	{
-		const char* name_space = type->GetNamespace();
-		return (name_space ? name_space + vitex::core::string("::") : vitex::core::string("")) + type->GetName();
-	}
-	asITypeInfo* get_type_namespacing(asIScriptEngine* engine, const vitex::core::string& name)
-	{
-		asITypeInfo* result = engine->GetTypeInfoByName(name.c_str());
-		if (result != nullptr)
-			return result;
+				if (target != nullptr)
+				{
+					base->entries.fetch_add(1, std::memory_order_relaxed);
+					((code_ptr)function->code)(registers, target);
+					return;
+				}
+			}
 
-		return engine->GetTypeInfoByName((name + "@").c_str());
-	}
+			registers->programPointer += asBCTypeSize[asBCInfo[asBC_JitEntry].type];
+		}
+	};
+#endif
 	void dump_namespace(vitex::core::string& source, const vitex::core::string& naming, dnamespace& name_space, vitex::core::string& offset)
 	{
 		if (!naming.empty())
@@ -2532,6 +5122,64 @@ namespace vitex
 			return function_factory::to_return(r);
 #else
 			return virtual_exception(virtual_error::not_supported);
+#endif
+		}
+		expects_vm<core::string> library::generate_native_source(const std::string_view& registrar) const
+		{
+			VI_ASSERT(is_valid(), "module should be valid");
+#ifdef VI_ANGELSCRIPT
+			if (registrar.empty() || core::stringify::is_numeric(registrar.front()))
+				return virtual_exception(virtual_error::invalid_name, "registrar should be a valid identifier");
+
+			for (char v : registrar)
+			{
+				if (!core::stringify::is_alphanum(v) && v != '_')
+					return virtual_exception(virtual_error::invalid_name, "registrar should be a valid identifier");
+			}
+
+			core::vector<asIScriptFunction*> functions;
+			core::unordered_set<core::string> decls;
+			auto append = [&functions, &decls](asIScriptFunction* function)
+			{
+				if (function != nullptr && function->GetFuncType() == asFUNC_SCRIPT && decls.insert(function->GetDeclaration(true, true, false)).second)
+					functions.push_back(function);
+			};
+			for (asUINT i = 0; i < mod->GetFunctionCount(); i++)
+				append(mod->GetFunctionByIndex(i));
+			for (asUINT i = 0; i < mod->GetObjectTypeCount(); i++)
+			{
+				asITypeInfo* type = mod->GetObjectTypeByIndex(i);
+				for (asUINT j = 0; j < type->GetMethodCount(); j++)
+					append(type->GetMethodByIndex(j, false));
+			}
+
+			core::string name = core::string(registrar), functions_source, registrar_source;
+			core::vector<std::pair<asIScriptFunction*, core::string>> translated;
+			for (auto* function : functions)
+			{
+				core::string symbol = name + "_" + core::to_string(translated.size());
+				if (translate_native_function(function, symbol, functions_source))
+					translated.push_back(std::make_pair(function, std::move(symbol)));
+			}
+
+			if (translated.empty())
+				return virtual_exception(virtual_error::no_function, "module has no translatable functions: enable jit instructions before building");
+
+			for (auto& next : translated)
+				registrar_source += core::stringify::text("\tif (!vm->set_native_function(%s, 0x%" PRIx64 "ull, &%s))\n\t\treturn false;\n", get_native_literal(next.first->GetDeclaration(true, true, false)).c_str(), virtual_machine::get_byte_code_hash(next.first), next.second.c_str());
+
+			core::string source = "#include <vitex/scripting.h>\n#include <cstring>\n#include <cmath>\n\nnamespace\n{\n";
+			source += core::stringify::text("\tstatic_assert(sizeof(void*) == %i, \"native source was generated for a different pointer size\");\n\n", (int)sizeof(void*));
+			source += "\ttemplate <typename t>\n\tinline t aot_load(const void* address)\n\t{\n\t\tt value;\n\t\tmemcpy(&value, address, sizeof(t));\n\t\treturn value;\n\t}\n";
+			source += "\ttemplate <typename t>\n\tinline void aot_store(void* address, t value)\n\t{\n\t\tmemcpy(address, &value, sizeof(t));\n\t}\n";
+			source += functions_source;
+			source += core::stringify::text("}\n\nbool %s(vitex::scripting::virtual_machine* vm)\n{\n", name.c_str());
+			source += registrar_source;
+			source += "\treturn true;\n}\n";
+			VI_DEBUG("asc module %s translated: %i of %i functions into native source", get_name().data(), (int)translated.size(), (int)functions.size());
+			return source;
+#else
+			return virtual_exception(virtual_error::not_supported);
 #endif
 		}
 		expects_vm<size_t> library::get_property_index_by_name(const std::string_view& name) const
@@ -2898,7 +5546,14 @@ namespace vitex
 					return compute::include_type::error;
 
 				if (!file.is_file && file.is_abstract)
-					return vm->import_system_addon(file.library) ? compute::include_type::computed : compute::include_type::error;
+				{
+					if (!vm->import_system_addon(file.library))
+						return compute::include_type::error;
+
+					if (std::find(vcache.addons.begin(), vcache.addons.end(), file.library) == vcache.addons.end())
+						vcache.addons.push_back(file.library);
+					return compute::include_type::computed;
+				}
 
 				if (!vm->import_file(file.library, file.is_remote, output))
 					return compute::include_type::error;
@@ -2915,7 +5570,7 @@ namespace vitex
 				else if (vm->prefer_code_concatenation())
 					return compute::include_type::unchanged;
 
-				return vm->add_script_section(scope, file.library, output) ? compute::include_type::computed : compute::include_type::error;
+				return add_section(file.library, output) ? compute::include_type::computed : compute::include_type::error;
 			});
 			processor->set_pragma_callback([this](compute::preprocessor* processor, const std::string_view& name, const core::vector<core::string>& args) -> compute::expects_preprocessor<void>
 			{
@@ -3196,6 +5851,8 @@ namespace vitex
 			built = true;
 			vcache.valid = false;
 			vcache.name.clear();
+			vcache.addons.clear();
+			fingerprint.clear();
 			if (scope != nullptr)
 				scope->Discard();
 
@@ -3215,6 +5872,8 @@ namespace vitex
 			built = false;
 			vcache.valid = false;
 			vcache.name.clear();
+			vcache.addons.clear();
+			fingerprint.clear();
 			if (scope != nullptr)
 				scope->Discard();
 
@@ -3239,6 +5898,7 @@ namespace vitex
 			vcache.name = name;
 			if (!vm->get_byte_code_cache(&vcache))
 			{
+				vcache.addons.clear();
 				vcache.data.clear();
 				vcache.debug = debug;
 				vcache.valid = false;
@@ -3259,6 +5919,8 @@ namespace vitex
 			byte_code_stream* stream = core::memory::init<byte_code_stream>();
 			int r = scope->SaveByteCode(stream, !info->debug);
 			info->data = stream->GetCode();
+			if (info != &vcache)
+				info->addons = vcache.addons;
 			core::memory::deinit(stream);
 			if (r >= 0)
 				VI_DEBUG("asc OK save bytecode on 0x%" PRIXPTR, (uintptr_t)this);
@@ -3293,7 +5955,7 @@ namespace vitex
 			else if (code.empty())
 				return core::expectation::met;
 
-			auto result = vm->add_script_section(scope, *source, code);
+			auto result = add_section(*source, code);
 			if (result)
 				VI_DEBUG("asc OK load program on 0x%" PRIXPTR " (file)", (uintptr_t)this);
 			return result;
@@ -3317,7 +5979,7 @@ namespace vitex
 			else if (buffer.empty())
 				return core::expectation::met;
 
-			auto result = vm->add_script_section(scope, name, buffer);
+			auto result = add_section(name, buffer);
 			if (result)
 				VI_DEBUG("asc OK load program on 0x%" PRIXPTR, (uintptr_t)this);
 			return result;
@@ -3331,6 +5993,13 @@ namespace vitex
 			VI_ASSERT(scope != nullptr, "module should not be empty");
 			VI_ASSERT(info != nullptr, "bytecode should be set");
 #ifdef VI_ANGELSCRIPT
+			for (auto& name : info->addons)
+			{
+				auto status = vm->import_system_addon(name);
+				if (!status)
+					return status;
+			}
+
 			int r = 0;
 			byte_code_stream* stream = core::memory::init<byte_code_stream>(info->data);
 			while ((r = scope->LoadByteCode(stream, &info->debug)) == asBUILD_IN_PROGRESS)
@@ -3351,6 +6020,10 @@ namespace vitex
 			if (vcache.valid)
 				return load_byte_code_sync(&vcache);
 
+			core::string path = get_byte_code_path();
+			if (!path.empty() && load_byte_code_file(path))
+				return core::expectation::met;
+
 			int r = 0;
 			while ((r = scope->Build()) == asBUILD_IN_PROGRESS)
 				std::this_thread::sleep_for(std::chrono::microseconds(COMPILER_BLOCKED_WAIT_US));
@@ -3361,6 +6034,9 @@ namespace vitex
 				return function_factory::to_return(r);
 
 			VI_DEBUG("asc OK compile on 0x%" PRIXPTR, (uintptr_t)this);
+			if (!path.empty())
+				save_byte_code_file(path);
+
 			if (vcache.name.empty())
 				return function_factory::to_return(r);
 
@@ -3517,6 +6193,145 @@ namespace vitex
 		{
 			return vm;
 		}
+		expects_vm<void> compiler::add_section(const std::string_view& name, const std::string_view& code)
+		{
+			VI_ASSERT(vm != nullptr, "engine should be set");
+			VI_ASSERT(scope != nullptr, "module should not be empty");
+			auto result = vm->add_script_section(scope, name, code);
+			if (result)
+				fingerprint.append(name).append(1, ':').append(core::to_string(compute::crypto::crc64(code))).append(1, '\n');
+			return result;
+		}
+		expects_vm<void> compiler::load_byte_code_file(const std::string_view& path)
+		{
+			VI_ASSERT(vm != nullptr, "engine should be set");
+			VI_ASSERT(scope != nullptr, "module should not be empty");
+#ifdef VI_ANGELSCRIPT
+			core::string target = core::string(path);
+			byte_code_mapping mapping;
+			if (!mapping.map(target))
+				return virtual_exception("bytecode cache miss: " + target);
+
+			uint64_t size = 0;
+			if (mapping.size > BYTE_CODE_FILE_HEADER)
+				memcpy(&size, mapping.data + 8, sizeof(size));
+
+			if (mapping.size <= BYTE_CODE_FILE_HEADER || memcmp(mapping.data, BYTE_CODE_FILE_MAGIC, 8) != 0 || size != (uint64_t)(mapping.size - BYTE_CODE_FILE_HEADER))
+			{
+				mapping.unmap();
+				core::os::file::remove(target);
+				return virtual_exception("bytecode cache corrupted: " + target);
+			}
+
+			int r = 0;
+			bool debug = mapping.data[16] != 0;
+			byte_code_view stream(mapping.data + BYTE_CODE_FILE_HEADER, mapping.size - BYTE_CODE_FILE_HEADER);
+			while ((r = scope->LoadByteCode(&stream, &debug)) == asBUILD_IN_PROGRESS)
+				std::this_thread::sleep_for(std::chrono::microseconds(COMPILER_BLOCKED_WAIT_US));
+
+			mapping.unmap();
+			if (r < 0)
+			{
+				core::os::file::remove(target);
+				return function_factory::to_return(r);
+			}
+
+			vm->clear_sections();
+			built = true;
+			VI_DEBUG("asc OK load cached bytecode on 0x%" PRIXPTR ": %s", (uintptr_t)this, target.c_str());
+			return core::expectation::met;
+#else
+			return virtual_exception(virtual_error::not_supported);
+#endif
+		}
+		expects_vm<void> compiler::save_byte_code_file(const std::string_view& path)
+		{
+			VI_ASSERT(vm != nullptr, "engine should be set");
+			VI_ASSERT(scope != nullptr, "module should not be empty");
+#ifdef VI_ANGELSCRIPT
+			byte_code_info info;
+			info.debug = vcache.debug;
+			auto status = save_byte_code(&info);
+			if (!status)
+				return status;
+
+			uint64_t size = (uint64_t)info.data.size();
+			core::vector<uint8_t> data;
+			data.resize(BYTE_CODE_FILE_HEADER + info.data.size());
+			memset(data.data(), 0, BYTE_CODE_FILE_HEADER);
+			memcpy(data.data(), BYTE_CODE_FILE_MAGIC, 8);
+			memcpy(data.data() + 8, &size, sizeof(size));
+			data[16] = info.debug ? 1 : 0;
+			memcpy(data.data() + BYTE_CODE_FILE_HEADER, info.data.data(), info.data.size());
+
+			const core::string& directory = vm->get_cache_directory();
+			core::os::directory::patch(directory);
+
+			core::string target = core::string(path);
+			core::string temporary = target + "." + core::to_string((uint64_t)core::schedule::get_clock().count()) + ".tmp";
+			if (!core::os::file::write(temporary, data.data(), data.size()))
+			{
+				core::os::file::remove(temporary);
+				return virtual_exception("bytecode cache write error: " + target);
+			}
+
+			if (!core::os::file::move(temporary, target))
+			{
+				core::os::file::remove(temporary);
+				return virtual_exception("bytecode cache write error: " + target);
+			}
+
+			size_t offset = target.rfind('-');
+			size_t prefix = target.find_last_of("/\\");
+			core::vector<std::pair<core::string, core::file_entry>> entries;
+			if (offset != std::string::npos && core::os::directory::scan(directory, entries))
+			{
+				std::string_view module = std::string_view(target).substr(prefix + 1, offset - prefix);
+				std::string_view name = std::string_view(target).substr(prefix + 1);
+				core::vector<std::pair<core::string, core::file_entry>> versions;
+				for (auto& entry : entries)
+				{
+					if (!entry.second.is_directory && entry.first != name && core::stringify::starts_with(entry.first, module) && core::stringify::ends_with(entry.first, ".vbc"))
+						versions.push_back(std::move(entry));
+				}
+
+				if (versions.size() >= BYTE_CODE_FILE_VERSIONS)
+				{
+					std::sort(versions.begin(), versions.end(), [](const std::pair<core::string, core::file_entry>& a, const std::pair<core::string, core::file_entry>& b) { return a.second.last_modified > b.second.last_modified; });
+					for (size_t i = BYTE_CODE_FILE_VERSIONS - 1; i < versions.size(); i++)
+						core::os::file::remove(directory + "/" + versions[i].first);
+				}
+			}
+
+			VI_DEBUG("asc OK save cached bytecode on 0x%" PRIXPTR ": %s", (uintptr_t)this, target.c_str());
+			return core::expectation::met;
+#else
+			return virtual_exception(virtual_error::not_supported);
+#endif
+		}
+		core::string compiler::get_byte_code_path()
+		{
+			VI_ASSERT(vm != nullptr, "engine should be set");
+			const core::string& directory = vm->get_cache_directory();
+			if (directory.empty() || fingerprint.empty() || !scope)
+				return core::string();
+#ifdef VI_ANGELSCRIPT
+			core::string material = fingerprint;
+			material.append(core::to_string(processor->get_definitions_hash())).append(1, '\n');
+			material.append(core::to_string(vm->get_interface_hash())).append(1, '\n');
+			material.append(core::to_string((int)vitex::version)).append(1, '\n');
+			material.append(ANGELSCRIPT_VERSION_STRING).append(1, '\n');
+			material.append(asGetLibraryOptions()).append(1, '\n');
+			material.append(vcache.debug ? "debug" : "release");
+
+			const char* name = scope->GetName();
+			uint64_t module = compute::crypto::crc64(name ? name : "");
+			uint64_t key = compute::crypto::crc64(material) ^ core::os::file::get_index(material);
+			return core::stringify::text("%s/%016" PRIx64 "-%016" PRIx64 ".vbc", directory.c_str(), module, key);
+#else
+			return core::string();
+#endif
+		}
 		library compiler::get_module() const
 		{
 			return scope;
@@ -5500,6 +8315,11 @@ namespace vitex
 #ifdef VI_ANGELSCRIPT
 			context->SetUserData(this, context_ud);
 			vm = virtual_machine::get(base->GetEngine());
+			if (vm != nullptr)
+			{
+				core::umutex<std::mutex> unique(vm->profiler.exchange);
+				vm->profiler.contexts.insert(this);
+			}
 #endif
 		}
 		immediate_context::~immediate_context() noexcept
@@ -5507,6 +8327,9 @@ namespace vitex
 			if (executor.future.is_pending())
 				executor.future.set(virtual_exception(virtual_error::context_not_prepared));
 #ifdef VI_ANGELSCRIPT
+			core::umutex<std::mutex> unique(vm->profiler.exchange);
+			vm->profiler.contexts.erase(this);
+			unique.negate();
 			vm->get_engine()->ReturnContext(context);
 #endif
 		}
@@ -5600,7 +8423,11 @@ namespace vitex
 		{
 			VI_ASSERT(context != nullptr, "context should be set");
 #ifdef VI_ANGELSCRIPT
+			++profiling.running;
 			int r = callbacks.execute ? callbacks.execute(this) : context->Execute();
+			if (!--profiling.running && profiling.sample.load(std::memory_order_relaxed))
+				vm->cancel_profiler_sample(this);
+
 			if (callbacks.stop_executions.empty())
 				return function_factory::to_return<execution>(r, (execution)r);
 
@@ -5924,6 +8751,7 @@ namespace vitex
 			VI_ASSERT(context != nullptr, "context should be set");
 			VI_ASSERT(callback != nullptr, "callback should be set");
 #ifdef VI_ANGELSCRIPT
+			profiling.tracing = true;
 			return function_factory::to_return(context->SetLineCallback(asFUNCTION(callback), object, asCALL_CDECL));
 #else
 			return virtual_exception(virtual_error::not_supported);
@@ -6102,6 +8930,8 @@ namespace vitex
 			context->Unprepare();
 			callbacks = events();
 			executor = frame();
+			profiling.epoch = 0;
+			profiling.depth = 0;
 			invalidate_strings();
 #endif
 		}
@@ -6526,7 +9356,7 @@ namespace vitex
 		}
 		int immediate_context::context_ud = 151;
 
-		virtual_machine::virtual_machine() noexcept : last_major_gc(0), scope(0), debugger(nullptr), engine(nullptr), save_stacktrace(false), save_sources(false), save_cache(true), concat_code(false)
+		virtual_machine::virtual_machine() noexcept : last_major_gc(0), interface_hash(0), interface_size(0), scope(0), debugger(nullptr), natives(nullptr), jit(nullptr), engine(nullptr), save_stacktrace(false), save_sources(false), save_cache(true), concat_code(false)
 		{
 			auto directory = core::os::directory::get_working();
 			if (directory)
@@ -6563,6 +9393,11 @@ namespace vitex
 				core::os::symbol::unload(next.second.handle);
 			}
 
+			stop_incremental_garbage_collection();
+			stop_profiler();
+			pooling.local_limit = 0;
+			pooling.shared_limit = std::numeric_limits<size_t>::max();
+			trim_context_pools(false);
 			for (auto& context : threads)
 				core::memory::release(context);
 #ifdef VI_ANGELSCRIPT
@@ -6580,6 +9415,10 @@ namespace vitex
 				engine->ShutDownAndRelease();
 				engine = nullptr;
 			}
+			core::memory::deinit((native_compiler*)natives);
+#if defined(JIT_TARGET_X64) || defined(JIT_TARGET_ARM64)
+			core::memory::deinit((jit_compiler*)jit);
+#endif
 			core::memory::deinit(factory);
 #endif
 			clear_cache();
@@ -6817,15 +9656,37 @@ namespace vitex
 				return core::expectation::met;
 
 			last_major_gc = time;
+			trim_context_pools(true);
 			return perform_full_garbage_collection();
 		}
 		expects_vm<void> virtual_machine::perform_full_garbage_collection()
 		{
 #ifdef VI_ANGELSCRIPT
+			auto time = std::chrono::steady_clock::now();
 			int r = engine->GarbageCollect(asGC_FULL_CYCLE | asGC_DESTROY_GARBAGE | asGC_DETECT_GARBAGE, 1);
+			record_garbage_collection_pause((uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - time).count(), true);
 			return function_factory::to_return(r);
 #else
 			return virtual_exception(virtual_error::not_supported);
+#endif
+		}
+		expects_vm<bool> virtual_machine::perform_incremental_garbage_collection(uint64_t budget_us)
+		{
+#ifdef VI_ANGELSCRIPT
+			auto time = std::chrono::steady_clock::now();
+			auto deadline = time + std::chrono::microseconds(budget_us);
+			int r = 0;
+			do
+			{
+				r = engine->GarbageCollect(asGC_ONE_STEP | asGC_DESTROY_GARBAGE | asGC_DETECT_GARBAGE, 1);
+			} while (r == 1 && std::chrono::steady_clock::now() < deadline);
+			record_garbage_collection_pause((uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - time).count(), false);
+			if (r < 0)
+				return virtual_exception((virtual_error)r);
+
+			return r == 0;
+#else
+			return virtual_exception(virtual_error::not_supported);
 #endif
 		}
 		expects_vm<void> virtual_machine::notify_of_new_object(void* object, const type_info& type)
@@ -6955,14 +9816,148 @@ namespace vitex
 			return virtual_exception(virtual_error::not_supported);
 #endif
 		}
-		expects_vm<void> virtual_machine::set_property(features property, size_t value)
+		expects_vm<void> virtual_machine::set_property(features property, size_t value)
+		{
+			VI_ASSERT(engine != nullptr, "engine should be set");
+#ifdef VI_ANGELSCRIPT
+			return function_factory::to_return(engine->SetEngineProperty((asEEngineProp)property, (asPWORD)value));
+#else
+			return virtual_exception(virtual_error::not_supported);
+#endif
+		}
+		expects_vm<void> virtual_machine::set_jit_compiler(asIJITCompiler* compiler)
+		{
+			VI_ASSERT(engine != nullptr, "engine should be set");
+#ifdef VI_ANGELSCRIPT
+			core::umutex<std::recursive_mutex> unique(sync.general);
+			if (natives != nullptr)
+			{
+				((native_compiler*)natives)->chain(compiler);
+				return core::expectation::met;
+			}
+
+			auto status = set_property(features::include_jit_instructions, compiler != nullptr ? 1 : 0);
+			if (!status)
+				return status;
+
+			return function_factory::to_return(engine->SetJITCompiler(compiler));
+#else
+			return virtual_exception(virtual_error::not_supported);
+#endif
+		}
+		expects_vm<void> virtual_machine::set_native_function(const std::string_view& decl, uint64_t byte_code_hash, native_entry_ptr entry)
+		{
+			VI_ASSERT(engine != nullptr, "engine should be set");
+			VI_ASSERT(!decl.empty(), "decl should be set");
+			VI_ASSERT(entry != nullptr, "entry should be set");
+#ifdef VI_ANGELSCRIPT
+			core::umutex<std::recursive_mutex> unique(sync.general);
+			if (!natives)
+			{
+				auto* current = engine->GetJITCompiler();
+				auto* base = dynamic_cast<asIJITCompiler*>(current);
+				if (current != nullptr && !base)
+					return virtual_exception(virtual_error::not_supported, "attached jit compiler cannot be chained");
+
+				native_compiler* compiler = core::memory::init<native_compiler>(base);
+				auto status = set_property(features::include_jit_instructions, 1);
+				if (status)
+					status = function_factory::to_return(engine->SetJITCompiler(compiler));
+				if (!status)
+				{
+					core::memory::deinit(compiler);
+					return status;
+				}
+				natives = compiler;
+			}
+
+			((native_compiler*)natives)->insert(decl, byte_code_hash, entry);
+			return core::expectation::met;
+#else
+			return virtual_exception(virtual_error::not_supported);
+#endif
+		}
+		expects_vm<void> virtual_machine::set_native_validation(bool enabled)
+		{
+#ifdef VI_ANGELSCRIPT
+			core::umutex<std::recursive_mutex> unique(sync.general);
+			if (!natives)
+				return virtual_exception(virtual_error::invalid_configuration, "no native functions are registered");
+
+			((native_compiler*)natives)->set_validation(enabled);
+			return core::expectation::met;
+#else
+			return virtual_exception(virtual_error::not_supported);
+#endif
+		}
+		size_t virtual_machine::get_native_function_calls(const std::string_view& decl)
+		{
+#ifdef VI_ANGELSCRIPT
+			core::umutex<std::recursive_mutex> unique(sync.general);
+			return natives != nullptr ? ((native_compiler*)natives)->get_calls(decl) : 0;
+#else
+			return 0;
+#endif
+		}
+		size_t virtual_machine::get_native_function_mismatches(const std::string_view& decl)
+		{
+#ifdef VI_ANGELSCRIPT
+			core::umutex<std::recursive_mutex> unique(sync.general);
+			return natives != nullptr ? ((native_compiler*)natives)->get_mismatches(decl) : 0;
+#else
+			return 0;
+#endif
+		}
+		expects_vm<void> virtual_machine::set_jit(bool enabled, size_t call_threshold)
 		{
 			VI_ASSERT(engine != nullptr, "engine should be set");
-#ifdef VI_ANGELSCRIPT
-			return function_factory::to_return(engine->SetEngineProperty((asEEngineProp)property, (asPWORD)value));
+#if defined(VI_ANGELSCRIPT) && (defined(JIT_TARGET_X64) || defined(JIT_TARGET_ARM64))
+			core::umutex<std::recursive_mutex> unique(sync.general);
+			if (!enabled)
+			{
+				if (jit != nullptr)
+					((jit_compiler*)jit)->activate(false, call_threshold);
+				return core::expectation::met;
+			}
+
+			if (!jit)
+			{
+				auto* current = engine->GetJITCompiler();
+				if (current != nullptr && current != natives)
+					return virtual_exception(virtual_error::not_supported, "another jit compiler is already attached");
+
+				jit_compiler* compiler = core::memory::init<jit_compiler>();
+				auto status = set_jit_compiler(compiler);
+				if (!status)
+				{
+					core::memory::deinit(compiler);
+					return status;
+				}
+				jit = compiler;
+			}
+
+			((jit_compiler*)jit)->activate(true, call_threshold);
+			return core::expectation::met;
 #else
-			return virtual_exception(virtual_error::not_supported);
+			return virtual_exception(virtual_error::not_supported, "jit compiler is not available for this architecture");
+#endif
+		}
+		virtual_machine::jit_stats virtual_machine::get_jit_stats()
+		{
+			jit_stats result;
+#if defined(VI_ANGELSCRIPT) && (defined(JIT_TARGET_X64) || defined(JIT_TARGET_ARM64))
+			core::umutex<std::recursive_mutex> unique(sync.general);
+			if (!jit)
+				return result;
+
+			auto stats = ((jit_compiler*)jit)->get_stats();
+			result.functions = stats.functions;
+			result.compiled = stats.compiled;
+			result.failed = stats.failed;
+			result.entries = stats.entries;
+			result.code_size = stats.code_size;
 #endif
+			return result;
 		}
 		expects_vm<size_t> virtual_machine::get_size_of_primitive_type(int type_id) const
 		{
@@ -7200,6 +10195,13 @@ namespace vitex
 		{
 			save_cache = enabled;
 		}
+		void virtual_machine::set_cache_directory(const std::string_view& path)
+		{
+			core::umutex<std::recursive_mutex> unique(sync.general);
+			cache_directory = path;
+			while (!cache_directory.empty() && (cache_directory.back() == '/' || cache_directory.back() == '\\'))
+				cache_directory.pop_back();
+		}
 		void virtual_machine::set_exception_callback(std::function<void(immediate_context*)>&& callback)
 		{
 			global_exception = std::move(callback);
@@ -7212,6 +10214,7 @@ namespace vitex
 			if (debugger != nullptr)
 				debugger->set_engine(this);
 
+			trim_context_pools(false);
 			core::umutex<std::recursive_mutex> unique2(sync.pool);
 			for (auto* next : stacks)
 			{
@@ -7338,6 +10341,10 @@ namespace vitex
 			if (!debugger || !debugger->is_attached())
 				return detach_debugger_from_context(context);
 #ifdef VI_ANGELSCRIPT
+			immediate_context* base = immediate_context::get(context);
+			if (base != nullptr)
+				base->profiling.tracing = true;
+
 			context->SetLineCallback(asMETHOD(debugger_context, line_callback), debugger, asCALL_THISCALL);
 			context->SetExceptionCallback(asMETHOD(debugger_context, exception_callback), debugger, asCALL_THISCALL);
 #endif
@@ -7346,7 +10353,15 @@ namespace vitex
 		{
 			VI_ASSERT(context != nullptr, "context should be set");
 #ifdef VI_ANGELSCRIPT
-			context->ClearLineCallback();
+			immediate_context* base = immediate_context::get(context);
+			bool tracing = base != nullptr && profiler.active && profiler.count_calls;
+			if (base != nullptr)
+				base->profiling.tracing = tracing;
+
+			if (tracing)
+				context->SetLineCallback(asFUNCTION(virtual_machine::line_handler), nullptr, asCALL_CDECL);
+			else
+				context->ClearLineCallback();
 			context->SetExceptionCallback(asFUNCTION(virtual_machine::exception_handler), context, asCALL_CDECL);
 #endif
 		}
@@ -7369,6 +10384,7 @@ namespace vitex
 			if (it == opcodes.end())
 				return false;
 
+			info->addons = it->second.addons;
 			info->data = it->second.data;
 			info->debug = it->second.debug;
 			info->valid = true;
@@ -7392,13 +10408,83 @@ namespace vitex
 				opcodes[info->name] = *info;
 			}
 		}
+		uint64_t virtual_machine::get_interface_hash()
+		{
+			VI_ASSERT(engine != nullptr, "engine should be set");
+			size_t functions = get_functions_count(), properties = get_properties_count();
+			size_t objects = get_objects_count(), enums = get_enum_count(), funcdefs = get_function_defs_count();
+			size_t size = functions + properties + objects + enums + funcdefs;
+			for (size_t i = 0; i < objects; i++)
+			{
+				auto type = get_object_by_index(i);
+				size += type.get_methods_count() + type.get_properties_count() + type.get_behaviour_count() + type.get_factories_count();
+			}
+
+			core::umutex<std::recursive_mutex> unique(sync.general);
+			if (interface_size == size && interface_hash != 0)
+				return interface_hash;
+
+			core::string material;
+			for (size_t i = 0; i < functions; i++)
+				material.append(get_function_by_index(i).get_decl(true, true)).append(1, '\n');
+
+			for (size_t i = 0; i < properties; i++)
+			{
+				property_info info;
+				if (get_property_by_index(i, &info))
+					material.append(info.name_space).append(1, ':').append(info.name).append(1, ':').append(get_type_id_decl(info.type_id, true)).append(1, '\n');
+			}
+
+			for (size_t i = 0; i < objects; i++)
+			{
+				auto type = get_object_by_index(i);
+				material.append(type.get_namespace()).append(1, ':').append(type.get_name()).append(1, '\n');
+				for (size_t j = 0; j < type.get_methods_count(); j++)
+					material.append(type.get_method_by_index(j).get_decl(true, true)).append(1, '\n');
+
+				for (size_t j = 0; j < type.get_behaviour_count(); j++)
+					material.append(type.get_behaviour_by_index(j, nullptr).get_decl(true, true)).append(1, '\n');
+
+				for (size_t j = 0; j < type.get_factories_count(); j++)
+					material.append(type.get_factory_by_index(j).get_decl(true, true)).append(1, '\n');
+
+				for (size_t j = 0; j < type.get_properties_count(); j++)
+				{
+					function_info info;
+					if (type.get_property(j, &info))
+						material.append(info.name).append(1, ':').append(get_type_id_decl(info.type_id, true)).append(1, '\n');
+				}
+			}
+
+			for (size_t i = 0; i < enums; i++)
+			{
+				auto type = get_enum_by_index(i);
+				material.append(type.get_namespace()).append(1, ':').append(type.get_name()).append(1, '\n');
+				for (size_t j = 0; j < type.get_enum_value_count(); j++)
+				{
+					int64_t value = 0;
+					material.append(type.get_enum_value_by_index(j, &value)).append(1, '=').append(core::to_string(value)).append(1, '\n');
+				}
+			}
+
+			for (size_t i = 0; i < funcdefs; i++)
+			{
+				auto type = get_function_def_by_index(i);
+				material.append(type.get_namespace()).append(1, ':').append(type.get_name()).append(1, '\n');
+			}
+
+			interface_hash = compute::crypto::crc64(material);
+			interface_size = size;
+			return interface_hash;
+		}
 		immediate_context* virtual_machine::create_context()
 		{
 #ifdef VI_ANGELSCRIPT
 			asIScriptContext* context = engine->RequestContext();
 			VI_ASSERT(context != nullptr, "cannot create script context");
+			immediate_context* result = new immediate_context(context);
 			attach_debugger_to_context(context);
-			return new immediate_context(context);
+			return result;
 #else
 			return nullptr;
 #endif
@@ -7845,6 +10931,10 @@ namespace vitex
 		{
 			return include.root;
 		}
+		const core::string& virtual_machine::get_cache_directory() const
+		{
+			return cache_directory;
+		}
 		core::vector<core::string> virtual_machine::get_exposed_addons()
 		{
 			core::umutex<std::recursive_mutex> unique(sync.general);
@@ -8100,13 +11190,16 @@ namespace vitex
 
 			addon base = it->second;
 			it->second.exposed = true;
-			unique.negate();
-
 			for (auto& item : base.dependencies)
 			{
 				auto status = import_system_addon(item);
 				if (!status)
+				{
+					it = addons.find(target);
+					if (it != addons.end())
+						it->second.exposed = false;
 					return status;
+				}
 			}
 
 			if (base.callback)
@@ -8178,111 +11271,592 @@ namespace vitex
 				stream << " ";
 			stream << "^";
 
-			for (size_t i = top_lines; i < lines.size(); i++)
-				stream << "\n  " << ++top_line << "  " << core::stringify::trim_end(lines[i]);
+			for (size_t i = top_lines; i < lines.size(); i++)
+				stream << "\n  " << ++top_line << "  " << core::stringify::trim_end(lines[i]);
+
+			return stream.str();
+		}
+		core::option<core::string> virtual_machine::get_source_code_appendix_by_path(const std::string_view& label, const std::string_view& path, uint32_t line_number, uint32_t column_number, size_t max_lines)
+		{
+			auto code = get_script_section(path);
+			if (!code)
+				return code;
+
+			return get_source_code_appendix(label, *code, line_number, column_number, max_lines);
+		}
+		size_t virtual_machine::get_property(features property) const
+		{
+			VI_ASSERT(engine != nullptr, "engine should be set");
+#ifdef VI_ANGELSCRIPT
+			return (size_t)engine->GetEngineProperty((asEEngineProp)property);
+#else
+			return 0;
+#endif
+		}
+		asIScriptEngine* virtual_machine::get_engine() const
+		{
+			return engine;
+		}
+		debugger_context* virtual_machine::get_debugger() const
+		{
+			return debugger;
+		}
+		void virtual_machine::cleanup()
+		{
+			type_cache::cleanup();
+			cleanup_this_thread();
+		}
+		virtual_machine* virtual_machine::get(asIScriptEngine* engine)
+		{
+			VI_ASSERT(engine != nullptr, "engine should be set");
+#ifdef VI_ANGELSCRIPT
+			void* vm = engine->GetUserData(manager_ud);
+			VI_ASSERT(vm != nullptr, "engine should be created by virtual machine");
+			return (virtual_machine*)vm;
+#else
+			return nullptr;
+#endif
+		}
+		virtual_machine* virtual_machine::get()
+		{
+#ifdef VI_ANGELSCRIPT
+			asIScriptContext* context = asGetActiveContext();
+			if (!context)
+				return nullptr;
+
+			return get(context->GetEngine());
+#else
+			return nullptr;
+#endif
+		}
+		std::string_view virtual_machine::get_library_name(const std::string_view& path)
+		{
+			if (path.empty())
+				return path;
+
+			core::text_settle start = core::stringify::reverse_find_of(path, "\\/");
+			if (!start.found)
+				return path;
+
+			return path.substr(start.end);
+		}
+		struct virtual_machine::context_cache
+		{
+			struct entry
+			{
+				virtual_machine* vm = nullptr;
+				core::vector<immediate_context*> threads;
+				core::vector<asIScriptContext*> stacks;
+				size_t hits = 0;
+				size_t uses = 0;
+				size_t trim_mark = 0;
+			};
+
+			core::vector<entry> entries;
+			std::mutex exchange;
+			bool closed = false;
+
+			context_cache()
+			{
+				core::umutex<std::recursive_mutex> unique(get_registry_mutex());
+				get_registry().push_back(this);
+			}
+			~context_cache()
+			{
+				core::umutex<std::mutex> unique(exchange);
+				closed = true;
+				unique.negate();
+				drain(nullptr, false, this);
+
+				core::umutex<std::recursive_mutex> exclusive(get_registry_mutex());
+				auto& registry = get_registry();
+				registry.erase(std::remove(registry.begin(), registry.end(), this), registry.end());
+			}
+			template <typename t>
+			t* pop(virtual_machine* vm, core::vector<t*> entry::* list)
+			{
+				core::umutex<std::mutex> unique(exchange);
+				entry* target = find(vm);
+				if (!target || (target->*list).empty())
+					return nullptr;
+
+				t* context = (target->*list).back();
+				(target->*list).pop_back();
+				++target->hits;
+				++target->uses;
+				return context;
+			}
+			template <typename t>
+			bool push(virtual_machine* vm, core::vector<t*> entry::* list, t* context)
+			{
+				size_t limit = vm->pooling.local_limit.load(std::memory_order_relaxed);
+				if (!limit)
+					return false;
+
+				core::umutex<std::mutex> unique(exchange);
+				if (closed)
+					return false;
+
+				entry* target = find(vm);
+				if (!target)
+				{
+					entries.emplace_back();
+					target = &entries.back();
+					target->vm = vm;
+				}
+
+				++target->uses;
+				if ((target->*list).size() >= limit)
+					return false;
+
+				(target->*list).push_back(context);
+				return true;
+			}
+			entry* find(virtual_machine* vm)
+			{
+				for (auto& next : entries)
+				{
+					if (next.vm == vm)
+						return &next;
+				}
+				return nullptr;
+			}
+			static void release(entry& target)
+			{
+				virtual_machine* vm = target.vm;
+				vm->pooling.hits += target.hits;
+				vm->pooling.trims += target.threads.size() + target.stacks.size();
+				for (auto* context : target.threads)
+					vm->return_shared_context(context);
+				for (auto* context : target.stacks)
+					vm->return_shared_raw_context(context);
+			}
+			static void drain(virtual_machine* vm, bool idle_only, context_cache* only = nullptr)
+			{
+				core::vector<entry> queue;
+				core::umutex<std::recursive_mutex> unique(get_registry_mutex());
+				for (auto* cache : get_registry())
+				{
+					if (only != nullptr && cache != only)
+						continue;
+
+					core::umutex<std::mutex> local(cache->exchange);
+					for (auto it = cache->entries.begin(); it != cache->entries.end();)
+					{
+						if (vm != nullptr && it->vm != vm)
+							++it;
+						else if (idle_only && it->uses != it->trim_mark)
+						{
+							it->trim_mark = it->uses;
+							++it;
+						}
+						else
+						{
+							queue.emplace_back(std::move(*it));
+							it = cache->entries.erase(it);
+						}
+					}
+				}
+
+				unique.negate();
+				for (auto& next : queue)
+					release(next);
+			}
+			static void summarize(virtual_machine* vm, context_pool_stats& stats)
+			{
+				core::umutex<std::recursive_mutex> unique(get_registry_mutex());
+				for (auto* cache : get_registry())
+				{
+					core::umutex<std::mutex> local(cache->exchange);
+					entry* target = cache->find(vm);
+					if (target != nullptr)
+					{
+						stats.hits += target->hits;
+						stats.cached += target->threads.size() + target->stacks.size();
+					}
+				}
+			}
+			static core::vector<context_cache*>& get_registry()
+			{
+				static core::vector<context_cache*> registry;
+				return registry;
+			}
+			static std::recursive_mutex& get_registry_mutex()
+			{
+				static std::recursive_mutex mutex;
+				return mutex;
+			}
+			static context_cache& get()
+			{
+				static thread_local context_cache cache;
+				return cache;
+			}
+		};
+
+		immediate_context* virtual_machine::request_context()
+		{
+			immediate_context* context = context_cache::get().pop(this, &context_cache::entry::threads);
+			if (context != nullptr)
+				return context;
+
+			core::umutex<std::recursive_mutex> unique(sync.pool);
+			if (threads.empty())
+			{
+				unique.negate();
+				++pooling.misses;
+				return create_context();
+			}
+
+			context = threads.back();
+			threads.pop_back();
+			++pooling.shared_hits;
+			return context;
+		}
+		void virtual_machine::return_context(immediate_context* context)
+		{
+			VI_ASSERT(context != nullptr, "context should be set");
+			if (!context->profiling.calls.empty())
+				flush_profiler_calls(context);
+
+			context->reset();
+			if (!context_cache::get().push(this, &context_cache::entry::threads, context))
+				return_shared_context(context);
+		}
+		void virtual_machine::return_shared_context(immediate_context* context)
+		{
+			core::umutex<std::recursive_mutex> unique(sync.pool);
+			if (threads.size() < pooling.shared_limit.load(std::memory_order_relaxed))
+			{
+				threads.push_back(context);
+				return;
+			}
+
+			unique.negate();
+			++pooling.overflows;
+			core::memory::release(context);
+		}
+		void virtual_machine::return_shared_raw_context(asIScriptContext* context)
+		{
+#ifdef VI_ANGELSCRIPT
+			core::umutex<std::recursive_mutex> unique(sync.pool);
+			if (stacks.size() < pooling.shared_limit.load(std::memory_order_relaxed))
+			{
+				stacks.push_back(context);
+				return;
+			}
+
+			unique.negate();
+			++pooling.overflows;
+			context->Release();
+#endif
+		}
+		bool virtual_machine::start_incremental_garbage_collection(const gc_policy& policy)
+		{
+			if (!policy.interval_ms || !core::schedule::is_available())
+				return false;
+
+			stop_incremental_garbage_collection();
+			core::umutex<std::mutex> unique(collector.exchange);
+			collector.policy = policy;
+			collector.pending = false;
+			collector.timer = core::schedule::get()->set_interval(policy.interval_ms, [this]() { collect_garbage_on_idle(); });
+			return collector.timer != core::INVALID_TASK_ID;
+		}
+		void virtual_machine::stop_incremental_garbage_collection()
+		{
+			core::umutex<std::mutex> unique(collector.exchange);
+			core::task_id timer = collector.timer;
+			collector.timer = core::INVALID_TASK_ID;
+			unique.negate();
+
+			if (timer != core::INVALID_TASK_ID && core::schedule::is_available())
+				core::schedule::get()->clear_timeout(timer);
+
+			while (collector.active)
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		virtual_machine::gc_histogram virtual_machine::get_garbage_collection_histogram()
+		{
+			core::umutex<std::mutex> unique(collector.exchange);
+			return collector.histogram;
+		}
+		void virtual_machine::collect_garbage_on_idle()
+		{
+			if (collector.active.exchange(true))
+				return;
+
+			gc_policy policy;
+			bool pending;
+			{
+				core::umutex<std::mutex> unique(collector.exchange);
+				if (collector.timer == core::INVALID_TASK_ID)
+				{
+					collector.active = false;
+					return;
+				}
+
+				policy = collector.policy;
+				pending = collector.pending;
+			}
+
+			uint32_t current_size = 0, new_objects = 0;
+			get_statistics(&current_size, nullptr, nullptr, &new_objects, nullptr);
+			if (policy.pressure_objects > 0 && current_size >= policy.pressure_objects)
+			{
+				perform_full_garbage_collection();
+				pending = false;
+			}
+			else
+			{
+				auto* queue = core::schedule::get();
+				bool idle = !queue->has_tasks(core::difficulty::sync) && !queue->has_tasks(core::difficulty::async);
+				bool growth = new_objects >= policy.min_new_objects && (float)new_objects >= (float)current_size * policy.growth_ratio;
+				if (idle && (pending || growth))
+				{
+					auto status = perform_incremental_garbage_collection(policy.slice_budget_us);
+					pending = status && !*status;
+				}
+			}
 
-			return stream.str();
+			{
+				core::umutex<std::mutex> unique(collector.exchange);
+				collector.pending = pending;
+			}
+			collector.active = false;
 		}
-		core::option<core::string> virtual_machine::get_source_code_appendix_by_path(const std::string_view& label, const std::string_view& path, uint32_t line_number, uint32_t column_number, size_t max_lines)
+		void virtual_machine::record_garbage_collection_pause(uint64_t pause_us, bool full_cycle)
 		{
-			auto code = get_script_section(path);
-			if (!code)
-				return code;
+			constexpr size_t buckets = sizeof(gc_histogram::pauses) / sizeof(*gc_histogram::pauses);
+			size_t index = 0;
+			while (index + 1 < buckets && pause_us >= ((uint64_t)2 << index))
+				++index;
 
-			return get_source_code_appendix(label, *code, line_number, column_number, max_lines);
+			core::umutex<std::mutex> unique(collector.exchange);
+			auto& histogram = collector.histogram;
+			++histogram.pauses[index];
+			++(full_cycle ? histogram.full_cycles : histogram.slices);
+			histogram.total_us += pause_us;
+			if (histogram.max_us < pause_us)
+				histogram.max_us = pause_us;
 		}
-		size_t virtual_machine::get_property(features property) const
+		bool virtual_machine::start_profiler(uint64_t interval_us, bool count_calls)
 		{
-			VI_ASSERT(engine != nullptr, "engine should be set");
+			if (!interval_us)
+				return false;
+
+			stop_profiler();
+			profiler.interval_us = interval_us;
+			profiler.count_calls = count_calls;
+			profiler.active = true;
+			profiler.thread = std::thread([this]()
+			{
+				std::unique_lock<std::mutex> unique(profiler.exchange);
+				while (profiler.active)
+				{
+					profiler.notify.wait_for(unique, std::chrono::microseconds(profiler.interval_us), [this]() { return !profiler.active; });
+					++profiler.epoch;
+					if (!profiler.active || profiler.count_calls)
+						continue;
 #ifdef VI_ANGELSCRIPT
-			return (size_t)engine->GetEngineProperty((asEEngineProp)property);
-#else
-			return 0;
+					for (auto* next : profiler.contexts)
+					{
+						auto& state = next->profiling;
+						if (!state.running.load(std::memory_order_relaxed) || state.tracing.load(std::memory_order_relaxed) || state.sample.exchange(true))
+							continue;
+
+						next->context->SetLineCallback(asFUNCTION(virtual_machine::line_handler), nullptr, asCALL_CDECL);
+					}
 #endif
+				}
+			});
+			update_line_callbacks();
+			VI_DEBUG("vm OK start profiler on 0x%" PRIXPTR " (%" PRIu64 "us interval)", (uintptr_t)this, interval_us);
+			return true;
 		}
-		asIScriptEngine* virtual_machine::get_engine() const
+		void virtual_machine::stop_profiler()
 		{
-			return engine;
+			if (!profiler.thread.joinable())
+				return;
+
+			{
+				std::unique_lock<std::mutex> unique(profiler.exchange);
+				profiler.active = false;
+			}
+			profiler.notify.notify_all();
+			profiler.thread.join();
+			update_line_callbacks();
 		}
-		debugger_context* virtual_machine::get_debugger() const
+		void virtual_machine::reset_profiler()
 		{
-			return debugger;
+			core::umutex<std::mutex> unique(profiler.exchange);
+			profiler.stacks.clear();
+			profiler.functions.clear();
 		}
-		void virtual_machine::cleanup()
+		bool virtual_machine::is_profiling() const
 		{
-			type_cache::cleanup();
-			cleanup_this_thread();
+			return profiler.active;
 		}
-		virtual_machine* virtual_machine::get(asIScriptEngine* engine)
+		core::string virtual_machine::get_profiler_folded_stacks()
+		{
+			core::umutex<std::mutex> unique(profiler.exchange);
+			core::string result;
+			for (auto& next : profiler.stacks)
+				result.append(next.first).append(1, ' ').append(core::to_string(next.second)).append(1, '\n');
+			return result;
+		}
+		core::vector<virtual_machine::profiler_function> virtual_machine::get_profiler_functions()
+		{
+			core::umutex<std::mutex> unique(profiler.exchange);
+			core::vector<profiler_function> result;
+			result.reserve(profiler.functions.size());
+			for (auto& next : profiler.functions)
+			{
+				auto& item = result.emplace_back(next.second);
+				item.name = next.first;
+				item.self_us = item.self_samples * profiler.interval_us;
+				item.total_us = item.total_samples * profiler.interval_us;
+			}
+
+			std::sort(result.begin(), result.end(), [](const profiler_function& a, const profiler_function& b) { return a.self_samples > b.self_samples; });
+			return result;
+		}
+		void virtual_machine::profile_context(immediate_context* base)
 		{
-			VI_ASSERT(engine != nullptr, "engine should be set");
 #ifdef VI_ANGELSCRIPT
-			void* vm = engine->GetUserData(manager_ud);
-			VI_ASSERT(vm != nullptr, "engine should be created by virtual machine");
-			return (virtual_machine*)vm;
-#else
-			return nullptr;
+			asIScriptContext* context = base->context;
+			auto& state = base->profiling;
+			bool forced = state.sample.load(std::memory_order_relaxed);
+			if (forced)
+				cancel_profiler_sample(base);
+
+			if (!profiler.active.load(std::memory_order_relaxed))
+				return;
+
+			if (profiler.count_calls)
+			{
+				size_t depth = (size_t)context->GetCallstackSize();
+				if (depth > state.depth)
+				{
+					asIScriptFunction* function = context->GetFunction(0);
+					if (function != nullptr)
+						++state.calls[function];
+				}
+				state.depth = depth;
+			}
+
+			uint64_t epoch = profiler.epoch.load(std::memory_order_relaxed);
+			if (!forced && state.epoch == epoch)
+				return;
+
+			bool sampled = forced || state.epoch != 0;
+			state.epoch = epoch;
+			if (!sampled)
+				return;
+
+			core::vector<core::string> names;
+			core::string stack;
+			for (asUINT level = context->GetCallstackSize(); level-- > 0;)
+			{
+				asIScriptFunction* function = context->GetFunction(level);
+				if (!function)
+					continue;
+
+				auto& name = names.emplace_back(function->GetDeclaration(true, true, false));
+				if (!stack.empty())
+					stack.append(1, ';');
+				stack.append(name).append(1, ':').append(core::to_string(context->GetLineNumber(level)));
+			}
+
+			if (names.empty())
+				return;
+
+			core::umutex<std::mutex> unique(profiler.exchange);
+			++profiler.stacks[stack];
+			++profiler.functions[names.back()].self_samples;
+			for (size_t i = 0; i < names.size(); i++)
+			{
+				if (std::find(names.begin(), names.begin() + i, names[i]) == names.begin() + i)
+					++profiler.functions[names[i]].total_samples;
+			}
+
+			unique.negate();
+			if (!state.calls.empty())
+				flush_profiler_calls(base);
 #endif
 		}
-		virtual_machine* virtual_machine::get()
+		void virtual_machine::cancel_profiler_sample(immediate_context* base)
 		{
 #ifdef VI_ANGELSCRIPT
-			asIScriptContext* context = asGetActiveContext();
-			if (!context)
-				return nullptr;
-
-			return get(context->GetEngine());
-#else
-			return nullptr;
+			core::umutex<std::mutex> unique(profiler.exchange);
+			if (base->profiling.sample.exchange(false) && !base->profiling.tracing)
+				base->context->ClearLineCallback();
 #endif
 		}
-		std::string_view virtual_machine::get_library_name(const std::string_view& path)
+		void virtual_machine::flush_profiler_calls(immediate_context* base)
 		{
-			if (path.empty())
-				return path;
-
-			core::text_settle start = core::stringify::reverse_find_of(path, "\\/");
-			if (!start.found)
-				return path;
-
-			return path.substr(start.end);
+#ifdef VI_ANGELSCRIPT
+			core::umutex<std::mutex> unique(profiler.exchange);
+			for (auto& next : base->profiling.calls)
+				profiler.functions[next.first->GetDeclaration(true, true, false)].calls += next.second;
+#endif
+			base->profiling.calls.clear();
 		}
-		immediate_context* virtual_machine::request_context()
+		void virtual_machine::update_line_callbacks()
 		{
+			trim_context_pools(false);
 			core::umutex<std::recursive_mutex> unique(sync.pool);
-			if (threads.empty())
-			{
-				unique.negate();
-				return create_context();
-			}
-
-			immediate_context* context = *threads.rbegin();
-			threads.pop_back();
-			return context;
+			for (auto* next : threads)
+				attach_debugger_to_context(next->get_context());
+			for (auto* next : stacks)
+				attach_debugger_to_context(next);
 		}
-		void virtual_machine::return_context(immediate_context* context)
+		void virtual_machine::set_context_pool_limits(size_t local_limit, size_t shared_limit)
 		{
-			VI_ASSERT(context != nullptr, "context should be set");
+			pooling.local_limit = local_limit;
+			pooling.shared_limit = shared_limit;
+			if (!local_limit)
+				trim_context_pools(false);
+		}
+		void virtual_machine::trim_context_pools(bool idle_only)
+		{
+			context_cache::drain(this, idle_only);
+		}
+		virtual_machine::context_pool_stats virtual_machine::get_context_pool_stats()
+		{
+			context_pool_stats stats;
+			context_cache::summarize(this, stats);
+			stats.hits += pooling.hits;
+			stats.shared_hits = pooling.shared_hits;
+			stats.misses = pooling.misses;
+			stats.overflows = pooling.overflows;
+			stats.trims = pooling.trims;
+
 			core::umutex<std::recursive_mutex> unique(sync.pool);
-			threads.push_back(context);
-			context->reset();
+			stats.cached += threads.size() + stacks.size();
+			return stats;
 		}
 		asIScriptContext* virtual_machine::request_raw_context(asIScriptEngine* engine, void* data)
 		{
 #ifdef VI_ANGELSCRIPT
 			virtual_machine* vm = virtual_machine::get(engine);
-			if (!vm || vm->stacks.empty())
+			if (!vm)
 				return engine->CreateContext();
 
+			asIScriptContext* context = context_cache::get().pop(vm, &context_cache::entry::stacks);
+			if (context != nullptr)
+				return context;
+
 			core::umutex<std::recursive_mutex> unique(vm->sync.pool);
 			if (vm->stacks.empty())
 			{
 				unique.negate();
+				++vm->pooling.misses;
 				return engine->CreateContext();
 			}
 
-			asIScriptContext* context = *vm->stacks.rbegin();
+			context = vm->stacks.back();
 			vm->stacks.pop_back();
+			++vm->pooling.shared_hits;
 			return context;
 #else
 			return nullptr;
@@ -8294,17 +11868,22 @@ namespace vitex
 			virtual_machine* vm = virtual_machine::get(engine);
 			VI_ASSERT(vm != nullptr, "engine should be set");
 
-			core::umutex<std::recursive_mutex> unique(vm->sync.pool);
-			vm->stacks.push_back(context);
 			context->Unprepare();
+			if (!context_cache::get().push(vm, &context_cache::entry::stacks, context))
+				vm->return_shared_raw_context(context);
 #endif
 		}
 		void virtual_machine::line_handler(asIScriptContext* context, void*)
 		{
 			immediate_context* base = immediate_context::get(context);
-			VI_ASSERT(base != nullptr, "context should be set");
-			VI_ASSERT(base->callbacks.line != nullptr, "callback should be set");
-			base->callbacks.line(base);
+			if (!base)
+				return;
+
+			if (base->profiling.sample.load(std::memory_order_relaxed) || base->vm->profiler.active.load(std::memory_order_relaxed))
+				base->vm->profile_context(base);
+
+			if (base->callbacks.line != nullptr)
+				base->callbacks.line(base);
 		}
 		void virtual_machine::exception_handler(asIScriptContext* context, void*)
 		{
@@ -8376,6 +11955,10 @@ namespace vitex
 			asThreadCleanup();
 #endif
 		}
+		void virtual_machine::trim_this_thread()
+		{
+			context_cache::drain(nullptr, false, &context_cache::get());
+		}
 		std::string_view virtual_machine::get_error_name_info(virtual_error code)
 		{
 			switch (code)
@@ -8442,6 +12025,97 @@ namespace vitex
 					return "internal operation failed";
 			}
 		}
+		uint64_t virtual_machine::get_byte_code_hash(asIScriptFunction* function)
+		{
+			VI_ASSERT(function != nullptr, "function should be set");
+#ifdef VI_ANGELSCRIPT
+			asUINT length = 0;
+			asDWORD* code = function->GetByteCode(&length);
+			if (!code || !length)
+				return 0;
+
+			asIScriptEngine* engine = function->GetEngine();
+			core::string data;
+			data.reserve((size_t)length * sizeof(asDWORD));
+			for (asUINT offset = 0; offset < length;)
+			{
+				asDWORD* instruction = code + offset;
+				uint8_t opcode = *(asBYTE*)instruction;
+				auto& source = asBCInfo[opcode];
+				asUINT size = std::max<asUINT>(1, asBCTypeSize[source.type]);
+				data.append(1, (char)opcode);
+				offset += size;
+				if (opcode == asBC_JitEntry)
+					continue;
+
+				data.append((char*)instruction + 1, sizeof(asDWORD) - 1);
+				switch (opcode)
+				{
+					case asBC_CALL:
+					case asBC_CALLSYS:
+					case asBC_CALLINTF:
+					case asBC_Thiscall1:
+						append_function_identity(engine->GetFunctionById(asBC_INTARG(instruction)), data);
+						break;
+					case asBC_CALLBND:
+					{
+						auto* base = (asCScriptEngine*)engine;
+						asUINT index = (asUINT)asBC_INTARG(instruction) & ~(asUINT)BYTE_CODE_IMPORTED_FUNCTION;
+						append_function_identity(index < base->importedFunctions.GetLength() && base->importedFunctions[index] != nullptr ? base->importedFunctions[index]->importedFunctionSignature : nullptr, data);
+						break;
+					}
+					case asBC_ALLOC:
+					{
+						auto* type = (asITypeInfo*)asBC_PTRARG(instruction);
+						append_type_identity(engine, type != nullptr ? type->GetTypeId() : 0, data);
+						append_function_identity(engine->GetFunctionById((int)*(instruction + 1 + AS_PTR_SIZE)), data);
+						break;
+					}
+					case asBC_OBJTYPE:
+					case asBC_FREE:
+					case asBC_REFCPY:
+					case asBC_RefCpyV:
+					{
+						auto* type = (asITypeInfo*)asBC_PTRARG(instruction);
+						append_type_identity(engine, type != nullptr ? type->GetTypeId() : 0, data);
+						break;
+					}
+					case asBC_FuncPtr:
+						append_function_identity((asIScriptFunction*)asBC_PTRARG(instruction), data);
+						break;
+					case asBC_TYPEID:
+					case asBC_Cast:
+					case asBC_COPY:
+						append_type_identity(engine, asBC_INTARG(instruction), data);
+						break;
+					case asBC_SetListType:
+						data.append((char*)(instruction + 1), sizeof(asDWORD));
+						append_type_identity(engine, (int)*(instruction + 2), data);
+						break;
+					case asBC_PGA:
+					case asBC_PshGPtr:
+					case asBC_PshG4:
+					case asBC_LDG:
+					case asBC_CpyGtoV4:
+					case asBC_CpyVtoG4:
+					case asBC_LdGRdR4:
+						append_global_identity(function, (void*)asBC_PTRARG(instruction), data);
+						break;
+					case asBC_SetG4:
+						append_global_identity(function, (void*)asBC_PTRARG(instruction), data);
+						data.append((char*)(instruction + 1 + AS_PTR_SIZE), sizeof(asDWORD));
+						break;
+					default:
+						data.append((char*)(instruction + 1), (size_t)(size - 1) * sizeof(asDWORD));
+						break;
+				}
+			}
+
+			return compute::crypto::crc64(data);
+#else
+			return 0;
+#endif
+		}
 		byte_code_label virtual_machine::get_byte_code_info(uint8_t code)
 		{
 #ifdef VI_ANGELSCRIPT
@@ -8817,5 +12491,184 @@ namespace vitex
 		{
 			return internal_loop;
 		}
+
+		isolate_pool::isolate_pool() noexcept : cursor(0)
+		{
+		}
+		isolate_pool::~isolate_pool() noexcept
+		{
+			for (auto* next : isolates)
+			{
+				while (true)
+				{
+					core::umutex<std::mutex> unique(next->exchange);
+					if (!next->active)
+						break;
+
+					unique.negate();
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				}
+
+				core::memory::release(next->unit);
+				core::memory::release(next->vm);
+				core::memory::deinit(next);
+			}
+			isolates.clear();
+		}
+		expects_vm<void> isolate_pool::spawn(size_t count, spawn_callback&& callback, const std::string_view& module_name, const std::string_view& path)
+		{
+			VI_ASSERT(count > 0, "isolates count should be greater than zero");
+			VI_ASSERT(callback != nullptr, "spawn callback should be set");
+			VI_ASSERT(isolates.empty(), "isolates should not be spawned twice");
+			isolates.reserve(count);
+			for (size_t i = 0; i < count; i++)
+			{
+				isolate* next = core::memory::init<isolate>();
+				next->index = i;
+				next->vm = callback(i);
+				isolates.push_back(next);
+				if (!next->vm)
+					return virtual_exception(virtual_error::invalid_configuration);
+
+				next->unit = next->vm->create_compiler();
+				if (i > 0)
+				{
+					auto status = next->unit->prepare(&shared);
+					if (!status)
+						return status;
+
+					status = next->unit->compile_sync();
+					if (!status)
+						return status;
+
+					continue;
+				}
+
+				auto status = next->unit->prepare(module_name, true);
+				if (!status)
+					return status;
+
+				status = next->unit->load_file(path);
+				if (!status)
+					return status;
+
+				status = next->unit->compile_sync();
+				if (!status)
+					return status;
+
+				shared.name = core::string(module_name);
+				status = next->unit->save_byte_code(&shared);
+				if (!status)
+					return status;
+
+				shared.valid = true;
+			}
+
+			VI_DEBUG("asc OK spawn %" PRIu64 " isolates of %.*s on 0x%" PRIXPTR, (uint64_t)count, (int)module_name.size(), module_name.data(), (uintptr_t)this);
+			return core::expectation::met;
+		}
+		void isolate_pool::set_message_callback(message_callback&& callback)
+		{
+			on_message = std::move(callback);
+		}
+		bool isolate_pool::dispatch(isolate_callback&& callback)
+		{
+			if (isolates.empty())
+				return false;
+
+			size_t offset = cursor++, index = offset % isolates.size();
+			size_t min_load = isolates[index]->load.load();
+			for (size_t i = 1; i < isolates.size() && min_load > 0; i++)
+			{
+				size_t next = (offset + i) % isolates.size();
+				size_t load = isolates[next]->load.load();
+				if (load < min_load)
+				{
+					min_load = load;
+					index = next;
+				}
+			}
+
+			return dispatch_to(index, std::move(callback));
+		}
+		bool isolate_pool::dispatch_to(size_t index, isolate_callback&& callback)
+		{
+			VI_ASSERT(callback != nullptr, "callback should be set");
+			if (index >= isolates.size())
+				return false;
+
+			isolate* target = isolates[index];
+			{
+				core::umutex<std::mutex> unique(target->exchange);
+				target->tasks.push(std::move(callback));
+				++target->load;
+				if (target->active)
+					return true;
+
+				target->active = true;
+			}
+
+			if (!core::schedule::is_available() || !core::schedule::get()->set_task([this, target]() { execute(target); }))
+				execute(target);
+			return true;
+		}
+		bool isolate_pool::post(size_t index, core::schema* message)
+		{
+			VI_ASSERT(message != nullptr, "message should be set");
+			core::vector<char> data = core::schema::to_jsonb(message);
+			return dispatch_to(index, [this, data = std::move(data)](isolate* target)
+			{
+				auto result = core::schema::from_jsonb(std::string_view(data.data(), data.size()));
+				if (!result)
+					return;
+
+				if (on_message)
+					on_message(target, *result);
+				core::memory::release(*result);
+			});
+		}
+		bool isolate_pool::broadcast(core::schema* message)
+		{
+			bool success = !isolates.empty();
+			for (size_t i = 0; i < isolates.size(); i++)
+				success = post(i, message) && success;
+			return success;
+		}
+		isolate_pool::isolate* isolate_pool::get_isolate(size_t index) const
+		{
+			return index < isolates.size() ? isolates[index] : nullptr;
+		}
+		const byte_code_info& isolate_pool::get_byte_code() const
+		{
+			return shared;
+		}
+		size_t isolate_pool::get_size() const
+		{
+			return isolates.size();
+		}
+		void isolate_pool::execute(isolate* target)
+		{
+			size_t executions = 0;
+			while (true)
+			{
+				isolate_callback next;
+				{
+					core::umutex<std::mutex> unique(target->exchange);
+					if (target->tasks.empty())
+					{
+						target->active = false;
+						return;
+					}
+
+					next = std::move(target->tasks.front());
+					target->tasks.pop();
+				}
+
+				next(target);
+				--target->load;
+				if (++executions >= ISOLATE_BATCH_SIZE && core::schedule::is_available() && core::schedule::get()->set_task([this, target]() { execute(target); }))
+					return;
+			}
+		}
 	}
 }
@@ -13,8 +13,10 @@ class asIScriptGeneric;
 class asIScriptObject;
 class asILockableSharedBool;
 class asITypeInfo;
+class asIJITCompiler;
 struct asSFuncPtr;
 struct asSMessageInfo;
+struct asSVMRegisters;
 
 namespace vitex
 {
@@ -359,6 +361,7 @@ namespace vitex
 		typedef const void*(*to_string_constant_ptr)(void* context, const char* buffer, size_t buffer_size);
 		typedef int(*from_string_constant_ptr)(void* context, const void* object, char* buffer, size_t* buffer_size);
 		typedef int(*free_string_constant_ptr)(void* context, const void* object);
+		typedef void(*native_entry_ptr)(asSVMRegisters* registers, size_t argument);
 		typedef std::function<void(type_info*, struct function_info*)> property_callback;
 		typedef std::function<void(type_info*, struct function*)> method_callback;
 		typedef std::function<void(class virtual_machine*)> addon_callback;
@@ -660,6 +663,7 @@ namespace vitex
 
 		struct byte_code_info
 		{
+			core::vector<core::string> addons;
 			core::vector<uint8_t> data;
 			core::string name;
 			bool valid = false;
@@ -681,6 +685,18 @@ namespace vitex
 			uint8_t size_of_arg2;
 		};
 
+		struct native_registers
+		{
+			uint32_t* program_pointer;
+			uint32_t* stack_frame_pointer;
+			uint32_t* stack_pointer;
+			uint64_t value_register;
+			void* object_register;
+			void* object_type;
+			bool do_process_suspend;
+			void* context;
+		};
+
 		struct property_info
 		{
 			std::string_view name;
@@ -1537,6 +1553,7 @@ namespace vitex
 			int get_type_id_by_decl(const std::string_view& decl) const;
 			expects_vm<size_t> get_imported_function_index_by_decl(const std::string_view& decl) const;
 			expects_vm<void> save_byte_code(byte_code_info* info) const;
+			expects_vm<core::string> generate_native_source(const std::string_view& registrar) const;
 			expects_vm<size_t> get_property_index_by_name(const std::string_view& name) const;
 			expects_vm<size_t> get_property_index_by_decl(const std::string_view& decl) const;
 			expects_vm<void> get_property(size_t index, property_info* out) const;
@@ -1640,6 +1657,7 @@ namespace vitex
 			asIScriptModule* scope;
 			virtual_machine* vm;
 			byte_code_info vcache;
+			core::string fingerprint;
 			size_t counter;
 			bool built;
 
@@ -1672,6 +1690,12 @@ namespace vitex
 			library get_module() const;
 			virtual_machine* get_vm() const;
 			compute::preprocessor* get_processor() const;
+
+		private:
+			expects_vm<void> add_section(const std::string_view& name, const std::string_view& code);
+			expects_vm<void> load_byte_code_file(const std::string_view& path);
+			expects_vm<void> save_byte_code_file(const std::string_view& path);
+			core::string get_byte_code_path();
 		};
 
 		class debugger_context final : public core::reference<debugger_context>
@@ -1848,6 +1872,16 @@ namespace vitex
 				size_t deferred_exceptions = 0;
 			} executor;
 
+			struct
+			{
+				core::unordered_map<asIScriptFunction*, size_t> calls;
+				std::atomic<size_t> running = { 0 };
+				std::atomic<bool> sample = { false };
+				std::atomic<bool> tracing = { false };
+				uint64_t epoch = 0;
+				size_t depth = 0;
+			} profiling;
+
 		private:
 			core::linked_list<core::string> strings;
 			asIScriptContext* context;
@@ -1971,6 +2005,8 @@ namespace vitex
 
 		class virtual_machine final : public core::reference<virtual_machine>
 		{
+			friend immediate_context;
+
 		public:
 			typedef std::function<expects_vm<void>(compute::preprocessor* base, const std::string_view& path, core::string& buffer)> generator_callback;
 			typedef std::function<void(const std::string_view&)> compile_callback;
@@ -1997,6 +2033,56 @@ namespace vitex
 				bool exposed = false;
 			};
 
+			struct context_pool_stats
+			{
+				size_t hits = 0;
+				size_t shared_hits = 0;
+				size_t misses = 0;
+				size_t overflows = 0;
+				size_t trims = 0;
+				size_t cached = 0;
+			};
+
+			struct gc_policy
+			{
+				uint64_t interval_ms = 20;
+				uint64_t slice_budget_us = 500;
+				size_t min_new_objects = 256;
+				size_t pressure_objects = 0;
+				float growth_ratio = 0.1f;
+			};
+
+			struct gc_histogram
+			{
+				uint64_t pauses[20] = { };
+				uint64_t slices = 0;
+				uint64_t full_cycles = 0;
+				uint64_t total_us = 0;
+				uint64_t max_us = 0;
+			};
+
+			struct profiler_function
+			{
+				core::string name;
+				size_t calls = 0;
+				size_t self_samples = 0;
+				size_t total_samples = 0;
+				uint64_t self_us = 0;
+				uint64_t total_us = 0;
+			};
+
+			struct jit_stats
+			{
+				size_t functions = 0;
+				size_t compiled = 0;
+				size_t failed = 0;
+				size_t entries = 0;
+				size_t code_size = 0;
+			};
+
+		private:
+			struct context_cache;
+
 		private:
 			struct
 			{
@@ -2004,6 +2090,41 @@ namespace vitex
 				std::recursive_mutex pool;
 			} sync;
 
+			struct
+			{
+				std::atomic<size_t> hits = { 0 };
+				std::atomic<size_t> shared_hits = { 0 };
+				std::atomic<size_t> misses = { 0 };
+				std::atomic<size_t> overflows = { 0 };
+				std::atomic<size_t> trims = { 0 };
+				std::atomic<size_t> local_limit = { 8 };
+				std::atomic<size_t> shared_limit = { 128 };
+			} pooling;
+
+			struct
+			{
+				gc_policy policy;
+				gc_histogram histogram;
+				std::mutex exchange;
+				std::atomic<bool> active = { false };
+				core::task_id timer = core::INVALID_TASK_ID;
+				bool pending = false;
+			} collector;
+
+			struct
+			{
+				core::unordered_map<core::string, size_t> stacks;
+				core::unordered_map<core::string, profiler_function> functions;
+				core::unordered_set<immediate_context*> contexts;
+				std::condition_variable notify;
+				std::mutex exchange;
+				std::thread thread;
+				std::atomic<uint64_t> epoch = { 0 };
+				std::atomic<bool> active = { false };
+				uint64_t interval_us = 0;
+				bool count_calls = false;
+			} profiler;
+
 		private:
 			static int manager_ud;
 
@@ -2022,12 +2143,17 @@ namespace vitex
 			core::string default_namespace;
 			compute::preprocessor::desc proc;
 			compute::include_desc include;
+			core::string cache_directory;
 			compile_callback when_error;
 			cache_callback when_cache;
 			std::function<void(immediate_context*)> global_exception;
 			std::atomic<int64_t> last_major_gc;
+			uint64_t interface_hash;
+			size_t interface_size;
 			uint64_t scope;
 			debugger_context* debugger;
+			asIJITCompiler* natives;
+			asIJITCompiler* jit;
 			asIScriptEngine* engine;
 			string_factory* factory;
 			bool save_stacktrace;
@@ -2043,6 +2169,7 @@ namespace vitex
 			expects_vm<void> garbage_collect(garbage_collector flags, size_t num_iterations = 1);
 			expects_vm<void> perform_periodic_garbage_collection(uint64_t interval_ms);
 			expects_vm<void> perform_full_garbage_collection();
+			expects_vm<bool> perform_incremental_garbage_collection(uint64_t budget_us);
 			expects_vm<void> notify_of_new_object(void* object, const type_info& type);
 			expects_vm<void> get_object_address(size_t index, size_t* sequence_number = nullptr, void** object = nullptr, type_info* type = nullptr);
 			expects_vm<void> assign_object(void* dest_object, void* src_object, const type_info& type);
@@ -2064,6 +2191,13 @@ namespace vitex
 			expects_vm<void> set_log_callback(void(*callback)(const asSMessageInfo* message, void* object), void* object);
 			expects_vm<void> log(const std::string_view& section, int row, int column, log_category type, const std::string_view& message);
 			expects_vm<void> set_property(features property, size_t value);
+			expects_vm<void> set_jit_compiler(asIJITCompiler* compiler);
+			expects_vm<void> set_native_function(const std::string_view& decl, uint64_t byte_code_hash, native_entry_ptr entry);
+			expects_vm<void> set_native_validation(bool enabled);
+			size_t get_native_function_calls(const std::string_view& decl);
+			size_t get_native_function_mismatches(const std::string_view& decl);
+			expects_vm<void> set_jit(bool enabled, size_t call_threshold = 64);
+			jit_stats get_jit_stats();
 			expects_vm<void> get_property_by_index(size_t index, property_info* info) const;
 			expects_vm<size_t> get_property_index_by_name(const std::string_view& name) const;
 			expects_vm<size_t> get_property_index_by_decl(const std::string_view& decl) const;
@@ -2081,6 +2215,7 @@ namespace vitex
 			void set_ts_imports_concat_mode(bool enabled);
 			void set_keyword_restriction(const std::string_view& keyword, bool enabled);
 			void set_cache(bool enabled);
+			void set_cache_directory(const std::string_view& path);
 			void set_exception_callback(std::function<void(immediate_context*)>&& callback);
 			void set_debugger(debugger_context* context);
 			void set_cache_callback(cache_callback&& callback);
@@ -2113,8 +2248,21 @@ namespace vitex
 			asIScriptModule* create_module(const std::string_view& name);
 			immediate_context* request_context();
 			void return_context(immediate_context* context);
+			void set_context_pool_limits(size_t local_limit, size_t shared_limit);
+			void trim_context_pools(bool idle_only = true);
+			context_pool_stats get_context_pool_stats();
+			bool start_incremental_garbage_collection(const gc_policy& policy);
+			void stop_incremental_garbage_collection();
+			gc_histogram get_garbage_collection_histogram();
+			bool start_profiler(uint64_t interval_us = 1000, bool count_calls = false);
+			void stop_profiler();
+			void reset_profiler();
+			bool is_profiling() const;
+			core::string get_profiler_folded_stacks();
+			core::vector<profiler_function> get_profiler_functions();
 			bool get_byte_code_cache(byte_code_info* info);
 			void set_byte_code_cache(byte_code_info* info);
+			uint64_t get_interface_hash();
 			void* create_object(const type_info& type);
 			void* create_object_copy(void* object, const type_info& type);
 			void* create_empty_object(const type_info& type);
@@ -2133,6 +2281,7 @@ namespace vitex
 			asIScriptEngine* get_engine() const;
 			debugger_context* get_debugger() const;
 			const core::string& get_module_directory() const;
+			const core::string& get_cache_directory() const;
 			core::vector<core::string> get_exposed_addons();
 			const core::unordered_map<core::string, addon>& get_system_addons() const;
 			const core::unordered_map<core::string, clibrary>& get_clibraries() const;
@@ -2186,13 +2335,25 @@ namespace vitex
 			static void global_shared_lock();
 			static void global_shared_unlock();
 			static void cleanup_this_thread();
+			static void trim_this_thread();
 			static std::string_view get_error_name_info(virtual_error code);
 			static byte_code_label get_byte_code_info(uint8_t code);
+			static uint64_t get_byte_code_hash(asIScriptFunction* function);
 			static virtual_machine* get(asIScriptEngine* engine);
 			static virtual_machine* get();
 			static size_t get_default_access_mask();
 			static void cleanup();
 
+		private:
+			void return_shared_context(immediate_context* context);
+			void return_shared_raw_context(asIScriptContext* context);
+			void collect_garbage_on_idle();
+			void profile_context(immediate_context* context);
+			void cancel_profiler_sample(immediate_context* context);
+			void flush_profiler_calls(immediate_context* context);
+			void update_line_callbacks();
+			void record_garbage_collection_pause(uint64_t pause_us, bool full_cycle);
+
 		private:
 			static std::string_view get_library_name(const std::string_view& path);
 			static asIScriptContext* request_raw_context(asIScriptEngine* engine, void* data);
@@ -2430,6 +2591,48 @@ namespace vitex
 			static void set(event_loop* for_current_thread);
 			static event_loop* get();
 		};
+
+		class isolate_pool final : public core::reference<isolate_pool>
+		{
+		public:
+			struct isolate;
+			typedef std::function<virtual_machine*(size_t)> spawn_callback;
+			typedef std::function<void(isolate*)> isolate_callback;
+			typedef std::function<void(isolate*, core::schema*)> message_callback;
+
+			struct isolate
+			{
+				core::single_queue<isolate_callback> tasks;
+				std::mutex exchange;
+				std::atomic<size_t> load = { 0 };
+				virtual_machine* vm = nullptr;
+				compiler* unit = nullptr;
+				size_t index = 0;
+				bool active = false;
+			};
+
+		private:
+			core::vector<isolate*> isolates;
+			byte_code_info shared;
+			message_callback on_message;
+			std::atomic<size_t> cursor;
+
+		public:
+			isolate_pool() noexcept;
+			~isolate_pool() noexcept;
+			expects_vm<void> spawn(size_t count, spawn_callback&& callback, const std::string_view& module_name, const std::string_view& path);
+			void set_message_callback(message_callback&& callback);
+			bool dispatch(isolate_callback&& callback);
+			bool dispatch_to(size_t index, isolate_callback&& callback);
+			bool post(size_t index, core::schema* message);
+			bool broadcast(core::schema* message);
+			isolate* get_isolate(size_t index) const;
+			const byte_code_info& get_byte_code() const;
+			size_t get_size() const;
+
+		private:
+			void execute(isolate* target);
+		};
 	}
 }
 #endif
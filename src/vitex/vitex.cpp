@@ -245,6 +245,7 @@ namespace vitex
 	{
 		VI_TRACE("lib free singleton instances");
 		layer::application::cleanup_instance();
+		network::http::client_pool::cleanup_instance();
 		network::http::hrm_cache::cleanup_instance();
 		network::sqlite::driver::cleanup_instance();
 		network::pq::driver::cleanup_instance();
@@ -0,0 +1,83 @@
+#include <vitex/vitex.h>
+#include <vitex/scripting.h>
+#include <vitex/bindings.h>
+#include <cstdio>
+#include <cstring>
+#define BYTE_CODE_FILE_MAGIC "VIBCODE1"
+#define BYTE_CODE_FILE_HEADER 17
+
+using namespace vitex;
+using namespace vitex::scripting;
+
+static bool load_module(compiler* unit, const std::string_view& path, int addons_count, char* addons[])
+{
+	if (!core::stringify::ends_with(path, ".vbc"))
+	{
+		auto status = unit->prepare("aot");
+		if (status)
+			status = unit->load_file(path);
+		if (status)
+			status = unit->compile_sync();
+		if (!status)
+			fprintf(stderr, "cannot build %.*s: %s\n", (int)path.size(), path.data(), status.error().what());
+		return !!status;
+	}
+
+	size_t size = 0;
+	auto data = core::os::file::read_all(path, &size);
+	if (!data)
+	{
+		fprintf(stderr, "cannot read %.*s\n", (int)path.size(), path.data());
+		return false;
+	}
+
+	uint8_t* buffer = *data;
+	size_t offset = size > BYTE_CODE_FILE_HEADER && !memcmp(buffer, BYTE_CODE_FILE_MAGIC, 8) ? BYTE_CODE_FILE_HEADER : 0;
+	byte_code_info info;
+	info.name = "aot";
+	info.data.assign(buffer + offset, buffer + size);
+	info.valid = true;
+	for (int i = 0; i < addons_count; i++)
+		info.addons.push_back(addons[i]);
+	core::memory::deallocate(buffer);
+
+	auto status = unit->prepare(&info);
+	if (status)
+		status = unit->compile_sync();
+	if (!status)
+		fprintf(stderr, "cannot load %.*s: %s\n", (int)path.size(), path.data(), status.error().what());
+	return !!status;
+}
+int main(int argc, char* argv[])
+{
+	if (argc < 3)
+	{
+		fprintf(stderr, "usage: vitex_aot <input.as|input.vbc> <output.cpp> [registrar] [addon...]\n");
+		return 1;
+	}
+
+	vitex::runtime scope(0);
+	core::uptr<virtual_machine> vm = new virtual_machine();
+	bindings::registry().bind_addons(*vm);
+	vm->set_full_stack_tracing(false);
+	vm->set_property(features::include_jit_instructions, 1);
+
+	core::uptr<compiler> unit = vm->create_compiler();
+	if (!load_module(*unit, argv[1], argc > 4 ? argc - 4 : 0, argv + 4))
+		return 1;
+
+	auto source = unit->get_module().generate_native_source(argc > 3 ? argv[3] : "script_natives");
+	if (!source)
+	{
+		fprintf(stderr, "cannot translate %s: %s\n", argv[1], source.error().what());
+		return 1;
+	}
+
+	if (!core::os::file::write(argv[2], (uint8_t*)source->data(), source->size()))
+	{
+		fprintf(stderr, "cannot write %s\n", argv[2]);
+		return 1;
+	}
+
+	return 0;
+}
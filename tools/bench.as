@@ -0,0 +1,64 @@
+#include <string>
+#include <array>
+
+int bench_loops(int n)
+{
+	int sum = 0;
+	for (int i = 0; i < n; i++)
+	{
+		for (int j = 0; j < 100; j++)
+			sum += (i ^ j) & 0xFF;
+	}
+	return sum;
+}
+int bench_math(int n)
+{
+	double x = 0.0;
+	for (int i = 1; i < n; i++)
+	{
+		double v = double(i);
+		x += v * 0.5 / (v + 1.0) - (v - 2.0) * 0.25;
+		x = x - double(int(x / 1000.0)) * 1000.0;
+	}
+	return int(x);
+}
+int bench_calls_step(int a, int b)
+{
+	return a * 3 + b % 7;
+}
+int bench_calls(int n)
+{
+	int sum = 0;
+	for (int i = 0; i < n; i++)
+		sum = bench_calls_step(sum, i) & 0xFFFF;
+	return sum;
+}
+int bench_strings(int n)
+{
+	int size = 0;
+	for (int i = 0; i < n; i++)
+	{
+		string text;
+		for (int j = 0; j < 32; j++)
+		{
+			text += "item";
+			text.push(uint8(48 + j % 10));
+		}
+		size += int(text.size());
+	}
+	return size;
+}
+int bench_arrays(int n)
+{
+	array<int> data;
+	data.resize(1024);
+	int sum = 0;
+	for (int i = 0; i < n; i++)
+	{
+		for (int j = 0; j < 1024; j++)
+			data[j] = i * 3 + j;
+		for (int j = 0; j < 1024; j++)
+			sum += data[j] & 0xF;
+	}
+	return sum;
+}
@@ -0,0 +1,163 @@
+#include <vitex/vitex.h>
+#include <vitex/scripting.h>
+#include <vitex/bindings.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+using namespace vitex;
+using namespace vitex::scripting;
+
+bool bench_natives(virtual_machine* vm);
+
+enum class bench_mode
+{
+	interpreter,
+	jit,
+	aot
+};
+
+struct benchmark
+{
+	const char* name;
+	const char* decl;
+	int argument;
+};
+
+struct measurement
+{
+	double milliseconds = 0.0;
+	uint64_t result = 0;
+	size_t mismatches = 0;
+	bool valid = false;
+};
+
+static const benchmark benchmarks[] =
+{
+	{ "loops", "int bench_loops(int)", 20000 },
+	{ "math", "int bench_math(int)", 2000000 },
+	{ "calls", "int bench_calls(int)", 1000000 },
+	{ "strings", "int bench_strings(int)", 20000 },
+	{ "arrays", "int bench_arrays(int)", 1000 }
+};
+
+static bool run_benchmarks(bench_mode mode, size_t rounds, measurement* results, virtual_machine::jit_stats* stats)
+{
+	core::uptr<virtual_machine> vm = new virtual_machine();
+	bindings::registry().bind_addons(*vm);
+	vm->set_full_stack_tracing(false);
+	if (mode == bench_mode::jit && !vm->set_jit(true, 16))
+	{
+		fprintf(stderr, "jit compiler is not available for this target\n");
+		return false;
+	}
+	else if (mode == bench_mode::aot && !bench_natives(*vm))
+	{
+		fprintf(stderr, "native functions cannot be registered\n");
+		return false;
+	}
+
+	auto source = core::os::file::read_as_string(BENCH_SOURCE);
+	if (!source)
+	{
+		fprintf(stderr, "cannot read %s\n", BENCH_SOURCE);
+		return false;
+	}
+
+	core::uptr<compiler> unit = vm->create_compiler();
+	if (!unit->prepare("bench") || !unit->load_code("bench.as", *source) || !unit->compile_sync())
+	{
+		fprintf(stderr, "cannot build benchmark module\n");
+		return false;
+	}
+
+	library module = unit->get_module();
+	immediate_context* context = vm->request_context();
+	for (size_t i = 0; i < sizeof(benchmarks) / sizeof(benchmark); i++)
+	{
+		auto& next = benchmarks[i];
+		function target = module.get_function_by_decl(next.decl);
+		if (!target.is_valid())
+		{
+			fprintf(stderr, "cannot find %s\n", next.decl);
+			continue;
+		}
+
+		if (mode == bench_mode::aot)
+		{
+			vm->set_native_validation(true);
+			context->execute_inline_call(target, [&next](immediate_context* context) { context->set_arg32(0, next.argument / 100 + 1); });
+			vm->set_native_validation(false);
+			results[i].mismatches = vm->get_native_function_mismatches(next.decl);
+		}
+
+		double best = 0.0;
+		for (size_t round = 0; round < rounds; round++)
+		{
+			auto time = std::chrono::high_resolution_clock::now();
+			auto status = context->execute_inline_call(target, [&next](immediate_context* context) { context->set_arg32(0, next.argument); });
+			double elapsed = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - time).count();
+			if (!status || *status != execution::finished)
+				break;
+
+			results[i].result = (uint64_t)context->get_return_dword();
+			results[i].valid = true;
+			if (!round || elapsed < best)
+				best = elapsed;
+		}
+		results[i].milliseconds = best;
+	}
+
+	vm->return_context(context);
+	if (stats != nullptr)
+		*stats = vm->get_jit_stats();
+	return true;
+}
+static void print_measurement(const measurement& base, const measurement& next, bool available)
+{
+	if (!available || !next.valid)
+	{
+		printf(" %14s %10s", "-", "-");
+		return;
+	}
+
+	printf(" %14.3f %9.2fx", next.milliseconds, next.milliseconds > 0.0 ? base.milliseconds / next.milliseconds : 0.0);
+}
+int main(int argc, char* argv[])
+{
+	vitex::runtime scope(0);
+	size_t rounds = argc > 1 ? (size_t)std::max(1, atoi(argv[1])) : 5;
+	measurement interpreter[sizeof(benchmarks) / sizeof(benchmark)];
+	measurement compiled[sizeof(benchmarks) / sizeof(benchmark)];
+	measurement translated[sizeof(benchmarks) / sizeof(benchmark)];
+	virtual_machine::jit_stats stats;
+	if (!run_benchmarks(bench_mode::interpreter, rounds, interpreter, nullptr))
+		return 1;
+
+	bool has_jit = run_benchmarks(bench_mode::jit, rounds, compiled, &stats);
+	bool has_aot = run_benchmarks(bench_mode::aot, rounds, translated, nullptr);
+	printf("%-10s %14s %14s %10s %14s %10s %s\n", "benchmark", "interpreter ms", "jit ms", "speedup", "aot ms", "speedup", "result");
+	for (size_t i = 0; i < sizeof(benchmarks) / sizeof(benchmark); i++)
+	{
+		auto& base = interpreter[i];
+		if (!base.valid)
+		{
+			printf("%-10s %14s\n", benchmarks[i].name, "failed");
+			continue;
+		}
+
+		printf("%-10s %14.3f", benchmarks[i].name, base.milliseconds);
+		print_measurement(base, compiled[i], has_jit);
+		print_measurement(base, translated[i], has_aot);
+		printf(" %llu", (unsigned long long)base.result);
+		if ((has_jit && compiled[i].valid && compiled[i].result != base.result) || (has_aot && translated[i].valid && translated[i].result != base.result))
+			printf(" (mismatch)");
+		if (has_aot && translated[i].mismatches > 0)
+			printf(" (%i validation mismatches)", (int)translated[i].mismatches);
+		printf("\n");
+	}
+
+	if (has_jit)
+		printf("jit: %i functions, %i compiled, %i rejected, %i native entries, %i bytes of code\n", (int)stats.functions, (int)stats.compiled, (int)stats.failed, (int)stats.entries, (int)stats.code_size);
+	return 0;
+}